@@ -9,8 +9,10 @@ void AAmmoCratePickup::OnCollected(AFPSCharacter* Character) {
 	if (!Character) return;
 	if (Character->GetPrimaryWeapon()) {
 		Character->GetPrimaryWeapon()->Magazines += 1;
+		Character->GetPrimaryWeapon()->NotifyAmmoChanged();
 	}
 	if (Character->GetSecondaryWeapon()) {
 		Character->GetSecondaryWeapon()->Magazines += 1;
+		Character->GetSecondaryWeapon()->NotifyAmmoChanged();
 	}
 }
@@ -0,0 +1,118 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FPSAssetPreloader.h"
+#include "FPSProject.h"
+#include "FPSMapPreload.h"
+#include "Engine/World.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Preload Misses"), STAT_PreloadMisses, STATGROUP_FPSProject);
+
+void UFPSAssetPreloader::Initialize(FSubsystemCollectionBase& Collection) {
+	Super::Initialize(Collection);
+
+	// Created before any actor begins play, so nothing has asked for these assets yet
+	StartSeconds = FPlatformTime::Seconds();
+	if (!SkipMaps.Contains(UWorld::RemovePIEPrefix(GetWorld()->GetMapName()))) {
+		RequestPreload(AlwaysPreload);
+	}
+	RequestMapBundle();
+
+	// Everything may have been resident already, in which case no callback is coming
+	HandlePreloadComplete();
+}
+
+void UFPSAssetPreloader::Deinitialize() {
+	for (TSharedPtr<FStreamableHandle>& Handle : Handles) {
+		if (!Handle.IsValid()) continue;
+
+		if (Handle->IsLoadingInProgress()) {
+			Handle->CancelHandle();
+		}
+		else {
+			Handle->ReleaseHandle();
+		}
+	}
+	Handles.Empty();
+
+	if (MapPreloadId.IsValid()) {
+		if (UAssetManager* AssetManager = UAssetManager::GetIfInitialized()) {
+			AssetManager->UnloadPrimaryAsset(MapPreloadId);
+		}
+		MapPreloadId = FPrimaryAssetId();
+	}
+	Super::Deinitialize();
+}
+
+bool UFPSAssetPreloader::DoesSupportWorldType(const EWorldType::Type WorldType) const {
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UFPSAssetPreloader::IsPreloadComplete() const {
+	for (const TSharedPtr<FStreamableHandle>& Handle : Handles) {
+		if (Handle.IsValid() && Handle->IsLoadingInProgress()) return false;
+	}
+	return true;
+}
+
+void UFPSAssetPreloader::WaitForPreload() {
+	for (TSharedPtr<FStreamableHandle>& Handle : Handles) {
+		if (Handle.IsValid()) {
+			Handle->WaitUntilComplete();
+		}
+	}
+	HandlePreloadComplete();
+}
+
+UObject* UFPSAssetPreloader::ResolveMiss(const FSoftObjectPath& Path) {
+	if (Path.IsNull()) return nullptr;
+
+	INC_DWORD_STAT(STAT_PreloadMisses);
+	UE_LOG(LogTemp, Verbose, TEXT("Preload miss, loading %s synchronously"), *Path.ToString());
+	return Path.TryLoad();
+}
+
+void UFPSAssetPreloader::RequestPreload(const TArray<FSoftObjectPath>& Paths) {
+	TArray<FSoftObjectPath> ToLoad;
+	for (const FSoftObjectPath& Path : Paths) {
+		// Already resident, e.g. the previous map preloaded it too
+		if (!Path.IsNull() && !Path.ResolveObject()) {
+			ToLoad.Add(Path);
+		}
+	}
+	if (ToLoad.Num() == 0) return;
+
+	NumRequested += ToLoad.Num();
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(ToLoad,
+		FStreamableDelegate::CreateUObject(this, &UFPSAssetPreloader::HandlePreloadComplete), FStreamableManager::AsyncLoadHighPriority);
+	if (Handle.IsValid()) {
+		Handles.Add(Handle);
+	}
+}
+
+void UFPSAssetPreloader::RequestMapBundle() {
+	UAssetManager* AssetManager = UAssetManager::GetIfInitialized();
+	if (!AssetManager) return;
+
+	const FPrimaryAssetId Id(UFPSMapPreload::PrimaryAssetType, FName(UWorld::RemovePIEPrefix(GetWorld()->GetMapName())));
+	if (!AssetManager->GetPrimaryAssetPath(Id).IsValid()) return;
+
+	MapPreloadId = Id;
+	NumRequested++;
+	TSharedPtr<FStreamableHandle> Handle = AssetManager->LoadPrimaryAsset(Id, { UFPSMapPreload::BundleName },
+		FStreamableDelegate::CreateUObject(this, &UFPSAssetPreloader::HandlePreloadComplete), FStreamableManager::AsyncLoadHighPriority);
+	if (Handle.IsValid()) {
+		Handles.Add(Handle);
+	}
+}
+
+void UFPSAssetPreloader::HandlePreloadComplete() {
+	if (bPreloadLogged || !IsPreloadComplete()) return;
+
+	bPreloadLogged = true;
+
+	PreloadSeconds = FPlatformTime::Seconds() - StartSeconds;
+	UE_LOG(LogTemp, Log, TEXT("Preloaded %d requests for %s in %.2f ms"), NumRequested, *GetWorld()->GetMapName(), PreloadSeconds * 1000.0);
+}
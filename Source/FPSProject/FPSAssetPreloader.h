@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FPSAssetPreloader.generated.h"
+
+struct FStreamableHandle;
+
+/**
+ * Starts async loads for everything the map is about to spawn as soon as the world is created. The map package is
+ * loaded by then, but actors only begin play afterwards, so the loads overlap world setup and the first frames
+ * instead of hitching on the first spawn. Loads the AlwaysPreload list from DefaultGame.ini, unless the map is one
+ * of SkipMaps, plus the "Preload" bundle of the UFPSMapPreload named after the map, if there is one.
+ */
+UCLASS(Config = Game)
+class FPSPROJECT_API UFPSAssetPreloader : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	bool IsPreloadComplete() const;
+
+	// Blocks until every requested asset is in memory, for tests and benchmarks that need a warm start
+	void WaitForPreload();
+
+	int32 GetNumRequested() const { return NumRequested; }
+	double GetPreloadSeconds() const { return PreloadSeconds; }
+
+	// Returns the loaded asset, or loads it right away and counts a preload miss when the preload did not cover it
+	template<typename T>
+	static T* Resolve(const TSoftObjectPtr<T>& Asset) {
+		if (T* Loaded = Asset.Get()) return Loaded;
+		return Cast<T>(ResolveMiss(Asset.ToSoftObjectPath()));
+	}
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	static UObject* ResolveMiss(const FSoftObjectPath& Path);
+
+	void RequestPreload(const TArray<FSoftObjectPath>& Paths);
+	void RequestMapBundle();
+	void HandlePreloadComplete();
+
+	UPROPERTY(Config)
+	TArray<FSoftObjectPath> AlwaysPreload;
+
+	// Maps without gameplay, like the main menu, that do not get the AlwaysPreload list
+	UPROPERTY(Config)
+	TArray<FString> SkipMaps;
+
+	// Held until the world goes away, releasing a handle lets the assets be garbage collected
+	TArray<TSharedPtr<FStreamableHandle>> Handles;
+
+	FPrimaryAssetId MapPreloadId;
+
+	int32 NumRequested = 0;
+	double StartSeconds = 0.0;
+	double PreloadSeconds = 0.0;
+	bool bPreloadLogged = false;
+};
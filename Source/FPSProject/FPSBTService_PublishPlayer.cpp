@@ -0,0 +1,89 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FPSBTService_PublishPlayer.h"
+#include "FPSPlayerTracker.h"
+#include "AIController.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/BlackboardData.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
+#include "Engine/World.h"
+
+UFPSBTService_PublishPlayer::UFPSBTService_PublishPlayer() {
+	NodeName = TEXT("Publish Player");
+	bNotifyBecomeRelevant = true;
+	bNotifyTick = true;
+	Interval = 0.1f;
+	RandomDeviation = 0.02f;
+
+	PlayerLocationKey.AddVectorFilter(this, GET_MEMBER_NAME_CHECKED(UFPSBTService_PublishPlayer, PlayerLocationKey));
+	PlayerActorKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UFPSBTService_PublishPlayer, PlayerActorKey), AActor::StaticClass());
+}
+
+void UFPSBTService_PublishPlayer::InitializeFromAsset(UBehaviorTree& Asset) {
+	Super::InitializeFromAsset(Asset);
+
+	if (const UBlackboardData* BBAsset = GetBlackboardAsset()) {
+		PlayerLocationKey.ResolveSelectedKey(*BBAsset);
+		PlayerActorKey.ResolveSelectedKey(*BBAsset);
+	}
+}
+
+FString UFPSBTService_PublishPlayer::GetStaticDescription() const {
+	return FString::Printf(TEXT("%s\nLocation: %s, Actor: %s"), *Super::GetStaticDescription(), *PlayerLocationKey.SelectedKeyName.ToString(), *PlayerActorKey.SelectedKeyName.ToString());
+}
+
+void UFPSBTService_PublishPlayer::InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const {
+	InitializeNodeMemory<FBTPublishPlayerMemory>(NodeMemory, InitType);
+}
+
+void UFPSBTService_PublishPlayer::CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const {
+	CleanupNodeMemory<FBTPublishPlayerMemory>(NodeMemory, CleanupType);
+}
+
+void UFPSBTService_PublishPlayer::OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) {
+	Super::OnBecomeRelevant(OwnerComp, NodeMemory);
+
+	// The blackboard may have been cleared while the branch was inactive, e.g. by a pool round trip
+	FBTPublishPlayerMemory* Memory = CastInstanceNodeMemory<FBTPublishPlayerMemory>(NodeMemory);
+	Memory->bPublished = false;
+	Publish(OwnerComp, *Memory);
+}
+
+void UFPSBTService_PublishPlayer::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) {
+	Super::TickNode(OwnerComp, NodeMemory, DeltaSeconds);
+	Publish(OwnerComp, *CastInstanceNodeMemory<FBTPublishPlayerMemory>(NodeMemory));
+}
+
+void UFPSBTService_PublishPlayer::Publish(UBehaviorTreeComponent& OwnerComp, FBTPublishPlayerMemory& Memory) const {
+	UBlackboardComponent* Blackboard = OwnerComp.GetBlackboardComponent();
+	const AAIController* AI = OwnerComp.GetAIOwner();
+	const APawn* Pawn = AI ? AI->GetPawn() : nullptr;
+	UFPSPlayerTracker* Tracker = OwnerComp.GetWorld() ? OwnerComp.GetWorld()->GetSubsystem<UFPSPlayerTracker>() : nullptr;
+	if (!Blackboard || !Pawn || !Tracker) return;
+
+	const FTrackedPlayer* Player = Tracker->FindNearestPlayer(Pawn->GetActorLocation());
+	if (!Player) {
+		if (Memory.bPublished) {
+			if (PlayerLocationKey.IsSet()) Blackboard->ClearValue(PlayerLocationKey.GetSelectedKeyID());
+			if (PlayerActorKey.IsSet()) Blackboard->ClearValue(PlayerActorKey.GetSelectedKeyID());
+			Memory.bPublished = false;
+		}
+		return;
+	}
+
+	const bool bMoved = !Memory.bPublished || FVector::DistSquared(Memory.LastLocation, Player->Location) > FMath::Square(LocationTolerance);
+	if (bMoved && PlayerLocationKey.IsSet()) {
+		Blackboard->SetValue<UBlackboardKeyType_Vector>(PlayerLocationKey.GetSelectedKeyID(), Player->Location);
+		Memory.LastLocation = Player->Location;
+	}
+
+	const bool bActorChanged = !Memory.bPublished || Memory.LastActor != Player->Actor;
+	if (bActorChanged && PlayerActorKey.IsSet()) {
+		Blackboard->SetValue<UBlackboardKeyType_Object>(PlayerActorKey.GetSelectedKeyID(), Player->Actor.Get());
+		Memory.LastActor = Player->Actor;
+	}
+
+	Memory.bPublished = true;
+}
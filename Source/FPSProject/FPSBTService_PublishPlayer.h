@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BTService.h"
+#include "FPSBTService_PublishPlayer.generated.h"
+
+struct FBTPublishPlayerMemory {
+	FVector LastLocation = FVector::ZeroVector;
+	TWeakObjectPtr<AActor> LastActor;
+	bool bPublished = false;
+};
+
+/**
+ * Copies the nearest player from UFPSPlayerTracker into the blackboard. The tracker gathers players once per
+ * frame for every enemy, and unchanged values are not written again so key observers only fire on real moves.
+ */
+UCLASS()
+class FPSPROJECT_API UFPSBTService_PublishPlayer : public UBTService
+{
+	GENERATED_BODY()
+
+public:
+	UFPSBTService_PublishPlayer();
+
+	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+	virtual uint16 GetInstanceMemorySize() const override { return sizeof(FBTPublishPlayerMemory); }
+	virtual FString GetStaticDescription() const override;
+
+	UPROPERTY(EditAnywhere, Category = Blackboard)
+	FBlackboardKeySelector PlayerLocationKey;
+
+	// Optional, leave unset when perception owns the target actor
+	UPROPERTY(EditAnywhere, Category = Blackboard)
+	FBlackboardKeySelector PlayerActorKey;
+
+	// Moves shorter than this are not republished
+	UPROPERTY(EditAnywhere, Category = Blackboard, meta = (ClampMin = "0"))
+	float LocationTolerance = 25.0f;
+
+protected:
+	virtual void InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const override;
+	virtual void CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const override;
+	virtual void OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+
+	void Publish(UBehaviorTreeComponent& OwnerComp, FBTPublishPlayerMemory& Memory) const;
+};
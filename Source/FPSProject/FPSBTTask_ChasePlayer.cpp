@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FPSBTTask_ChasePlayer.h"
+#include "AIController.h"
+#include "BrainComponent.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/BlackboardData.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Navigation/PathFollowingComponent.h"
+
+UFPSBTTask_ChasePlayer::UFPSBTTask_ChasePlayer() {
+	NodeName = TEXT("Chase Player");
+
+	TargetKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UFPSBTTask_ChasePlayer, TargetKey), AActor::StaticClass());
+	TargetKey.AddVectorFilter(this, GET_MEMBER_NAME_CHECKED(UFPSBTTask_ChasePlayer, TargetKey));
+	TargetKey.SelectedKeyName = TEXT("EnemyActor");
+}
+
+void UFPSBTTask_ChasePlayer::InitializeFromAsset(UBehaviorTree& Asset) {
+	Super::InitializeFromAsset(Asset);
+
+	if (const UBlackboardData* BBAsset = GetBlackboardAsset()) {
+		TargetKey.ResolveSelectedKey(*BBAsset);
+	}
+}
+
+FString UFPSBTTask_ChasePlayer::GetStaticDescription() const {
+	return FString::Printf(TEXT("%s: %s at %.0f"), *Super::GetStaticDescription(), *TargetKey.SelectedKeyName.ToString(), ChaseSpeed);
+}
+
+void UFPSBTTask_ChasePlayer::InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const {
+	InitializeNodeMemory<FBTChasePlayerMemory>(NodeMemory, InitType);
+}
+
+void UFPSBTTask_ChasePlayer::CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const {
+	CleanupNodeMemory<FBTChasePlayerMemory>(NodeMemory, CleanupType);
+}
+
+EBTNodeResult::Type UFPSBTTask_ChasePlayer::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) {
+	FBTChasePlayerMemory* Memory = CastInstanceNodeMemory<FBTChasePlayerMemory>(NodeMemory);
+	Memory->MoveRequestID = FAIRequestID::InvalidRequest;
+
+	AAIController* AI = OwnerComp.GetAIOwner();
+	const UBlackboardComponent* Blackboard = OwnerComp.GetBlackboardComponent();
+	if (!AI || !Blackboard) return EBTNodeResult::Failed;
+
+	if (ACharacter* Character = Cast<ACharacter>(AI->GetPawn())) {
+		Character->GetCharacterMovement()->MaxWalkSpeed = ChaseSpeed;
+	}
+
+	FAIMoveRequest Request;
+	Request.SetAcceptanceRadius(AcceptanceRadius);
+	if (TargetKey.SelectedKeyType == UBlackboardKeyType_Object::StaticClass()) {
+		AActor* Target = Cast<AActor>(Blackboard->GetValue<UBlackboardKeyType_Object>(TargetKey.GetSelectedKeyID()));
+		if (!Target) return EBTNodeResult::Failed;
+		Request.SetGoalActor(Target);
+	}
+	else {
+		const FVector Target = Blackboard->GetValue<UBlackboardKeyType_Vector>(TargetKey.GetSelectedKeyID());
+		if (!FAISystem::IsValidLocation(Target)) return EBTNodeResult::Failed;
+		Request.SetGoalLocation(Target);
+	}
+
+	// A goal actor is tracked by path following itself, so a moving player needs no re-issued request
+	const FPathFollowingRequestResult Result = AI->MoveTo(Request);
+	if (Result.Code == EPathFollowingRequestResult::AlreadyAtGoal) return EBTNodeResult::Succeeded;
+	if (Result.Code != EPathFollowingRequestResult::RequestSuccessful) return EBTNodeResult::Failed;
+
+	Memory->MoveRequestID = Result.MoveId;
+	WaitForMessage(OwnerComp, UBrainComponent::AIMessage_MoveFinished, Result.MoveId);
+	WaitForMessage(OwnerComp, UBrainComponent::AIMessage_RepathFailed);
+	return EBTNodeResult::InProgress;
+}
+
+EBTNodeResult::Type UFPSBTTask_ChasePlayer::AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) {
+	FBTChasePlayerMemory* Memory = CastInstanceNodeMemory<FBTChasePlayerMemory>(NodeMemory);
+
+	AAIController* AI = OwnerComp.GetAIOwner();
+	UPathFollowingComponent* PathFollowing = AI ? AI->GetPathFollowingComponent() : nullptr;
+	if (PathFollowing && Memory->MoveRequestID.IsValid() && PathFollowing->GetCurrentRequestId() == Memory->MoveRequestID) {
+		PathFollowing->AbortMove(*this, FPathFollowingResultFlags::OwnerFinished, Memory->MoveRequestID);
+	}
+	Memory->MoveRequestID = FAIRequestID::InvalidRequest;
+
+	return Super::AbortTask(OwnerComp, NodeMemory);
+}
@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BTTaskNode.h"
+#include "AITypes.h"
+#include "FPSBTTask_ChasePlayer.generated.h"
+
+struct FBTChasePlayerMemory {
+	FAIRequestID MoveRequestID;
+};
+
+/**
+ * Native replacement for BTT_ChasePlayer followed by Move To. Switches the pawn to ChaseSpeed and follows the
+ * target key until within AcceptanceRadius. Shared by every enemy running the tree, per-enemy state lives in node memory.
+ */
+UCLASS()
+class FPSPROJECT_API UFPSBTTask_ChasePlayer : public UBTTaskNode
+{
+	GENERATED_BODY()
+
+public:
+	UFPSBTTask_ChasePlayer();
+
+	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+	virtual uint16 GetInstanceMemorySize() const override { return sizeof(FBTChasePlayerMemory); }
+	virtual FString GetStaticDescription() const override;
+
+	// Actor or location to chase
+	UPROPERTY(EditAnywhere, Category = Blackboard)
+	FBlackboardKeySelector TargetKey;
+
+	UPROPERTY(EditAnywhere, Category = Chase, meta = (ClampMin = "0"))
+	float ChaseSpeed = 600.0f;
+
+	UPROPERTY(EditAnywhere, Category = Chase, meta = (ClampMin = "0"))
+	float AcceptanceRadius = 100.0f;
+
+protected:
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual EBTNodeResult::Type AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const override;
+	virtual void CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const override;
+};
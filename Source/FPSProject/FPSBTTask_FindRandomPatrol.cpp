@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FPSBTTask_FindRandomPatrol.h"
+#include "AIController.h"
+#include "NavigationSystem.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/BlackboardData.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+UFPSBTTask_FindRandomPatrol::UFPSBTTask_FindRandomPatrol() {
+	NodeName = TEXT("Find Random Patrol");
+
+	PatrolLocationKey.AddVectorFilter(this, GET_MEMBER_NAME_CHECKED(UFPSBTTask_FindRandomPatrol, PatrolLocationKey));
+	PatrolLocationKey.SelectedKeyName = TEXT("PatrolLocation");
+}
+
+void UFPSBTTask_FindRandomPatrol::InitializeFromAsset(UBehaviorTree& Asset) {
+	Super::InitializeFromAsset(Asset);
+
+	if (const UBlackboardData* BBAsset = GetBlackboardAsset()) {
+		PatrolLocationKey.ResolveSelectedKey(*BBAsset);
+	}
+}
+
+FString UFPSBTTask_FindRandomPatrol::GetStaticDescription() const {
+	return FString::Printf(TEXT("%s: %s within %.0f"), *Super::GetStaticDescription(), *PatrolLocationKey.SelectedKeyName.ToString(), PatrolRadius);
+}
+
+EBTNodeResult::Type UFPSBTTask_FindRandomPatrol::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) {
+	const AAIController* AI = OwnerComp.GetAIOwner();
+	APawn* Pawn = AI ? AI->GetPawn() : nullptr;
+	UBlackboardComponent* Blackboard = OwnerComp.GetBlackboardComponent();
+	if (!Pawn || !Blackboard) return EBTNodeResult::Failed;
+
+	if (ACharacter* Character = Cast<ACharacter>(Pawn)) {
+		Character->GetCharacterMovement()->MaxWalkSpeed = PatrolSpeed;
+	}
+
+	UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(Pawn->GetWorld());
+	FNavLocation Point;
+	if (!NavSys || !NavSys->GetRandomReachablePointInRadius(Pawn->GetActorLocation(), PatrolRadius, Point)) return EBTNodeResult::Failed;
+
+	Blackboard->SetValue<UBlackboardKeyType_Vector>(PatrolLocationKey.GetSelectedKeyID(), Point.Location);
+	return EBTNodeResult::Succeeded;
+}
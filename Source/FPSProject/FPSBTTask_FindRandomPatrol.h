@@ -0,0 +1,35 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BTTaskNode.h"
+#include "FPSBTTask_FindRandomPatrol.generated.h"
+
+/**
+ * Native replacement for BTT_FindRandomPatrol. Switches the pawn to PatrolSpeed and writes a random reachable
+ * point around it to the patrol key. Finishes in one call, so it keeps no node memory.
+ */
+UCLASS()
+class FPSPROJECT_API UFPSBTTask_FindRandomPatrol : public UBTTaskNode
+{
+	GENERATED_BODY()
+
+public:
+	UFPSBTTask_FindRandomPatrol();
+
+	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+	virtual FString GetStaticDescription() const override;
+
+	UPROPERTY(EditAnywhere, Category = Blackboard)
+	FBlackboardKeySelector PatrolLocationKey;
+
+	UPROPERTY(EditAnywhere, Category = Patrol, meta = (ClampMin = "0"))
+	float PatrolRadius = 1000.0f;
+
+	UPROPERTY(EditAnywhere, Category = Patrol, meta = (ClampMin = "0"))
+	float PatrolSpeed = 300.0f;
+
+protected:
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+};
@@ -2,11 +2,16 @@
 
 
 #include "FPSCharacter.h"
+#include "FPSProject.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Engine/World.h"
 #include "FPSWeaponBase.h"
 #include "FPSHUD.h"
+#include "FPSProjectilePool.h"
+#include "FPSProjectileManager.h"
+#include "FPSHitscanSubsystem.h"
+#include "FPSWorldReset.h"
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubSystems.h"
 #include "Kismet/GameplayStatics.h"
@@ -16,6 +21,11 @@
 #include "TimerManager.h"
 #include <GameFramework/GameModeBase.h>
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Aim Traces"), STAT_AimTraces, STATGROUP_FPSProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Aim Traces Reused"), STAT_AimTracesReused, STATGROUP_FPSProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Aim Deferred Shots"), STAT_AimDeferredShots, STATGROUP_FPSProject);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Aim Deferred Latency (ms)"), STAT_AimDeferredLatency, STATGROUP_FPSProject);
+
 // Sets default values
 AFPSCharacter::AFPSCharacter()
 {
@@ -51,6 +61,7 @@ void AFPSCharacter::BeginPlay()
 {
 	Super::BeginPlay();
 	CurrentHealth = MaxHealth;
+	OnHealthChanged.Broadcast(this);
 
 	if (APlayerController* PC = Cast<APlayerController>(Controller)) {
 		if (UEnhancedInputLocalPlayerSubsystem* Subsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PC->GetLocalPlayer())) {
@@ -62,6 +73,17 @@ void AFPSCharacter::BeginPlay()
 
 	UE_LOG(LogTemp, Warning, TEXT("AFPSCharacter BeginPlay, CurrentHealth=%f"), CurrentHealth);
 
+	if (ProjectileClass && bUseProjectileManager) {
+		if (UFPSProjectileManager* ProjectileManager = GetWorld()->GetSubsystem<UFPSProjectileManager>()) {
+			ProjectileManager->ConfigureFromClass(ProjectileClass);
+		}
+	}
+	else if (ProjectileClass) {
+		if (UFPSProjectilePool* Pool = GetWorld()->GetSubsystem<UFPSProjectilePool>()) {
+			Pool->Prewarm(ProjectileClass, ProjectilePoolPrewarmCount);
+		}
+	}
+
 	//TESTING
 	if (WeaponClassToSpawn) {
 		FActorSpawnParameters SpawnParams;
@@ -69,12 +91,14 @@ void AFPSCharacter::BeginPlay()
 		SpawnParams.Instigator = GetInstigator();
 
 		PrimaryWeapon = GetWorld()->SpawnActor<AFPSWeaponBase>(WeaponClassToSpawn, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+		StartingWeapon = PrimaryWeapon;
 
 		if (PrimaryWeapon) {
 			EquippedWeapon = PrimaryWeapon;
 			EquippedWeapon->AttachToComponent(FPSCameraComponent, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
 			EquippedWeapon->SetActorRelativeLocation(FVector(50.f, 20.f, -20.f));
 			EquippedWeapon->SetActorRelativeRotation(FRotator(0.f, 0.f, 0.0f));
+			OnEquippedWeaponChanged.Broadcast(this);
 		}
 	}
 
@@ -91,6 +115,10 @@ void AFPSCharacter::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	if (PendingAims.Num() > 0) {
+		ResolvePendingAims();
+	}
+
 	FVector Current = FPSCameraComponent->GetRelativeLocation();
 	FVector NewLocation = FMath::VInterpTo(Current, TargetCameraOffset, DeltaTime, 8.f);
 	FPSCameraComponent->SetRelativeLocation(NewLocation);
@@ -158,12 +186,13 @@ void AFPSCharacter::StopJump() {
 void AFPSCharacter::ApplyDamage(float Amount) {
 	CurrentHealth -= Amount;
 	CurrentHealth = FMath::Clamp(CurrentHealth, 0.f, MaxHealth);
+	OnHealthChanged.Broadcast(this);
 	GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Green, FString::Printf(TEXT("Player Health: %.1f"), CurrentHealth));
 	if (CurrentHealth <= 0.f) {
 		{
 			bIsDead = true;
 			if (!bIsTestMode) {
-				UGameplayStatics::OpenLevel(this, FName("MainMenu"));
+				RestartLevel(FName("MainMenu"), bSoftResetOnDeath);
 			}
 		}
 	}
@@ -172,6 +201,7 @@ void AFPSCharacter::ApplyDamage(float Amount) {
 void AFPSCharacter::Heal(float Amount) {
 	CurrentHealth += Amount;
 	CurrentHealth = FMath::Clamp(CurrentHealth, 0.f, MaxHealth);
+	OnHealthChanged.Broadcast(this);
 
 	GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Green, FString::Printf(TEXT("Player Health: %.1f"), CurrentHealth));
 }
@@ -182,37 +212,158 @@ void AFPSCharacter::Reload() {
 	}
 }
 
-void AFPSCharacter::HandleWeaponFired(AFPSWeaponBase* Weapon) {
-	if (ProjectileClass && Weapon) {
-		FVector CameraLocation;
-		FRotator CameraRotation;
-		GetActorEyesViewPoint(CameraLocation, CameraRotation);
+void AFPSCharacter::HandleWeaponFired(AFPSWeaponBase* Weapon, const TArray<float>& ShotTimes) {
+	if (!Weapon || ShotTimes.Num() == 0 || (!ProjectileClass && Weapon->HitMode != EWeaponHitMode::Hitscan)) return;
+
+	// One aim trace serves the whole batch
+	FVector CameraLocation;
+	FRotator CameraRotation;
+	GetActorEyesViewPoint(CameraLocation, CameraRotation);
+	const FVector AimDirection = CameraRotation.Vector();
+
+	FVector TargetLocation;
+	if (TryReuseAim(CameraLocation, AimDirection, TargetLocation)) {
+		AimTracesReused++;
+		INC_DWORD_STAT(STAT_AimTracesReused);
+		SpawnShots(Weapon, ShotTimes, TargetLocation);
+		return;
+	}
 
-		FVector TraceStart = CameraLocation;
-		FVector TraceEnd = TraceStart + (CameraRotation.Vector() * 10000.0f);
+	INC_DWORD_STAT(STAT_AimTraces);
 
-		FHitResult Hit;
+	if (bAsyncAimTrace) {
 		FCollisionQueryParams Params;
 		Params.AddIgnoredActor(this);
 
-		FVector TargetLocation = TraceEnd;
-		if (GetWorld()->LineTraceSingleByChannel(Hit, TraceStart, TraceEnd, ECC_Visibility, Params)) {
-			TargetLocation = Hit.ImpactPoint;
+		FPendingAim& Pending = PendingAims.AddDefaulted_GetRef();
+		Pending.Handle = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, CameraLocation, CameraLocation + AimDirection * 10000.0f, ECC_Visibility, Params);
+		Pending.Weapon = Weapon;
+		Pending.ShotTimes = ShotTimes;
+		Pending.EyeLocation = CameraLocation;
+		Pending.AimDirection = AimDirection;
+		Pending.IssueFrame = GFrameCounter;
+		Pending.IssueTime = FPlatformTime::Seconds();
+		AimTracesAsync++;
+		return;
+	}
+
+	TargetLocation = TraceAim(CameraLocation, AimDirection);
+	AimTracesSync++;
+	CacheAim(CameraLocation, AimDirection, TargetLocation, GFrameCounter);
+	SpawnShots(Weapon, ShotTimes, TargetLocation);
+}
+
+bool AFPSCharacter::TryReuseAim(const FVector& EyeLocation, const FVector& AimDirection, FVector& OutTarget) const {
+	if (!bHasCachedAim || AimReuseFrames <= 0 || GFrameCounter - CachedAimFrame > (uint64)AimReuseFrames) return false;
+	if (FVector::DistSquared(EyeLocation, CachedAimEye) > FMath::Square(AimReuseDistance)) return false;
+	if ((AimDirection | CachedAimDirection) < FMath::Cos(FMath::DegreesToRadians(AimReuseAngle))) return false;
+
+	OutTarget = CachedAimTarget;
+	return true;
+}
+
+void AFPSCharacter::CacheAim(const FVector& EyeLocation, const FVector& AimDirection, const FVector& Target, uint64 Frame) {
+	CachedAimEye = EyeLocation;
+	CachedAimDirection = AimDirection;
+	CachedAimTarget = Target;
+	CachedAimFrame = Frame;
+	bHasCachedAim = true;
+}
+
+FVector AFPSCharacter::TraceAim(const FVector& EyeLocation, const FVector& AimDirection) {
+	FVector TraceStart = EyeLocation;
+	FVector TraceEnd = TraceStart + (AimDirection * 10000.0f);
+
+	FHitResult Hit;
+	FCollisionQueryParams Params;
+	Params.AddIgnoredActor(this);
+
+	FVector TargetLocation = TraceEnd;
+	if (GetWorld()->LineTraceSingleByChannel(Hit, TraceStart, TraceEnd, ECC_Visibility, Params)) {
+		TargetLocation = Hit.ImpactPoint;
+	}
+	return TargetLocation;
+}
+
+void AFPSCharacter::ResolvePendingAims() {
+	UWorld* World = GetWorld();
+
+	// Traces issued this frame are only readable next frame. Pending aims are kept in issue order.
+	int32 NumReady = 0;
+	while (NumReady < PendingAims.Num() && PendingAims[NumReady].IssueFrame < GFrameCounter) {
+		NumReady++;
+	}
+
+	for (int32 i = 0; i < NumReady; i++) {
+		const FPendingAim& Pending = PendingAims[i];
+		FVector TargetLocation = Pending.EyeLocation + Pending.AimDirection * 10000.0f;
+		FTraceDatum Datum;
+		if (World->QueryTraceData(Pending.Handle, Datum)) {
+			for (const FHitResult& Hit : Datum.OutHits) {
+				if (Hit.bBlockingHit) {
+					TargetLocation = Hit.ImpactPoint;
+					break;
+				}
+			}
+		}
+		else {
+			// The result is gone, e.g. after a hitch skipped a frame. Pay for a sync trace rather than lose the shots.
+			TargetLocation = TraceAim(Pending.EyeLocation, Pending.AimDirection);
 		}
 
-		FVector MuzzleLocation = Weapon->GetMuzzleWorldLocation();
-		FVector ShootDirection = (TargetLocation - MuzzleLocation).GetSafeNormal();
+		CacheAim(Pending.EyeLocation, Pending.AimDirection, TargetLocation, Pending.IssueFrame);
+		if (AFPSWeaponBase* Weapon = Pending.Weapon.Get()) {
+			SpawnShots(Weapon, Pending.ShotTimes, TargetLocation);
+		}
 
-		UWorld* World = GetWorld();
-		if (World) {
-			FActorSpawnParameters SpawnParams;
-			SpawnParams.Owner = this;
-			SpawnParams.Instigator = GetInstigator();
+		INC_DWORD_STAT_BY(STAT_AimDeferredShots, Pending.ShotTimes.Num());
+		SET_FLOAT_STAT(STAT_AimDeferredLatency, (FPlatformTime::Seconds() - Pending.IssueTime) * 1000.0);
+	}
+	PendingAims.RemoveAt(0, NumReady, EAllowShrinking::No);
+}
+
+void AFPSCharacter::UseProjectileManager(TSubclassOf<AFPSProjectile> InProjectileClass) {
+	ProjectileClass = InProjectileClass;
+	bUseProjectileManager = true;
+	if (UFPSProjectileManager* ProjectileManager = ProjectileClass ? GetWorld()->GetSubsystem<UFPSProjectileManager>() : nullptr) {
+		ProjectileManager->ConfigureFromClass(ProjectileClass);
+	}
+}
+
+void AFPSCharacter::SpawnShots(AFPSWeaponBase* Weapon, const TArray<float>& ShotTimes, const FVector& TargetLocation) {
+	FVector MuzzleLocation = Weapon->GetMuzzleWorldLocation();
+	FVector ShootDirection = (TargetLocation - MuzzleLocation).GetSafeNormal();
+
+	UWorld* World = GetWorld();
+	if (Weapon->HitMode == EWeaponHitMode::Hitscan) {
+		if (UFPSHitscanSubsystem* Hitscan = World ? World->GetSubsystem<UFPSHitscanSubsystem>() : nullptr) {
+			for (int32 i = 0; i < ShotTimes.Num(); i++) {
+				Hitscan->QueueShot(MuzzleLocation, ShootDirection, Weapon->HitscanRange, Weapon->PelletCount, Weapon->SpreadDegrees, Weapon->Damage, this);
+			}
+		}
+		return;
+	}
 
-			AFPSProjectile* Projectile = World->SpawnActor<AFPSProjectile>(ProjectileClass, MuzzleLocation, ShootDirection.Rotation(), SpawnParams);
+	// Older shots of the batch start further down the line, so bullets keep their spacing at low frame rates.
+	// Both projectile paths take the same time in flight, counted back from the newest shot.
+	const float LatestShot = ShotTimes.Last();
+
+	if (bUseProjectileManager) {
+		if (UFPSProjectileManager* ProjectileManager = World ? World->GetSubsystem<UFPSProjectileManager>() : nullptr) {
+			for (float ShotTime : ShotTimes) {
+				ProjectileManager->Fire(MuzzleLocation, ShootDirection, Weapon->Damage, this, LatestShot - ShotTime);
+			}
+			return;
+		}
+	}
+
+	UFPSProjectilePool* Pool = World ? World->GetSubsystem<UFPSProjectilePool>() : nullptr;
+	if (Pool) {
+		for (float ShotTime : ShotTimes) {
+			AFPSProjectile* Projectile = Pool->Acquire(ProjectileClass, MuzzleLocation, ShootDirection.Rotation(), this, GetInstigator());
 			if (Projectile) {
 				Projectile->Damage = Weapon->Damage;
-				Projectile->FireInDirection(ShootDirection);
+				Projectile->FireInDirection(ShootDirection, LatestShot - ShotTime);
 			}
 		}
 	}
@@ -292,6 +443,7 @@ void AFPSCharacter::SwapWeapon(const FInputActionValue& Value) {
 void AFPSCharacter::NextWeapon() {
 	if (PrimaryWeapon && SecondaryWeapon) {
 		if (EquippedWeapon) {
+			EquippedWeapon->StopFiring();
 			EquippedWeapon->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
 			EquippedWeapon->SetActorHiddenInGame(true);
 		}
@@ -301,6 +453,13 @@ void AFPSCharacter::NextWeapon() {
 		EquippedWeapon->AttachToComponent(FPSCameraComponent, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
 		EquippedWeapon->SetActorRelativeLocation(FVector(50.0f, 20.0f, -20.0f));
 		EquippedWeapon->SetActorRelativeRotation(FRotator(0.0f, 0.0f, 0.0f));
+
+		OnEquippedWeaponChanged.Broadcast(this);
+
+		// The trigger stays down across a swap
+		if (bIsFiring) {
+			EquippedWeapon->StartFiring();
+		}
 	}
 }
 
@@ -308,29 +467,27 @@ void AFPSCharacter::PrevWeapon() { NextWeapon(); }
 
 void AFPSCharacter::StartFire() {
 	bIsFiring = true;
-	HandleFire();
+	if (EquippedWeapon) {
+		EquippedWeapon->StartFiring();
+	}
 }
 
 void AFPSCharacter::StopFire() {
 	bIsFiring = false;
-	GetWorld()->GetTimerManager().ClearTimer(FireTimerHandle);
-}
-
-void AFPSCharacter::HandleFire() {
 	if (EquippedWeapon) {
-		EquippedWeapon->Fire();
-
-		if (EquippedWeapon->FireMode == EWeaponFireMode::FullAuto && bIsFiring) {
-			float TimeBetweenShots = 1.0f / EquippedWeapon->FireRate;
-			GetWorld()->GetTimerManager().SetTimer(FireTimerHandle, this, &AFPSCharacter::HandleFire, TimeBetweenShots, false);
-		}
+		EquippedWeapon->StopFiring();
 	}
 }
 
 void AFPSCharacter::CollectItem(ECollectibleType Type) {
 	if (Type == ECollectibleType::BlueSapphire) BlueSapphireCount++;
 	else if (Type == ECollectibleType::RedRuby) RedRubyCount++;
-	else if (Type == ECollectibleType::FinishToken) UGameplayStatics::OpenLevel(this, FName("FPSMap"));
+	else if (Type == ECollectibleType::FinishToken) {
+		// Only the map we are already on can be reset in place
+		const FName FinishLevel("FPSMap");
+		RestartLevel(FinishLevel, bSoftResetOnFinish && UGameplayStatics::GetCurrentLevelName(this) == FinishLevel.ToString());
+	}
+	OnInventoryChanged.Broadcast(this);
 
 	// Achievement
 	if (!bUnlockedAllCollectibles && RedRubyCount >= 5 && BlueSapphireCount >= 5) {
@@ -340,6 +497,69 @@ void AFPSCharacter::CollectItem(ECollectibleType Type) {
 	}
 }
 
+void AFPSCharacter::RestartLevel(FName LevelName, bool bSoftReset) {
+	UFPSWorldReset* WorldReset = GetWorld()->GetSubsystem<UFPSWorldReset>();
+	if (bSoftReset && WorldReset) {
+		WorldReset->RequestReset(LevelName);
+		return;
+	}
+	UGameplayStatics::OpenLevel(this, LevelName);
+}
+
+void AFPSCharacter::ResetPlayer(const FVector& Location, const FRotator& Rotation) {
+	StopFire();
+	PendingAims.Reset();
+	bHasCachedAim = false;
+
+	// Weapons picked up during the run go away, their pickups are restored with the level
+	if (SecondaryWeapon && SecondaryWeapon != StartingWeapon) {
+		SecondaryWeapon->Destroy();
+	}
+	if (PrimaryWeapon && PrimaryWeapon != StartingWeapon) {
+		PrimaryWeapon->Destroy();
+	}
+	PrimaryWeapon = StartingWeapon;
+	SecondaryWeapon = nullptr;
+	EquippedWeapon = StartingWeapon;
+	if (EquippedWeapon) {
+		EquippedWeapon->ResetWeapon();
+		EquippedWeapon->SetActorHiddenInGame(false);
+
+		// Switching to the secondary weapon detached the starting one where it was
+		EquippedWeapon->AttachToComponent(FPSCameraComponent, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+		EquippedWeapon->SetActorRelativeLocation(FVector(50.0f, 20.0f, -20.0f));
+		EquippedWeapon->SetActorRelativeRotation(FRotator(0.0f, 0.0f, 0.0f));
+	}
+	OnEquippedWeaponChanged.Broadcast(this);
+
+	CurrentHealth = MaxHealth;
+	bIsDead = false;
+	RedRubyCount = 0;
+	BlueSapphireCount = 0;
+	KillCount = 0;
+	bUnlocked10Kills = false;
+	bUnlocked20Kills = false;
+	bUnlocked50Kills = false;
+	bUnlockedAllCollectibles = false;
+
+	bIsSprinting = false;
+	if (bIsCrouchedCustom) {
+		bIsCrouchedCustom = false;
+		GetCapsuleComponent()->SetCapsuleHalfHeight(DefaultCapsuleHalfHeight, true);
+		TargetCameraOffset = DefaultCameraOffset;
+	}
+	GetCharacterMovement()->MaxWalkSpeed = WalkSpeed;
+	GetCharacterMovement()->StopMovementImmediately();
+
+	TeleportTo(Location, Rotation, false, true);
+	if (Controller) {
+		Controller->SetControlRotation(Rotation);
+	}
+
+	OnHealthChanged.Broadcast(this);
+	OnInventoryChanged.Broadcast(this);
+}
+
 void AFPSCharacter::OnEnemyKilled() {
 	KillCount++;
 
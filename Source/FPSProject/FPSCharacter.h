@@ -11,11 +11,14 @@
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "CollectiblePickup.h"
+#include "WorldCollision.h"
 
 class AFPSWeaponBase;
 
 #include "FPSCharacter.generated.h"
 
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnPlayerStateChanged, class AFPSCharacter*);
+
 UCLASS()
 class FPSPROJECT_API AFPSCharacter : public ACharacter
 {
@@ -32,6 +35,14 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = Projectile)
 	TSubclassOf<class AFPSProjectile> ProjectileClass;
 
+	// Projectiles handed to the world's projectile pool on BeginPlay so sustained fire never spawns
+	UPROPERTY(EditDefaultsOnly, Category = Projectile)
+	int32 ProjectilePoolPrewarmCount = 32;
+
+	// Fires through UFPSProjectileManager instead of projectile actors, ProjectileClass still supplies the look and speed
+	UPROPERTY(EditDefaultsOnly, Category = Projectile)
+	bool bUseProjectileManager = false;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon")
 	AFPSWeaponBase* PrimaryWeapon = nullptr;
 
@@ -44,6 +55,34 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "Weapon")
 	TSubclassOf<AFPSWeaponBase> WeaponClassToSpawn;
 
+	// The weapon spawned from WeaponClassToSpawn, the only one the player keeps across a world reset
+	UPROPERTY()
+	AFPSWeaponBase* StartingWeapon = nullptr;
+
+	struct FPendingAim {
+		FTraceHandle Handle;
+		TWeakObjectPtr<AFPSWeaponBase> Weapon;
+		TArray<float> ShotTimes;
+		FVector EyeLocation;
+		FVector AimDirection;
+		uint64 IssueFrame;
+		double IssueTime;
+	};
+
+	bool TryReuseAim(const FVector& EyeLocation, const FVector& AimDirection, FVector& OutTarget) const;
+	void CacheAim(const FVector& EyeLocation, const FVector& AimDirection, const FVector& Target, uint64 Frame);
+	FVector TraceAim(const FVector& EyeLocation, const FVector& AimDirection);
+	void ResolvePendingAims();
+	void SpawnShots(AFPSWeaponBase* Weapon, const TArray<float>& ShotTimes, const FVector& TargetLocation);
+
+	TArray<FPendingAim> PendingAims;
+
+	FVector CachedAimEye = FVector::ZeroVector;
+	FVector CachedAimDirection = FVector::ZeroVector;
+	FVector CachedAimTarget = FVector::ZeroVector;
+	uint64 CachedAimFrame = 0;
+	bool bHasCachedAim = false;
+
 public:	
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
@@ -63,8 +102,9 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void Reload();
 
+	// Spawns one batch of shots. ShotTimes are seconds after the start of the frame, as produced by the weapon's fire scheduler.
 	UFUNCTION()
-	void HandleWeaponFired(AFPSWeaponBase* Weapon);
+	void HandleWeaponFired(AFPSWeaponBase* Weapon, const TArray<float>& ShotTimes);
 
 	UFUNCTION(BlueprintCallable, Category = "Health")
 	void ApplyDamage(float Amount);
@@ -171,12 +211,50 @@ public:
 	UFUNCTION()
 	void CollectItem(ECollectibleType Type);
 
-	FTimerHandle FireTimerHandle;
+	// Death and the finish token restart the loaded world through UFPSWorldReset instead of opening a level.
+	// Turned off, or if the reset fails, the level is opened as before. Off for death by default, since a soft reset
+	// keeps the player in the current map where death normally goes back to the main menu.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Gameplay")
+	bool bSoftResetOnDeath = false;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Gameplay")
+	bool bSoftResetOnFinish = true;
+
+	// Opens LevelName, or resets the loaded world in place when bSoftReset is set
+	void RestartLevel(FName LevelName, bool bSoftReset);
+
+	// Puts the player back to how it spawned: full health, empty inventory, starting weapon only, standing at Location
+	void ResetPlayer(const FVector& Location, const FRotator& Rotation);
+
 	bool bIsFiring = false;
 
 	void StartFire();
 	void StopFire();
-	void HandleFire();
+
+	// Aim traces run async and the shots spawn next frame from the result, one frame after the trigger
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon|Aim")
+	bool bAsyncAimTrace = false;
+
+	// The last aim hit is reused while the eyes moved less than this and turned less than AimReuseAngle degrees
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon|Aim", meta = (ClampMin = "0"))
+	float AimReuseDistance = 2.0f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon|Aim", meta = (ClampMin = "0"))
+	float AimReuseAngle = 0.25f;
+
+	// Frames an aim hit stays valid for reuse, 0 traces every batch. Off by default, since a reused hit can miss
+	// something that moved into the line of fire since it was traced.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon|Aim", meta = (ClampMin = "0"))
+	int32 AimReuseFrames = 0;
+
+	int32 GetNumPendingAims() const { return PendingAims.Num(); }
+
+	// Switches projectile shots over to UFPSProjectileManager at runtime, for benchmarks and tests using the native class
+	void UseProjectileManager(TSubclassOf<AFPSProjectile> InProjectileClass);
+
+	int32 AimTracesSync = 0;
+	int32 AimTracesAsync = 0;
+	int32 AimTracesReused = 0;
 
 	AFPSWeaponBase* GetPrimaryWeapon() const { return PrimaryWeapon; }
 	AFPSWeaponBase* GetSecondaryWeapon() const { return SecondaryWeapon; }
@@ -184,7 +262,12 @@ public:
 
 	void SetPrimaryWeapon(AFPSWeaponBase* NewWeapon) { PrimaryWeapon = NewWeapon; }
 	void SetSecondaryWeapon(AFPSWeaponBase* NewWeapon) { SecondaryWeapon = NewWeapon; }
-	void SetEquippedWeapon(AFPSWeaponBase* NewWeapon) { EquippedWeapon = NewWeapon; }
+	void SetEquippedWeapon(AFPSWeaponBase* NewWeapon) { EquippedWeapon = NewWeapon; OnEquippedWeaponChanged.Broadcast(this); }
+
+	// Change events the HUD listens to instead of polling
+	FOnPlayerStateChanged OnHealthChanged;
+	FOnPlayerStateChanged OnInventoryChanged;
+	FOnPlayerStateChanged OnEquippedWeaponChanged;
 
 	int32 KillCount = 0;
 	bool bUnlocked10Kills = false;
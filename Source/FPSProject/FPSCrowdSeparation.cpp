@@ -0,0 +1,226 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FPSCrowdSeparation.h"
+#include "FPSProject.h"
+#include "FPSEnemyDumb.h"
+#include "FPSFlowField.h"
+#include "FPSPlayerTracker.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Crowd Separation"), STAT_CrowdSeparation, STATGROUP_FPSProject);
+DECLARE_CYCLE_STAT(TEXT("Crowd Think"), STAT_CrowdThink, STATGROUP_FPSProject);
+DECLARE_CYCLE_STAT(TEXT("Crowd Spatial Hash Build"), STAT_CrowdHashBuild, STATGROUP_FPSProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Crowd Separation Agents"), STAT_CrowdAgents, STATGROUP_FPSProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Crowd Think Agents"), STAT_CrowdThinkAgents, STATGROUP_FPSProject);
+
+namespace CrowdSeparation
+{
+	// Agents per ParallelFor task in the separation and chase passes
+	static const int32 ChunkSize = 128;
+}
+
+void FCrowdSpatialHash::Build(const TArray<FVector>& InPositions, float InCellSize) {
+	SCOPE_CYCLE_COUNTER(STAT_CrowdHashBuild);
+
+	Positions = &InPositions;
+	CellSize = FMath::Max(InCellSize, 1.0f);
+
+	const int32 NumPositions = InPositions.Num();
+	TableSize = FMath::RoundUpToPowerOfTwo(FMath::Max(NumPositions * 2, 16));
+
+	TArray<uint32, TInlineAllocator<256>> Buckets;
+	Buckets.SetNumUninitialized(NumPositions);
+	CellStart.Init(0, TableSize + 1);
+
+	for (int32 i = 0; i < NumPositions; i++) {
+		const FVector& P = InPositions[i];
+		Buckets[i] = HashCell(FMath::FloorToInt(P.X / CellSize), FMath::FloorToInt(P.Y / CellSize));
+		CellStart[Buckets[i] + 1]++;
+	}
+	for (uint32 B = 0; B < TableSize; B++) {
+		CellStart[B + 1] += CellStart[B];
+	}
+
+	// Counting sort, Fill tracks the next free slot of every bucket
+	TArray<int32> Fill(CellStart.GetData(), TableSize);
+	Sorted.SetNumUninitialized(NumPositions);
+	for (int32 i = 0; i < NumPositions; i++) {
+		Sorted[Fill[Buckets[i]]++] = i;
+	}
+}
+
+void UFPSCrowdSeparation::Initialize(FSubsystemCollectionBase& Collection) {
+	Super::Initialize(Collection);
+
+	PreActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddUObject(this, &UFPSCrowdSeparation::HandlePreActorTick);
+}
+
+void UFPSCrowdSeparation::Deinitialize() {
+	FWorldDelegates::OnWorldPreActorTick.Remove(PreActorTickHandle);
+
+	Agents.Empty();
+	Active.Empty();
+	Positions.Empty();
+	Offsets.Empty();
+	Targets.Empty();
+	Thinking.Empty();
+	ThinkPositions.Empty();
+	ThinkOffsets.Empty();
+	Directions.Empty();
+	Super::Deinitialize();
+}
+
+void UFPSCrowdSeparation::RegisterAgent(AFPSEnemyDumb* Enemy) {
+	if (!Enemy) return;
+
+	Agents.AddUnique(Enemy);
+}
+
+void UFPSCrowdSeparation::UnregisterAgent(AFPSEnemyDumb* Enemy) {
+	Agents.RemoveSwap(Enemy);
+}
+
+void UFPSCrowdSeparation::HandlePreActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds) {
+	if (InWorld != GetWorld() || TickType == LEVELTICK_ViewportsOnly) return;
+
+	UpdateSeparation();
+	ThinkChase();
+}
+
+void UFPSCrowdSeparation::UpdateSeparation() {
+	SCOPE_CYCLE_COUNTER(STAT_CrowdSeparation);
+
+	Agents.RemoveAllSwap([](const AFPSEnemyDumb* Enemy) {
+		return !IsValid(Enemy);
+		});
+
+	// Pooled enemies stay registered but are not part of the crowd
+	Active.Reset();
+	Positions.Reset();
+	for (AFPSEnemyDumb* Enemy : Agents) {
+		if (Enemy->IsInPool()) continue;
+
+		Active.Add(Enemy);
+		Positions.Add(Enemy->GetActorLocation());
+	}
+
+	ComputeSeparation(Positions, SeparationRadius, SeparationStrength, Offsets, Hash);
+
+	for (int32 i = 0; i < Active.Num(); i++) {
+		Active[i]->SeparationSteering = Offsets[i];
+	}
+
+	SET_DWORD_STAT(STAT_CrowdAgents, Active.Num());
+}
+
+void UFPSCrowdSeparation::ThinkChase() {
+	SCOPE_CYCLE_COUNTER(STAT_CrowdThink);
+
+	// Everything the workers read is gathered here on the game thread, they never touch an actor or a subsystem
+	Targets.Reset();
+	if (UFPSPlayerTracker* Tracker = GetWorld()->GetSubsystem<UFPSPlayerTracker>()) {
+		for (const FTrackedPlayer& Player : Tracker->GetPlayers()) {
+			Targets.Add(Player.Location);
+		}
+	}
+
+	// Less significant enemies tick less often, so they only think again once their next tick can use the result
+	const double Now = GetWorld()->GetTimeSeconds();
+	Thinking.Reset();
+	ThinkPositions.Reset();
+	ThinkOffsets.Reset();
+	for (int32 i = 0; i < Active.Num(); i++) {
+		AFPSEnemyDumb* Enemy = Active[i];
+		if (!IsValid(Enemy) || Now < Enemy->NextChaseThinkTime) continue;
+
+		Enemy->NextChaseThinkTime = Now + Enemy->GetActorTickInterval();
+		Thinking.Add(Enemy);
+		ThinkPositions.Add(Positions[i]);
+		ThinkOffsets.Add(Offsets[i]);
+	}
+	SET_DWORD_STAT(STAT_CrowdThinkAgents, Thinking.Num());
+
+	ComputeChase(ThinkPositions, ThinkOffsets, Targets, GetWorld()->GetSubsystem<UFPSFlowField>(), Directions);
+
+	// Apply phase, the enemies feed it to AddMovementInput in their own game thread Tick
+	for (int32 i = 0; i < Thinking.Num(); i++) {
+		Thinking[i]->ChaseDirection = Directions[i];
+	}
+}
+
+void UFPSCrowdSeparation::ComputeChase(const TArray<FVector>& Positions, const TArray<FVector>& Offsets, const TArray<FVector>& Targets, const UFPSFlowField* FlowField, TArray<FVector>& OutDirections) {
+	const int32 Num = Positions.Num();
+	OutDirections.SetNumUninitialized(Num);
+	if (Num == 0) return;
+
+	const int32 Chunk = CrowdSeparation::ChunkSize;
+	const int32 NumChunks = FMath::DivideAndRoundUp(Num, Chunk);
+	ParallelFor(NumChunks, [&](int32 ChunkIndex) {
+		const int32 Start = ChunkIndex * Chunk;
+		const int32 End = FMath::Min(Start + Chunk, Num);
+		for (int32 i = Start; i < End; i++) {
+			const FVector& Self = Positions[i];
+
+			// The flow field goes around walls, straight at the nearest player is the fallback when it has no answer here
+			FVector Direction = FVector::ZeroVector;
+			if (!FlowField || !FlowField->GetDirection(Self, Direction)) {
+				float NearestDistSq = TNumericLimits<float>::Max();
+				for (const FVector& Target : Targets) {
+					const float DistSq = FVector::DistSquared(Self, Target);
+					if (DistSq < NearestDistSq) {
+						NearestDistSq = DistSq;
+						Direction = (Target - Self).GetSafeNormal();
+					}
+				}
+			}
+
+			// Neighbours push us aside before the capsules touch, so movement does not have to depenetrate
+			const FVector Offset = Offsets.IsValidIndex(i) ? Offsets[i] : FVector::ZeroVector;
+			OutDirections[i] = (Direction + Offset).GetClampedToMaxSize(1.0f);
+		}
+		});
+}
+
+void UFPSCrowdSeparation::ComputeSeparation(const TArray<FVector>& Positions, float Radius, float Strength, TArray<FVector>& OutOffsets, FCrowdSpatialHash& Hash) {
+	const int32 Num = Positions.Num();
+	OutOffsets.SetNumUninitialized(Num);
+	if (Num == 0 || Radius <= 0.0f) {
+		for (FVector& Offset : OutOffsets) {
+			Offset = FVector::ZeroVector;
+		}
+		return;
+	}
+
+	Hash.Build(Positions, Radius);
+
+	const int32 Chunk = CrowdSeparation::ChunkSize;
+	const int32 NumChunks = FMath::DivideAndRoundUp(Num, Chunk);
+	ParallelFor(NumChunks, [&](int32 ChunkIndex) {
+		const int32 Start = ChunkIndex * Chunk;
+		const int32 End = FMath::Min(Start + Chunk, Num);
+		for (int32 i = Start; i < End; i++) {
+			const FVector& Self = Positions[i];
+			FVector Push = FVector::ZeroVector;
+
+			// Closer neighbours push harder, falling off linearly to nothing at Radius
+			Hash.ForEachNeighbour(Self, Radius, [&](int32 Other) {
+				if (Other == i) return;
+
+				FVector Away = Self - Positions[Other];
+				Away.Z = 0.0f;
+				const float Dist = Away.Size();
+				if (Dist > KINDA_SMALL_NUMBER) {
+					Push += (Away / Dist) * (1.0f - Dist / Radius);
+				}
+				else {
+					// Exactly stacked, split them by index so they do not stay glued
+					Push += FVector(i < Other ? 1.0f : -1.0f, 0.0f, 0.0f);
+				}
+				});
+
+			OutOffsets[i] = Push.GetClampedToMaxSize(1.0f) * Strength;
+		}
+		});
+}
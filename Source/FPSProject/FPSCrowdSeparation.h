@@ -0,0 +1,125 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FPSCrowdSeparation.generated.h"
+
+class AFPSEnemyDumb;
+class UFPSFlowField;
+
+/**
+ * Uniform 2D spatial hash over a flat array of positions, rebuilt from scratch each frame with a counting sort.
+ * Cells are hashed into a power of two table, so the world does not need bounds.
+ */
+struct FPSPROJECT_API FCrowdSpatialHash {
+	void Build(const TArray<FVector>& InPositions, float InCellSize);
+
+	// Calls Visit(Index) for every position within Radius (2D) of Location, Radius must not exceed the cell size
+	template <typename FuncType>
+	void ForEachNeighbour(const FVector& Location, float Radius, FuncType&& Visit) const;
+
+	int32 Num() const { return Positions ? Positions->Num() : 0; }
+
+private:
+	uint32 HashCell(int32 X, int32 Y) const { return (((uint32)X * 73856093u) ^ ((uint32)Y * 19349663u)) & (TableSize - 1); }
+
+	const TArray<FVector>* Positions = nullptr;
+	float CellSize = 100.0f;
+	uint32 TableSize = 0;
+
+	// Agents sorted by bucket, bucket B owns Sorted[CellStart[B] .. CellStart[B + 1])
+	TArray<int32> CellStart;
+	TArray<int32> Sorted;
+};
+
+template <typename FuncType>
+void FCrowdSpatialHash::ForEachNeighbour(const FVector& Location, float Radius, FuncType&& Visit) const {
+	if (TableSize == 0) return;
+
+	const float RadiusSq = Radius * Radius;
+	const int32 MinX = FMath::FloorToInt((Location.X - Radius) / CellSize);
+	const int32 MaxX = FMath::FloorToInt((Location.X + Radius) / CellSize);
+	const int32 MinY = FMath::FloorToInt((Location.Y - Radius) / CellSize);
+	const int32 MaxY = FMath::FloorToInt((Location.Y + Radius) / CellSize);
+
+	// Different cells can share a bucket, each bucket is only walked once
+	TArray<uint32, TInlineAllocator<9>> Visited;
+	for (int32 Y = MinY; Y <= MaxY; Y++) {
+		for (int32 X = MinX; X <= MaxX; X++) {
+			const uint32 Bucket = HashCell(X, Y);
+			if (Visited.Contains(Bucket)) continue;
+			Visited.Add(Bucket);
+
+			for (int32 i = CellStart[Bucket]; i < CellStart[Bucket + 1]; i++) {
+				const int32 Index = Sorted[i];
+				if (FVector::DistSquared2D((*Positions)[Index], Location) <= RadiusSq) {
+					Visit(Index);
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Pushes chasing enemies apart with steering instead of capsule depenetration. Once per frame, before actors tick,
+ * every registered dumb enemy is hashed, a batched pass computes a separation offset from its neighbours, and the
+ * offset is handed to the enemy to blend into its chase direction.
+ *
+ * The same snapshot of positions then feeds the think pass, which picks chase directions in parallel from the flow
+ * field or the nearest player. Enemies the significance LOD ticks less often are only thought through at their own
+ * tick interval. The enemy's Tick only applies the result on the game thread.
+ */
+UCLASS()
+class FPSPROJECT_API UFPSCrowdSeparation : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	void RegisterAgent(AFPSEnemyDumb* Enemy);
+	void UnregisterAgent(AFPSEnemyDumb* Enemy);
+
+	// Runs the pass over the registered enemies, normally driven by the world's pre-actor-tick
+	void UpdateSeparation();
+
+	// Chase directions for the enemies UpdateSeparation just snapshotted, normally run right after it
+	void ThinkChase();
+
+	// Offset per position pushing it away from neighbours closer than Radius, scaled to at most Strength.
+	// Shared with the swarm, which runs it on its own positions.
+	static void ComputeSeparation(const TArray<FVector>& Positions, float Radius, float Strength, TArray<FVector>& OutOffsets, FCrowdSpatialHash& Hash);
+
+	// Direction per position toward the nearest target, around walls when the flow field knows the way, with the
+	// separation offset blended in. Only reads its inputs, so it runs on worker threads.
+	static void ComputeChase(const TArray<FVector>& Positions, const TArray<FVector>& Offsets, const TArray<FVector>& Targets, const UFPSFlowField* FlowField, TArray<FVector>& OutDirections);
+
+	int32 GetNumAgents() const { return Agents.Num(); }
+
+	float SeparationRadius = 120.0f;
+	float SeparationStrength = 1.0f;
+
+protected:
+	void HandlePreActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+
+	UPROPERTY()
+	TArray<AFPSEnemyDumb*> Agents;
+
+	// Snapshot of the current pass, Active[i] stood at Positions[i]
+	TArray<AFPSEnemyDumb*> Active;
+	TArray<FVector> Positions;
+	TArray<FVector> Offsets;
+	TArray<FVector> Targets;
+
+	// The part of the snapshot due to think this pass, Directions lines up with it
+	TArray<AFPSEnemyDumb*> Thinking;
+	TArray<FVector> ThinkPositions;
+	TArray<FVector> ThinkOffsets;
+	TArray<FVector> Directions;
+	FCrowdSpatialHash Hash;
+
+	FDelegateHandle PreActorTickHandle;
+};
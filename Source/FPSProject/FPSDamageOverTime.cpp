@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FPSDamageOverTime.h"
+#include "FPSProject.h"
+#include "FPSDamageQueue.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Damage Over Time Effects"), STAT_DamageOverTimeEffects, STATGROUP_FPSProject);
+
+void UFPSDamageOverTime::Deinitialize() {
+	if (UWorld* World = GetWorld()) {
+		World->GetTimerManager().ClearTimer(UpdateTimerHandle);
+	}
+	Effects.Empty();
+	Super::Deinitialize();
+}
+
+void UFPSDamageOverTime::ApplyEffect(AActor* Target, const UObject* Source, float DamagePerSecond, float Duration) {
+	if (!IsValid(Target) || Duration <= 0.0f) return;
+
+	FDamageOverTimeEffect* Effect = Effects.FindByPredicate([Target, Source](const FDamageOverTimeEffect& Existing) {
+		return Existing.Target.Get() == Target && Existing.Source.Get() == Source;
+		});
+	if (!Effect) {
+		Effect = &Effects.AddDefaulted_GetRef();
+		Effect->Target = Target;
+		Effect->Source = Source;
+	}
+	Effect->DamagePerSecond = DamagePerSecond;
+	Effect->Remaining = Duration;
+	SET_DWORD_STAT(STAT_DamageOverTimeEffects, Effects.Num());
+
+	if (!UpdateTimerHandle.IsValid()) {
+		GetWorld()->GetTimerManager().SetTimer(UpdateTimerHandle, this, &UFPSDamageOverTime::HandleUpdateTimer, UpdateInterval, true);
+	}
+}
+
+void UFPSDamageOverTime::RemoveEffects(const UObject* Source) {
+	Effects.RemoveAllSwap([Source](const FDamageOverTimeEffect& Effect) {
+		return Effect.Source.Get() == Source;
+		});
+	SET_DWORD_STAT(STAT_DamageOverTimeEffects, Effects.Num());
+}
+
+void UFPSDamageOverTime::RemoveAllEffects() {
+	// The update timer stops itself once it finds nothing to update
+	Effects.Reset();
+	SET_DWORD_STAT(STAT_DamageOverTimeEffects, 0);
+}
+
+void UFPSDamageOverTime::UpdateEffects(float DeltaSeconds) {
+	UFPSDamageQueue* DamageQueue = GetWorld()->GetSubsystem<UFPSDamageQueue>();
+
+	for (int32 i = Effects.Num() - 1; i >= 0; i--) {
+		FDamageOverTimeEffect& Effect = Effects[i];
+		AActor* Target = Effect.Target.Get();
+		if (!IsValid(Target)) {
+			Effects.RemoveAtSwap(i, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		// The last step only covers what is left, so the total is exactly DamagePerSecond * duration
+		const float Step = FMath::Min(DeltaSeconds, Effect.Remaining);
+		if (DamageQueue) {
+			DamageQueue->QueueDamage(Target, Effect.DamagePerSecond * Step);
+		}
+
+		Effect.Remaining -= Step;
+		if (Effect.Remaining <= 0.0f) {
+			Effects.RemoveAtSwap(i, 1, EAllowShrinking::No);
+		}
+	}
+	SET_DWORD_STAT(STAT_DamageOverTimeEffects, Effects.Num());
+}
+
+void UFPSDamageOverTime::HandleUpdateTimer() {
+	UpdateEffects(UpdateInterval);
+
+	// Nothing is scheduled while no one is affected
+	if (Effects.Num() == 0) {
+		GetWorld()->GetTimerManager().ClearTimer(UpdateTimerHandle);
+	}
+}
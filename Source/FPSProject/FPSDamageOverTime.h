@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FPSDamageOverTime.generated.h"
+
+struct FDamageOverTimeEffect {
+	TWeakObjectPtr<AActor> Target;
+	TWeakObjectPtr<const UObject> Source;
+	float DamagePerSecond = 0.0f;
+	float Remaining = 0.0f;
+};
+
+/**
+ * Every damage-over-time effect in the world in one flat array, updated at a fixed rate by a looping timer that only
+ * runs while an effect is active. Damage goes through UFPSDamageQueue.
+ */
+UCLASS()
+class FPSPROJECT_API UFPSDamageOverTime : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Starts an effect, or restarts it if Source already has one running on Target
+	void ApplyEffect(AActor* Target, const UObject* Source, float DamagePerSecond, float Duration);
+
+	void RemoveEffects(const UObject* Source);
+	void RemoveAllEffects();
+
+	// Advances every effect by DeltaSeconds and queues the damage dealt. The timer calls this once per UpdateInterval.
+	void UpdateEffects(float DeltaSeconds);
+
+	int32 GetNumEffects() const { return Effects.Num(); }
+	bool IsUpdating() const { return UpdateTimerHandle.IsValid(); }
+
+	// Seconds between updates, damage for the whole interval is dealt at once
+	float UpdateInterval = 0.1f;
+
+protected:
+	void HandleUpdateTimer();
+
+	TArray<FDamageOverTimeEffect> Effects;
+	FTimerHandle UpdateTimerHandle;
+};
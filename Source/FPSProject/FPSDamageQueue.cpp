@@ -0,0 +1,126 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FPSDamageQueue.h"
+#include "FPSProject.h"
+#include "FPSEnemyBase.h"
+#include "FPSCharacter.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+
+DECLARE_CYCLE_STAT(TEXT("Damage Queue Flush"), STAT_DamageQueueFlush, STATGROUP_FPSProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Damage Records"), STAT_DamageRecords, STATGROUP_FPSProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Damage Targets"), STAT_DamageTargets, STATGROUP_FPSProject);
+
+void FDamageQueueTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) {
+	if (Queue) {
+		Queue->Flush();
+	}
+}
+
+void UFPSDamageQueue::Deinitialize() {
+	if (FlushTickFunction.IsTickFunctionRegistered()) {
+		FlushTickFunction.UnRegisterTickFunction();
+	}
+	FlushTickFunction.Queue = nullptr;
+
+	Pending.Empty();
+	Processing.Empty();
+	Totals.Empty();
+	Super::Deinitialize();
+}
+
+void UFPSDamageQueue::OnWorldBeginPlay(UWorld& InWorld) {
+	Super::OnWorldBeginPlay(InWorld);
+
+	// After physics, so everything the frame's hit and overlap callbacks queued is applied the same frame
+	FlushTickFunction.Queue = this;
+	FlushTickFunction.TickGroup = TG_PostPhysics;
+	FlushTickFunction.bCanEverTick = true;
+	FlushTickFunction.bStartWithTickEnabled = true;
+	FlushTickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UFPSDamageQueue::QueueDamage(AActor* Target, float Amount, const FVector& LaunchVelocity) {
+	if (!Target) return;
+
+	FQueuedDamage& Record = Pending.AddDefaulted_GetRef();
+	Record.Target = Target;
+	Record.Amount = Amount;
+	Record.LaunchVelocity = LaunchVelocity;
+}
+
+void UFPSDamageQueue::QueueImpact(AActor* Target, const FVector& ImpactLocation, float Amount, float KnockbackStrength, const AActor* Instigator) {
+	if (!Target || Target == Instigator || !Target->IsA(AFPSEnemyBase::StaticClass())) return;
+
+	FVector KnockbackDirection = Target->GetActorLocation() - ImpactLocation;
+	KnockbackDirection.Normalize();
+	QueueDamage(Target, Amount, KnockbackDirection * KnockbackStrength);
+}
+
+void UFPSDamageQueue::Flush() {
+	if (Pending.Num() == 0) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_DamageQueueFlush);
+
+	// Anything queued by deaths below goes to the next pass
+	Swap(Pending, Processing);
+	SET_DWORD_STAT(STAT_DamageRecords, Processing.Num());
+
+	Totals.Reset();
+	for (const FQueuedDamage& Record : Processing) {
+		AActor* Target = Record.Target.Get();
+		if (!IsValid(Target)) continue;
+
+		FDamageTotal& Total = Totals.FindOrAdd(Target);
+		Total.Amount += Record.Amount;
+		// The whole vector is kept, so a single hit launches exactly as it did when applied inline
+		if (Record.LaunchVelocity.SizeSquared() > Total.Launch.SizeSquared()) {
+			Total.Launch = Record.LaunchVelocity;
+		}
+	}
+	Processing.Reset();
+	SET_DWORD_STAT(STAT_DamageTargets, Totals.Num());
+
+	TArray<AFPSEnemyBase*, TInlineAllocator<16>> Killed;
+	for (const TPair<AActor*, FDamageTotal>& Pair : Totals) {
+		AActor* Target = Pair.Key;
+		const FDamageTotal& Total = Pair.Value;
+
+		if (AFPSEnemyBase* Enemy = Cast<AFPSEnemyBase>(Target)) {
+			if (Enemy->IsInPool()) continue;
+			if (Total.Amount > 0.0f && Enemy->TakeHit(Total.Amount)) {
+				Killed.Add(Enemy);
+				continue;
+			}
+		}
+		else if (AFPSCharacter* Player = Cast<AFPSCharacter>(Target)) {
+			if (Total.Amount > 0.0f) {
+				Player->ApplyDamage(Total.Amount);
+			}
+			if (Player->bIsDead) continue;
+		}
+
+		// One launch per target, the strongest one queued
+		if (Total.Launch.IsZero()) continue;
+
+		if (AFPSEnemyBase* Enemy = Cast<AFPSEnemyBase>(Target)) {
+			Enemy->ApplyKnockback(Total.Launch.GetSafeNormal(), Total.Launch.Size());
+		}
+		else if (ACharacter* Character = Cast<ACharacter>(Target)) {
+			Character->LaunchCharacter(Total.Launch, true, true);
+		}
+	}
+
+	for (AFPSEnemyBase* Enemy : Killed) {
+		if (IsValid(Enemy)) {
+			Enemy->OnDeath();
+		}
+	}
+}
+
+void UFPSDamageQueue::Reset() {
+	Pending.Reset();
+	Processing.Reset();
+	Totals.Reset();
+}
@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "FPSDamageQueue.generated.h"
+
+class UFPSDamageQueue;
+
+struct FQueuedDamage {
+	TWeakObjectPtr<AActor> Target;
+	FVector LaunchVelocity = FVector::ZeroVector;
+	float Amount = 0.0f;
+};
+
+struct FDamageQueueTickFunction : public FTickFunction {
+	UFPSDamageQueue* Queue = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override { return TEXT("UFPSDamageQueue::Flush"); }
+};
+
+/**
+ * Collects damage from hit and overlap callbacks and applies it in one post-physics pass. Records are summed per
+ * target, each target is launched at most once with the strongest launch queued for it, and enemy deaths are
+ * resolved together after all damage landed, so nothing re-enters gameplay code from inside a physics callback.
+ */
+UCLASS()
+class FPSPROJECT_API UFPSDamageQueue : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	// LaunchVelocity is what the callback would have passed to LaunchCharacter, zero for no knockback
+	void QueueDamage(AActor* Target, float Amount, const FVector& LaunchVelocity = FVector::ZeroVector);
+
+	// Queues a bullet impact for every hit path: only enemies other than Instigator take Amount, and they are knocked
+	// away from ImpactLocation, where the bullet stood when it hit
+	void QueueImpact(AActor* Target, const FVector& ImpactLocation, float Amount, float KnockbackStrength, const AActor* Instigator);
+
+	// Applies everything queued so far. Runs in TG_PostPhysics, tests call it directly.
+	void Flush();
+
+	// Drops everything queued so far without applying it
+	void Reset();
+
+	// Knockback of a bullet impact, shared by projectiles, the projectile manager and hitscan
+	static constexpr float ImpactKnockbackStrength = 800.0f;
+
+	int32 GetNumPending() const { return Pending.Num(); }
+
+protected:
+	struct FDamageTotal {
+		float Amount = 0.0f;
+		FVector Launch = FVector::ZeroVector;
+	};
+
+	TArray<FQueuedDamage> Pending;
+	TArray<FQueuedDamage> Processing;
+	TMap<AActor*, FDamageTotal> Totals;
+
+	FDamageQueueTickFunction FlushTickFunction;
+};
@@ -5,17 +5,23 @@
 #include "FPSCharacter.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/SkeletalMeshComponent.h"
-#include "Materials/MaterialInstanceDynamic.h"
-#include "TimerManager.h"
-#include "Engine/Engine.h"
+#include "FPSHitFlashManager.h"
+#include "FPSDamageQueue.h"
 #include "EngineUtils.h"
 #include "FPSEnemyPatrol.h"
 #include "FPSEnemyDumb.h"
 #include "FPSEnemySpawnManager.h"
+#include "FPSEnemyPool.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "AIController.h"
+#include "BrainComponent.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
 #include <Kismet/GameplayStatics.h>
 
 // Sets default values
-AFPSEnemyBase::AFPSEnemyBase()
+AFPSEnemyBase::AFPSEnemyBase(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
 {
  	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
@@ -29,31 +35,45 @@ void AFPSEnemyBase::BeginPlay()
 	CurrentHealth = MaxHealth;
 
 	if (GetMesh()) {
+		DefaultAnimTickOption = GetMesh()->VisibilityBasedAnimTickOption;
+
 		UMaterialInterface* BaseMaterial = GetMesh()->GetMaterial(0);
-		if (BaseMaterial) {
+		if (BaseMaterial && !bFlashThroughCustomData) {
 			DynamicMaterialInstance = UMaterialInstanceDynamic::Create(BaseMaterial, this);
 			GetMesh()->SetMaterial(0, DynamicMaterialInstance);
 		}
 	}
 	
 	GetCapsuleComponent()->OnComponentBeginOverlap.AddDynamic(this, &AFPSEnemyBase::OnOverlapBegin);
+
+	if (UFPSEnemySignificance* SignificanceSubsystem = GetWorld()->GetSubsystem<UFPSEnemySignificance>()) {
+		SignificanceSubsystem->RegisterEnemy(this);
+	}
 }
 
-// Called every frame
-void AFPSEnemyBase::Tick(float DeltaTime)
+void AFPSEnemyBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
+	if (UFPSEnemySignificance* SignificanceSubsystem = GetWorld()->GetSubsystem<UFPSEnemySignificance>()) {
+		SignificanceSubsystem->UnregisterEnemy(this);
+	}
 
+	Super::EndPlay(EndPlayReason);
 }
 
 void AFPSEnemyBase::ReceiveDamage(float Amount) {
+	if (TakeHit(Amount))
+		OnDeath();
+}
+
+bool AFPSEnemyBase::TakeHit(float Amount) {
+	if (bInPool) return false;
+
 	CurrentHealth -= Amount;
 
 	if (bFlashOnHit)
 		StartHitFlash();
 
-	if (CurrentHealth <= 0.f)
-		OnDeath();
+	return CurrentHealth <= 0.f;
 }
 
 void AFPSEnemyBase::OnDeath() {
@@ -71,48 +91,151 @@ void AFPSEnemyBase::OnDeath() {
 		Player->OnEnemyKilled();
 	}
 
+	ReturnToPoolOrDestroy();
+}
+
+void AFPSEnemyBase::Recycle() {
+	if (bInPool) return;
+
+	if (OwningSpawner) {
+		OwningSpawner->NotifyEnemyRecycled(this);
+	}
+	ReturnToPoolOrDestroy();
+}
+
+void AFPSEnemyBase::ReturnToPoolOrDestroy() {
+	if (bIsPooled) {
+		if (UFPSEnemyPool* Pool = GetWorld()->GetSubsystem<UFPSEnemyPool>()) {
+			Pool->Release(this);
+			return;
+		}
+	}
+
+	if (bIsLevelPlaced) {
+		DeactivateToPool();
+		return;
+	}
 
 	Destroy();
 }
 
-void AFPSEnemyBase::ApplyKnockback(const FVector& Direction, float Strenght) {
-	LaunchCharacter(Direction * Strenght, true, true);
+void AFPSEnemyBase::ActivateFromPool(const FVector& Location, const FRotator& Rotation) {
+	bInPool = false;
+
+	if (!TeleportTo(Location, Rotation)) {
+		SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::ResetPhysics);
+	}
+
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+	GetCharacterMovement()->SetComponentTickEnabled(true);
+	GetCharacterMovement()->SetDefaultMovementMode();
+	if (GetMesh()) {
+		GetMesh()->SetComponentTickEnabled(true);
+	}
+
+	ResetEnemyState();
+
+	// The next significance pass picks the real bucket, until then behave like a fresh spawn
+	ApplyTickLOD(EEnemySignificance::Critical, FEnemyTickLOD());
+
+	if (!GetController()) {
+		SpawnDefaultController();
+	}
+	if (AAIController* AI = Cast<AAIController>(GetController())) {
+		if (AI->GetBrainComponent()) {
+			AI->GetBrainComponent()->RestartLogic();
+		}
+	}
+}
+
+void AFPSEnemyBase::DeactivateToPool() {
+	bInPool = true;
+	OwningSpawner = nullptr;
+
+	if (AAIController* AI = Cast<AAIController>(GetController())) {
+		AI->StopMovement();
+		if (AI->GetBrainComponent()) {
+			AI->GetBrainComponent()->StopLogic(TEXT("Returned to pool"));
+		}
+	}
+
+	EndHitFlash();
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->SetComponentTickEnabled(false);
+	if (GetMesh()) {
+		GetMesh()->SetComponentTickEnabled(false);
+	}
+
+	SetActorTickEnabled(false);
+	SetActorEnableCollision(false);
+	SetActorHiddenInGame(true);
 }
 
-void AFPSEnemyBase::StartHitFlash() {
-	if (DynamicMaterialInstance) {
-		FLinearColor CurrentColor;
-		FMaterialParameterInfo ParamInfo("BaseColor");
+void AFPSEnemyBase::ApplyTickLOD(EEnemySignificance NewSignificance, const FEnemyTickLOD& LOD) {
+	Significance = NewSignificance;
 
-		FString MatName = DynamicMaterialInstance->GetName();
+	SetActorTickInterval(LOD.ActorTickInterval);
+	GetCharacterMovement()->SetComponentTickInterval(LOD.MovementTickInterval);
+	if (GetMesh()) {
+		GetMesh()->SetComponentTickInterval(LOD.MeshTickInterval);
+		GetMesh()->VisibilityBasedAnimTickOption = LOD.bTickPoseWhenOffscreen
+			? DefaultAnimTickOption
+			: EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+	}
+}
 
-		GEngine->AddOnScreenDebugMessage(-1, 4.0f, FColor::Yellow, FString::Printf(TEXT("Dynamic Material Instance: %s"), *MatName));
+void AFPSEnemyBase::ResetEnemyState() {
+	CurrentHealth = MaxHealth;
+	EndHitFlash();
+
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->ClearAccumulatedForces();
+	ConsumeMovementInputVector();
+
+	if (AAIController* AI = Cast<AAIController>(GetController())) {
+		if (UBlackboardComponent* Blackboard = AI->GetBlackboardComponent()) {
+			// Gameplay keys only, services and tasks still read the pawn from SelfActor after the pool round trip
+			const FBlackboard::FKey SelfKey = Blackboard->GetKeyID(FBlackboard::KeySelf);
+			for (FBlackboard::FKey Key = 0; Key < Blackboard->GetNumKeys(); Key++) {
+				if (Key != SelfKey) {
+					Blackboard->ClearValue(Key);
+				}
+			}
+			if (SelfKey != FBlackboard::InvalidKey) {
+				Blackboard->SetValue<UBlackboardKeyType_Object>(SelfKey, this);
+			}
+		}
+	}
+}
 
-		DynamicMaterialInstance->SetVectorParameterValue("BaseColor", FLinearColor::Red);
-		GEngine->AddOnScreenDebugMessage(-1, 4.0f, FColor::Red, TEXT("SetVectorParameterValue called"));
-		DynamicMaterialInstance->GetVectorParameterValue(ParamInfo, CurrentColor);
-		GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Cyan, FString::Printf(TEXT("Current BaseColor: %s"), *CurrentColor.ToString()));
+void AFPSEnemyBase::ApplyKnockback(const FVector& Direction, float Strength) {
+	LaunchCharacter(Direction * Strength, true, true);
+}
 
-		GetWorld()->GetTimerManager().SetTimer(FlashTimerHandle, this, &AFPSEnemyBase::EndHitFlash, 0.2f, false);
+void AFPSEnemyBase::StartHitFlash() {
+	if (UFPSHitFlashManager* HitFlash = GetWorld()->GetSubsystem<UFPSHitFlashManager>()) {
+		HitFlash->StartFlash(GetMesh(), bFlashThroughCustomData ? nullptr : DynamicMaterialInstance);
 	}
 }
 
 void AFPSEnemyBase::EndHitFlash() {
-	if (DynamicMaterialInstance) {
-		DynamicMaterialInstance->SetVectorParameterValue("BaseColor", FLinearColor::White);
+	if (UFPSHitFlashManager* HitFlash = GetWorld()->GetSubsystem<UFPSHitFlashManager>()) {
+		HitFlash->StopFlash(GetMesh());
 	}
 }
 
 void AFPSEnemyBase::OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult) {
 	AFPSCharacter* Player = Cast<AFPSCharacter>(OtherActor);
 	if (Player) {
-		Player->ApplyDamage(ContactDamage);
-
 		FVector KnockbackDirection = Player->GetActorLocation() - GetActorLocation();
 		KnockbackDirection.Z = 0;
 		KnockbackDirection.Normalize();
 
 		float KnockbackStrength = 800.f;
-		Player->LaunchCharacter(KnockbackDirection * KnockbackStrength + FVector(0, 0, 300.f), true, true);
+		if (UFPSDamageQueue* DamageQueue = GetWorld()->GetSubsystem<UFPSDamageQueue>()) {
+			DamageQueue->QueueDamage(Player, ContactDamage, KnockbackDirection * KnockbackStrength + FVector(0, 0, 300.f));
+		}
 	}
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "GameFramework/Character.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Materials/MaterialInstanceDynamic.h"
+#include "FPSEnemySignificance.h"
 #include "FPSEnemyBase.generated.h"
 
 UCLASS()
@@ -15,13 +16,11 @@ class FPSPROJECT_API AFPSEnemyBase : public ACharacter
 
 public:
 	// Sets default values for this character's properties
-	AFPSEnemyBase();
+	AFPSEnemyBase(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:	
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
-
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Enemy")
 	float MaxHealth = 40.0f;
 
@@ -35,18 +34,25 @@ public:
 	//UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Enemy")
 	//float KnockbackStrength = 800.f;
 
+	// The flash is driven by UFPSHitFlashManager
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy")
 	bool bFlashOnHit = true;
 
-	UPROPERTY()
-	UMaterialInstanceDynamic* DynamicMaterialInstance;
+	// The material reads the flash from PerInstanceCustomData[0]. Turn off for materials that do not, and the flash
+	// tints the BaseColor parameter of a dynamic material instance instead.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy")
+	bool bFlashThroughCustomData = true;
 
-	FTimerHandle FlashTimerHandle;
+	UPROPERTY()
+	UMaterialInstanceDynamic* DynamicMaterialInstance = nullptr;
 
 	//POT TODO KNOCKBACK
 	UFUNCTION(BlueprintCallable, Category = "Enemy")
 	virtual void ReceiveDamage(float Amount);
 
+	// Health and hit flash only. Returns true when the hit was lethal, the caller then resolves the death.
+	bool TakeHit(float Amount);
+
 	UFUNCTION(BlueprintCallable, Category = "Enemy")
 	virtual void OnDeath();
 
@@ -57,8 +63,37 @@ public:
 
 	class AFPSEnemySpawnManager* OwningSpawner = nullptr;
 
+	// Pool hooks, see UFPSEnemyPool
+	void ActivateFromPool(const FVector& Location, const FRotator& Rotation);
+	void DeactivateToPool();
+	void MarkPooled() { bIsPooled = true; }
+	// Level placed enemies are parked like pooled ones when they die, so UFPSWorldReset can bring them back as placed
+	void MarkLevelPlaced() { bIsLevelPlaced = true; }
+
+	bool IsPooled() const { return bIsPooled; }
+	bool IsInPool() const { return bInPool; }
+
+	// Tick rates for the bucket UFPSEnemySignificance put this enemy in
+	void ApplyTickLOD(EEnemySignificance NewSignificance, const FEnemyTickLOD& LOD);
+	EEnemySignificance GetSignificance() const { return Significance; }
+
+	// Removes the enemy without counting a kill, used by UFPSPopulationDirector for enemies nobody is near
+	void Recycle();
+
 protected:
+	void ReturnToPoolOrDestroy();
+
 	void StartHitFlash();
 	void EndHitFlash();
 
+	// Puts health, hit flash, movement and AI back to how a freshly spawned enemy starts
+	virtual void ResetEnemyState();
+
+private:
+	EEnemySignificance Significance = EEnemySignificance::Critical;
+	EVisibilityBasedAnimTickOption DefaultAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPose;
+
+	bool bIsPooled = false;
+	bool bIsLevelPlaced = false;
+	bool bInPool = false;
 };
@@ -2,47 +2,49 @@
 
 
 #include "FPSEnemyDumb.h"
-#include "Kismet/GameplayStatics.h"
 #include "Components/SkeletalMeshComponent.h"
-#include "FPSCharacter.h"
 #include "Engine/World.h"
-#include "EngineUtils.h"
+#include "FPSSwarmSubsystem.h"
+#include "FPSCrowdSeparation.h"
+#include "FPSEnemyMovementComponent.h"
 
-AFPSEnemyDumb::AFPSEnemyDumb() {
+AFPSEnemyDumb::AFPSEnemyDumb(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer) {
 	PrimaryActorTick.bCanEverTick = true;
 }
 
+AFPSEnemyDumbLite::AFPSEnemyDumbLite(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UFPSEnemyMovementComponent>(ACharacter::CharacterMovementComponentName)) {
+}
+
 void AFPSEnemyDumb::BeginPlay() {
 	Super::BeginPlay();
+
+	if (UFPSCrowdSeparation* Crowd = GetWorld()->GetSubsystem<UFPSCrowdSeparation>()) {
+		Crowd->RegisterAgent(this);
+	}
+}
+
+void AFPSEnemyDumb::EndPlay(const EEndPlayReason::Type EndPlayReason) {
+	if (UFPSCrowdSeparation* Crowd = GetWorld()->GetSubsystem<UFPSCrowdSeparation>()) {
+		Crowd->UnregisterAgent(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AFPSEnemyDumb::Tick(float DeltaTime) {
 	Super::Tick(DeltaTime);
 
-	FVector PlayerLoc = GetPlayerLocation();
-	FVector Direction = (PlayerLoc - GetActorLocation()).GetSafeNormal();
-	float Speed = 400.0f;
-
-	AddMovementInput(Direction, 1.0f);
+	AddMovementInput(ChaseDirection, 1.0f);
 }
 
-FVector AFPSEnemyDumb::GetPlayerLocation() const {
-	APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
-	if (PlayerPawn && PlayerPawn->GetController()) {
-		AFPSCharacter* FPSChar = Cast<AFPSCharacter>(PlayerPawn);
-		if (FPSChar && !FPSChar->bIsDead && FPSChar->GetCurrentHealth() > 0) {
-			return PlayerPawn->GetActorLocation();
-		}
-	}
-
-	for (TActorIterator<AFPSCharacter> ActorIterator(GetWorld()); ActorIterator; ++ActorIterator) {
-		AFPSCharacter* FPSCharacter = *ActorIterator;
-		if (FPSCharacter && IsValid(FPSCharacter) && !FPSCharacter->bIsDead && FPSCharacter->GetCurrentHealth() > 0) {
-			if (FPSCharacter->GetController()) {
-				return FPSCharacter->GetActorLocation();
-			}
+void AFPSEnemyDumb::OnDeath() {
+	if (SwarmAgentIndex != INDEX_NONE) {
+		if (UFPSSwarmSubsystem* Swarm = GetWorld()->GetSubsystem<UFPSSwarmSubsystem>()) {
+			Swarm->NotifyMaterializedDeath(this);
 		}
 	}
 
-	return FVector::ZeroVector;
-}
\ No newline at end of file
+	Super::OnDeath();
+}
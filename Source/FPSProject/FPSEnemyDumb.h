@@ -15,12 +15,38 @@ class FPSPROJECT_API AFPSEnemyDumb : public AFPSEnemyBase
 	GENERATED_BODY()
 
 public: 
-	AFPSEnemyDumb();
+	AFPSEnemyDumb(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	virtual void OnDeath() override;
+
+	// Set while this actor represents a UFPSSwarmSubsystem agent
+	int32 SwarmAgentIndex = INDEX_NONE;
+
+	// Written by UFPSCrowdSeparation before actors tick, blended into the chase direction
+	FVector SeparationSteering = FVector::ZeroVector;
+
+	// Thought through by UFPSCrowdSeparation's parallel pass before actors tick, Tick only applies it
+	FVector ChaseDirection = FVector::ZeroVector;
+
+	// World time at which the crowd thinks for this enemy again, spaced by its actor tick interval
+	double NextChaseThinkTime = 0.0;
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaTime) override;
 
-	FVector GetPlayerLocation() const;
-	
+};
+
+/**
+ * Dumb enemy on UFPSEnemyMovementComponent instead of the full character movement. Reparent a dumb enemy blueprint
+ * to this class to switch it over.
+ */
+UCLASS()
+class FPSPROJECT_API AFPSEnemyDumbLite : public AFPSEnemyDumb
+{
+	GENERATED_BODY()
+
+public:
+	AFPSEnemyDumbLite(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 };
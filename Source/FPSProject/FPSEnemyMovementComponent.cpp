@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FPSEnemyMovementComponent.h"
+#include "FPSProject.h"
+#include "GameFramework/Character.h"
+#include "Components/CapsuleComponent.h"
+#include "NavigationSystem.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemy Ballistic Steps"), STAT_EnemyBallisticSteps, STATGROUP_FPSProject);
+
+UFPSEnemyMovementComponent::UFPSEnemyMovementComponent() {
+	DefaultLandMovementMode = MOVE_NavWalking;
+	bSweepWhileNavWalking = true;
+
+	// Re-project on a timer instead of every step, the navmesh under a chasing enemy barely changes
+	bProjectNavMeshWalking = true;
+	NavMeshProjectionInterval = 0.1f;
+	NavMeshProjectionInterpSpeed = 12.0f;
+
+	// Nothing in the chase needs these
+	bEnablePhysicsInteraction = false;
+	bUseRVOAvoidance = false;
+	bAlwaysCheckFloor = false;
+	MaxSimulationIterations = 1;
+}
+
+void UFPSEnemyMovementComponent::PhysFalling(float deltaTime, int32 Iterations) {
+	if (!bBallisticKnockback) {
+		Super::PhysFalling(deltaTime, Iterations);
+		return;
+	}
+	if (deltaTime < MIN_TICK_TIME || !UpdatedComponent) return;
+
+	INC_DWORD_STAT(STAT_EnemyBallisticSteps);
+
+	// No air control or substeps, the enemy follows the arc it was launched on
+	const FVector OldVelocity = Velocity;
+	Velocity.Z += GetGravityZ() * deltaTime;
+	const FVector Delta = 0.5f * (OldVelocity + Velocity) * deltaTime;
+
+	FHitResult Hit(1.0f);
+	SafeMoveUpdatedComponent(Delta, UpdatedComponent->GetComponentQuat(), true, Hit);
+
+	if (Hit.bBlockingHit) {
+		if (Velocity.Z <= 0.0f && IsWalkable(Hit)) {
+			LandOnNavMesh();
+			return;
+		}
+
+		// Walls and other capsules just take away the part of the arc going into them
+		Velocity = FVector::VectorPlaneProject(Velocity, Hit.Normal);
+		return;
+	}
+
+	if (Velocity.Z > 0.0f) return;
+
+	// Nav walking capsules hover over the navmesh rather than resting on collision, so landing is checked there too
+	FNavLocation NavFloor;
+	if (FindNavFloor(UpdatedComponent->GetComponentLocation(), NavFloor)) {
+		const float FeetZ = UpdatedComponent->GetComponentLocation().Z - CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+		if (FeetZ <= NavFloor.Location.Z + LandingTolerance) {
+			LandOnNavMesh();
+		}
+	}
+}
+
+void UFPSEnemyMovementComponent::LandOnNavMesh() {
+	Velocity.Z = 0.0f;
+	SetDefaultMovementMode();
+}
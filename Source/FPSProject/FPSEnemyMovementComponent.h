@@ -0,0 +1,35 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "FPSEnemyMovementComponent.generated.h"
+
+/**
+ * Cheap movement for enemies that only chase across flat navmesh. Ground movement is nav walking: the capsule is
+ * snapped to a cached navmesh projection instead of finding the floor, with at most one sweep against walls and
+ * other capsules (bSweepWhileNavWalking). Knockback is a plain ballistic arc, one sweep per step, that lands back
+ * on the navmesh. Where there is no navmesh it falls back to regular walking.
+ */
+UCLASS()
+class FPSPROJECT_API UFPSEnemyMovementComponent : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+public:
+	UFPSEnemyMovementComponent();
+
+	// Knockback follows the simple arc with one sweep per step. Turned off, the engine's falling physics is used.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy Movement")
+	bool bBallisticKnockback = true;
+
+	// Distance above the navmesh at which a falling enemy counts as landed
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy Movement")
+	float LandingTolerance = 10.0f;
+
+protected:
+	virtual void PhysFalling(float deltaTime, int32 Iterations) override;
+
+	void LandOnNavMesh();
+};
@@ -3,7 +3,26 @@
 
 #include "FPSEnemyPatrol.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "FPSEnemyPerception.h"
 
 AFPSEnemyPatrol::AFPSEnemyPatrol()
 {
 }
+
+void AFPSEnemyPatrol::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UFPSEnemyPerception* Perception = GetWorld()->GetSubsystem<UFPSEnemyPerception>()) {
+		Perception->RegisterEnemy(this);
+	}
+}
+
+void AFPSEnemyPatrol::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UFPSEnemyPerception* Perception = GetWorld()->GetSubsystem<UFPSEnemyPerception>()) {
+		Perception->UnregisterEnemy(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
@@ -8,7 +8,7 @@
 #include "FPSEnemyPatrol.generated.h"
 
 /**
- * 
+ * Smart enemy driven by BT_Enemy. Sees and hears the player through UFPSEnemyPerception.
  */
 UCLASS()
 class FPSPROJECT_API AFPSEnemyPatrol : public AFPSEnemyBase
@@ -17,4 +17,6 @@ class FPSPROJECT_API AFPSEnemyPatrol : public AFPSEnemyBase
 	
 public:
 	AFPSEnemyPatrol();
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 };
@@ -0,0 +1,201 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FPSEnemyPerception.h"
+#include "FPSProject.h"
+#include "FPSEnemyBase.h"
+#include "FPSPlayerTracker.h"
+#include "AIController.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Float.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "Perception/AIPerceptionComponent.h"
+#include "Perception/AISense_Sight.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Perception"), STAT_EnemyPerception, STATGROUP_FPSProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Perception Traces"), STAT_PerceptionTraces, STATGROUP_FPSProject);
+
+void UFPSEnemyPerception::Deinitialize() {
+	Entries.Empty();
+	Cursor = 0;
+	Super::Deinitialize();
+}
+
+TStatId UFPSEnemyPerception::GetStatId() const {
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFPSEnemyPerception, STATGROUP_Tickables);
+}
+
+void UFPSEnemyPerception::Tick(float DeltaTime) {
+	UpdatePerception(DeltaTime);
+}
+
+void UFPSEnemyPerception::RegisterEnemy(AFPSEnemyBase* Enemy) {
+	if (!Enemy || GetPerception(Enemy)) return;
+
+	FEnemyPerception& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Enemy = Enemy;
+}
+
+void UFPSEnemyPerception::UnregisterEnemy(AFPSEnemyBase* Enemy) {
+	const int32 Index = Entries.IndexOfByPredicate([Enemy](const FEnemyPerception& Entry) { return Entry.Enemy.Get() == Enemy; });
+	if (Index == INDEX_NONE) return;
+
+	// A trace still in flight is simply never queried
+	Entries.RemoveAtSwap(Index);
+	if (Cursor >= Entries.Num()) {
+		Cursor = 0;
+	}
+}
+
+const FEnemyPerception* UFPSEnemyPerception::GetPerception(const AFPSEnemyBase* Enemy) const {
+	return Entries.FindByPredicate([Enemy](const FEnemyPerception& Entry) { return Entry.Enemy.Get() == Enemy; });
+}
+
+void UFPSEnemyPerception::UpdatePerception(float DeltaTime) {
+	Clock += DeltaTime;
+	NumTracesLastUpdate = 0;
+	if (Entries.Num() == 0) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_EnemyPerception);
+
+	ResolveTraces();
+
+	UFPSPlayerTracker* Tracker = GetWorld()->GetSubsystem<UFPSPlayerTracker>();
+	if (!Tracker) return;
+
+	// Enemies settled without a trace cost a distance and a dot product, so the slice ends on the trace budget
+	const int32 Num = Entries.Num();
+	const int32 Budget = FMath::Max(1, TraceBudget);
+	int32 Visited = 0;
+	for (; Visited < Num && NumTracesLastUpdate < Budget; Visited++) {
+		FEnemyPerception& Entry = Entries[(Cursor + Visited) % Num];
+		if (Entry.bTraceInFlight) continue;
+
+		const AFPSEnemyBase* Enemy = Entry.Enemy.Get();
+		const FTrackedPlayer* Player = IsValid(Enemy) && !Enemy->IsInPool() ? Tracker->FindNearestPlayer(Enemy->GetActorLocation()) : nullptr;
+		if (!Player) {
+			Entry.Player = nullptr;
+			Entry.Distance = TNumericLimits<float>::Max();
+			Entry.bCanHear = false;
+			Entry.LastSeenSeconds = -1.0;
+			ApplySight(Entry, false);
+			continue;
+		}
+
+		Entry.Player = Player->Actor;
+		if (Evaluate(Entry, Player->Location)) {
+			NumTracesLastUpdate++;
+		}
+	}
+	Cursor = (Cursor + Visited) % Num;
+
+	INC_DWORD_STAT_BY(STAT_PerceptionTraces, NumTracesLastUpdate);
+}
+
+void UFPSEnemyPerception::ResolveTraces() {
+	UWorld* World = GetWorld();
+	for (FEnemyPerception& Entry : Entries) {
+		if (!Entry.bTraceInFlight) continue;
+		Entry.bTraceInFlight = false;
+
+		// Not available any more, e.g. the world skipped a tick, the enemy is traced again on its next turn
+		FTraceDatum Datum;
+		if (!World->QueryTraceData(Entry.Trace, Datum)) continue;
+
+		const bool bBlocked = Datum.OutHits.ContainsByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+		ApplySight(Entry, !bBlocked);
+	}
+}
+
+bool UFPSEnemyPerception::Evaluate(FEnemyPerception& Entry, const FVector& PlayerLocation) {
+	const AFPSEnemyBase* Enemy = Entry.Enemy.Get();
+	const FVector EyeLocation = Enemy->GetPawnViewLocation();
+	const FVector ToPlayer = PlayerLocation - EyeLocation;
+
+	Entry.Distance = ToPlayer.Size();
+	Entry.bCanHear = Entry.Distance <= HearingRadius;
+
+	const bool bInCone = FVector::DotProduct(Enemy->GetActorForwardVector(), ToPlayer.GetSafeNormal()) >= SightConeCos;
+	if (Entry.Distance > SightRadius || !bInCone) {
+		ApplySight(Entry, false);
+		return false;
+	}
+
+	IssueTrace(Entry, EyeLocation, PlayerLocation);
+	return true;
+}
+
+void UFPSEnemyPerception::IssueTrace(FEnemyPerception& Entry, const FVector& EyeLocation, const FVector& PlayerLocation) {
+	UWorld* World = GetWorld();
+
+	// Anything blocking between the eyes and the player hides them, the player itself is ignored
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(EnemySightTrace), false, Entry.Enemy.Get());
+	Params.AddIgnoredActor(Entry.Player.Get());
+
+	if (bAsyncTraces) {
+		Entry.Trace = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, EyeLocation, PlayerLocation, ECC_Visibility, Params);
+		Entry.bTraceInFlight = true;
+		return;
+	}
+
+	const bool bBlocked = World->LineTraceTestByChannel(EyeLocation, PlayerLocation, ECC_Visibility, Params);
+	ApplySight(Entry, !bBlocked);
+}
+
+void UFPSEnemyPerception::ApplySight(FEnemyPerception& Entry, bool bVisible) {
+	Entry.bCanSee = bVisible;
+	if (bVisible) {
+		Entry.LastSeenSeconds = Clock;
+	}
+
+	// Like the old controller's line of sight timer, a player ducking behind cover is not forgotten at once
+	Entry.bHasLineOfSight = bVisible || (Entry.LastSeenSeconds >= 0.0 && Clock - Entry.LastSeenSeconds <= LoseSightDelay);
+	Publish(Entry);
+}
+
+void UFPSEnemyPerception::Publish(FEnemyPerception& Entry) {
+	const AFPSEnemyBase* Enemy = Entry.Enemy.Get();
+	AAIController* AI = Enemy ? Cast<AAIController>(Enemy->GetController()) : nullptr;
+	UBlackboardComponent* Blackboard = AI ? AI->GetBlackboardComponent() : nullptr;
+	if (!Blackboard) return;
+
+	if (Entry.Blackboard.Get() != Blackboard) {
+		ResolveKeys(Entry, Blackboard);
+
+		// This subsystem does the seeing now, the controller's own sight sense would only repeat the work
+		if (UAIPerceptionComponent* Perception = AI->FindComponentByClass<UAIPerceptionComponent>()) {
+			Perception->SetSenseEnabled(UAISense_Sight::StaticClass(), false);
+		}
+	}
+
+	// Values are compared with what the blackboard holds, so a blackboard cleared by a pool round trip is filled again
+	AActor* Target = (Entry.bHasLineOfSight || Entry.bCanHear) ? Entry.Player.Get() : nullptr;
+	if (Entry.TargetKey != FBlackboard::InvalidKey && Blackboard->GetValue<UBlackboardKeyType_Object>(Entry.TargetKey) != Target) {
+		// A player neither seen nor heard is let go, so the tree falls back to patrolling
+		if (Target) {
+			Blackboard->SetValue<UBlackboardKeyType_Object>(Entry.TargetKey, Target);
+		}
+		else {
+			Blackboard->ClearValue(Entry.TargetKey);
+		}
+	}
+	if (Entry.SightKey != FBlackboard::InvalidKey && Blackboard->GetValue<UBlackboardKeyType_Bool>(Entry.SightKey) != Entry.bHasLineOfSight) {
+		Blackboard->SetValue<UBlackboardKeyType_Bool>(Entry.SightKey, Entry.bHasLineOfSight);
+	}
+	if (Entry.HeardKey != FBlackboard::InvalidKey && Blackboard->GetValue<UBlackboardKeyType_Bool>(Entry.HeardKey) != Entry.bCanHear) {
+		Blackboard->SetValue<UBlackboardKeyType_Bool>(Entry.HeardKey, Entry.bCanHear);
+	}
+	if (Entry.DistanceKey != FBlackboard::InvalidKey && Entry.Player.IsValid() && !FMath::IsNearlyEqual(Blackboard->GetValue<UBlackboardKeyType_Float>(Entry.DistanceKey), Entry.Distance, DistanceWriteTolerance)) {
+		Blackboard->SetValue<UBlackboardKeyType_Float>(Entry.DistanceKey, Entry.Distance);
+	}
+}
+
+void UFPSEnemyPerception::ResolveKeys(FEnemyPerception& Entry, UBlackboardComponent* Blackboard) {
+	Entry.Blackboard = Blackboard;
+	Entry.TargetKey = Blackboard->GetKeyID(TargetKeyName);
+	Entry.SightKey = Blackboard->GetKeyID(SightKeyName);
+	Entry.HeardKey = Blackboard->GetKeyID(HeardKeyName);
+	Entry.DistanceKey = Blackboard->GetKeyID(DistanceKeyName);
+}
@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "BehaviorTree/BehaviorTreeTypes.h"
+#include "FPSEnemyPerception.generated.h"
+
+class AFPSEnemyBase;
+class UBlackboardComponent;
+
+// What one enemy knows about the nearest player
+struct FEnemyPerception {
+	TWeakObjectPtr<AFPSEnemyBase> Enemy;
+	TWeakObjectPtr<AActor> Player;
+	float Distance = TNumericLimits<float>::Max();
+	bool bCanSee = false;
+	bool bCanHear = false;
+
+	// Sight as written to the blackboard, held for LoseSightDelay after the last successful trace
+	bool bHasLineOfSight = false;
+	double LastSeenSeconds = -1.0;
+
+	FTraceHandle Trace;
+	bool bTraceInFlight = false;
+
+	// Key ids resolved against the blackboard they were looked up in
+	TWeakObjectPtr<UBlackboardComponent> Blackboard;
+	FBlackboard::FKey TargetKey = FBlackboard::InvalidKey;
+	FBlackboard::FKey SightKey = FBlackboard::InvalidKey;
+	FBlackboard::FKey HeardKey = FBlackboard::InvalidKey;
+	FBlackboard::FKey DistanceKey = FBlackboard::InvalidKey;
+};
+
+/**
+ * Sight and hearing against the players for every registered smart enemy, in place of an AIPerception component
+ * per controller. Each frame walks the enemies from where the last frame stopped and issues at most TraceBudget
+ * async line-of-sight traces, which land the next frame. Enemies out of range or facing away are settled without
+ * a trace. Results go to the enemy's blackboard, and only when they change.
+ */
+UCLASS()
+class FPSPROJECT_API UFPSEnemyPerception : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// The sight sense of an AIPerception component on the enemy's controller is switched off on the first publish
+	void RegisterEnemy(AFPSEnemyBase* Enemy);
+	void UnregisterEnemy(AFPSEnemyBase* Enemy);
+
+	// Resolves last frame's traces and runs this frame's slice. Tick calls this, tests call it directly.
+	void UpdatePerception(float DeltaTime);
+
+	const FEnemyPerception* GetPerception(const AFPSEnemyBase* Enemy) const;
+
+	int32 GetNumRegistered() const { return Entries.Num(); }
+	int32 GetNumTracesLastUpdate() const { return NumTracesLastUpdate; }
+
+	float SightRadius = 3000.0f;
+
+	// Cosine of the half angle of the view cone
+	float SightConeCos = 0.5f;
+
+	// Heard regardless of facing or walls
+	float HearingRadius = 800.0f;
+
+	float LoseSightDelay = 2.0f;
+
+	// Distance changes smaller than this are not written to the blackboard
+	float DistanceWriteTolerance = 10.0f;
+
+	int32 TraceBudget = 16;
+	bool bAsyncTraces = true;
+
+	FName TargetKeyName = TEXT("EnemyActor");
+	FName SightKeyName = TEXT("HasLineOfSight");
+	FName HeardKeyName = TEXT("HeardPlayer");
+	FName DistanceKeyName = TEXT("PlayerDistance");
+
+protected:
+	void ResolveTraces();
+	// Returns true when a trace was needed
+	bool Evaluate(FEnemyPerception& Entry, const FVector& PlayerLocation);
+	void IssueTrace(FEnemyPerception& Entry, const FVector& EyeLocation, const FVector& PlayerLocation);
+	void ApplySight(FEnemyPerception& Entry, bool bVisible);
+	void Publish(FEnemyPerception& Entry);
+	void ResolveKeys(FEnemyPerception& Entry, UBlackboardComponent* Blackboard);
+
+	TArray<FEnemyPerception> Entries;
+	int32 Cursor = 0;
+	double Clock = 0.0;
+	int32 NumTracesLastUpdate = 0;
+};
@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FPSEnemyPool.h"
+#include "FPSProject.h"
+#include "FPSEnemyBase.h"
+#include "Engine/World.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Enemies In Use"), STAT_EnemyPoolInUse, STATGROUP_FPSProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Enemy Pool High Water Mark"), STAT_EnemyPoolHighWater, STATGROUP_FPSProject);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Enemy Pool Hit Rate"), STAT_EnemyPoolHitRate, STATGROUP_FPSProject);
+
+void UFPSEnemyPool::Deinitialize() {
+	Buckets.Empty();
+	Stats = FEnemyPoolStats();
+	Super::Deinitialize();
+}
+
+void UFPSEnemyPool::Prewarm(TSubclassOf<AFPSEnemyBase> EnemyClass, int32 Count) {
+	if (!EnemyClass) return;
+
+	FEnemyPoolBucket& Bucket = Buckets.FindOrAdd(EnemyClass.Get());
+	const int32 ToSpawn = Count - Bucket.Free.Num();
+	for (int32 i = 0; i < ToSpawn; i++) {
+		AFPSEnemyBase* Enemy = SpawnPooled(EnemyClass.Get(), ParkingLocation, FRotator::ZeroRotator);
+		if (!Enemy) break;
+
+		Enemy->DeactivateToPool();
+		Bucket.Free.Add(Enemy);
+	}
+}
+
+AFPSEnemyBase* UFPSEnemyPool::Acquire(TSubclassOf<AFPSEnemyBase> EnemyClass, const FVector& Location, const FRotator& Rotation) {
+	if (!EnemyClass) return nullptr;
+
+	AFPSEnemyBase* Enemy = nullptr;
+	FEnemyPoolBucket& Bucket = Buckets.FindOrAdd(EnemyClass.Get());
+	while (Bucket.Free.Num() > 0 && !Enemy) {
+		AFPSEnemyBase* Candidate = Bucket.Free.Pop();
+		if (IsValid(Candidate)) {
+			Enemy = Candidate;
+		}
+	}
+
+	if (Enemy) {
+		Enemy->ActivateFromPool(Location, Rotation);
+		Stats.Reused++;
+	}
+	else {
+		Enemy = SpawnPooled(EnemyClass.Get(), Location, Rotation);
+		if (!Enemy) return nullptr;
+		Stats.Spawned++;
+	}
+
+	Stats.Acquired++;
+	Stats.InUse++;
+	Stats.HighWaterMark = FMath::Max(Stats.HighWaterMark, Stats.InUse);
+	UpdateStats();
+
+	return Enemy;
+}
+
+void UFPSEnemyPool::Release(AFPSEnemyBase* Enemy) {
+	if (!IsValid(Enemy) || !Enemy->IsPooled() || Enemy->IsInPool()) return;
+
+	Enemy->DeactivateToPool();
+	Buckets.FindOrAdd(Enemy->GetClass()).Free.Add(Enemy);
+
+	Stats.Released++;
+	Stats.InUse = FMath::Max(0, Stats.InUse - 1);
+	UpdateStats();
+}
+
+int32 UFPSEnemyPool::GetNumFree(TSubclassOf<AFPSEnemyBase> EnemyClass) const {
+	const FEnemyPoolBucket* Bucket = Buckets.Find(EnemyClass.Get());
+	return Bucket ? Bucket->Free.Num() : 0;
+}
+
+AFPSEnemyBase* UFPSEnemyPool::SpawnPooled(UClass* EnemyClass, const FVector& Location, const FRotator& Rotation) {
+	UWorld* World = GetWorld();
+	if (!World) return nullptr;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	AFPSEnemyBase* Enemy = World->SpawnActor<AFPSEnemyBase>(EnemyClass, Location, Rotation, SpawnParams);
+	if (Enemy) {
+		Enemy->SpawnDefaultController();
+		Enemy->MarkPooled();
+	}
+	return Enemy;
+}
+
+void UFPSEnemyPool::UpdateStats() {
+	SET_DWORD_STAT(STAT_EnemyPoolInUse, Stats.InUse);
+	SET_DWORD_STAT(STAT_EnemyPoolHighWater, Stats.HighWaterMark);
+	SET_FLOAT_STAT(STAT_EnemyPoolHitRate, Stats.GetHitRate());
+}
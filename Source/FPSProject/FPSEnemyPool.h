@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FPSEnemyPool.generated.h"
+
+class AFPSEnemyBase;
+
+USTRUCT(BlueprintType)
+struct FEnemyPoolStats {
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 Acquired = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 Reused = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 Spawned = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 Released = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 InUse = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 HighWaterMark = 0;
+
+	float GetHitRate() const { return Acquired > 0 ? (float)Reused / (float)Acquired : 0.0f; }
+};
+
+USTRUCT()
+struct FEnemyPoolBucket {
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<AFPSEnemyBase*> Free;
+};
+
+/**
+ * Keeps dead enemies and their AI controllers around, keyed by class, so waves can reuse them instead of spawning.
+ */
+UCLASS()
+class FPSPROJECT_API UFPSEnemyPool : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	UFUNCTION(BlueprintCallable, Category = "Enemy Pool")
+	void Prewarm(TSubclassOf<AFPSEnemyBase> EnemyClass, int32 Count);
+
+	AFPSEnemyBase* Acquire(TSubclassOf<AFPSEnemyBase> EnemyClass, const FVector& Location, const FRotator& Rotation);
+
+	void Release(AFPSEnemyBase* Enemy);
+
+	UFUNCTION(BlueprintCallable, Category = "Enemy Pool")
+	FEnemyPoolStats GetStats() const { return Stats; }
+
+	int32 GetNumFree(TSubclassOf<AFPSEnemyBase> EnemyClass) const;
+
+	// Prewarmed enemies wait here, out of sight and out of the way of the player start
+	FVector ParkingLocation = FVector(0.0f, 0.0f, -50000.0f);
+
+protected:
+	AFPSEnemyBase* SpawnPooled(UClass* EnemyClass, const FVector& Location, const FRotator& Rotation);
+	void UpdateStats();
+
+	UPROPERTY()
+	TMap<UClass*, FEnemyPoolBucket> Buckets;
+
+	FEnemyPoolStats Stats;
+};
@@ -0,0 +1,139 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FPSEnemySignificance.h"
+#include "FPSProject.h"
+#include "FPSEnemyBase.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "TimerManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Significance Pass"), STAT_EnemySignificancePass, STATGROUP_FPSProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Enemies Significance Critical"), STAT_EnemySignificanceCritical, STATGROUP_FPSProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Enemies Significance High"), STAT_EnemySignificanceHigh, STATGROUP_FPSProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Enemies Significance Medium"), STAT_EnemySignificanceMedium, STATGROUP_FPSProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Enemies Significance Low"), STAT_EnemySignificanceLow, STATGROUP_FPSProject);
+
+UFPSEnemySignificance::UFPSEnemySignificance() {
+	BucketLODs.SetNum((int32)EEnemySignificance::Num);
+
+	FEnemyTickLOD& High = BucketLODs[(int32)EEnemySignificance::High];
+	High.ActorTickInterval = 1.0f / 30.0f;
+	High.MovementTickInterval = 1.0f / 30.0f;
+	High.MeshTickInterval = 1.0f / 30.0f;
+
+	FEnemyTickLOD& Medium = BucketLODs[(int32)EEnemySignificance::Medium];
+	Medium.ActorTickInterval = 0.1f;
+	Medium.MovementTickInterval = 0.1f;
+	Medium.MeshTickInterval = 0.2f;
+
+	// CharacterMovement substeps long frames, so a quarter second step still ends up in the right place
+	FEnemyTickLOD& Low = BucketLODs[(int32)EEnemySignificance::Low];
+	Low.ActorTickInterval = 0.25f;
+	Low.MovementTickInterval = 0.25f;
+	Low.MeshTickInterval = 0.5f;
+	Low.bTickPoseWhenOffscreen = false;
+}
+
+void UFPSEnemySignificance::Deinitialize() {
+	Enemies.Empty();
+	FMemory::Memzero(BucketCounts);
+	Super::Deinitialize();
+}
+
+void UFPSEnemySignificance::OnWorldBeginPlay(UWorld& InWorld) {
+	Super::OnWorldBeginPlay(InWorld);
+
+	InWorld.GetTimerManager().SetTimer(UpdateTimerHandle, this, &UFPSEnemySignificance::UpdateFromPlayers, UpdateInterval, true);
+}
+
+void UFPSEnemySignificance::RegisterEnemy(AFPSEnemyBase* Enemy) {
+	if (!Enemy) return;
+
+	Enemies.AddUnique(Enemy);
+}
+
+void UFPSEnemySignificance::UnregisterEnemy(AFPSEnemyBase* Enemy) {
+	Enemies.RemoveSwap(Enemy);
+}
+
+void UFPSEnemySignificance::UpdateSignificance(const TArray<FSignificanceViewer>& Viewers) {
+	SCOPE_CYCLE_COUNTER(STAT_EnemySignificancePass);
+
+	FMemory::Memzero(BucketCounts);
+
+	for (int32 i = Enemies.Num() - 1; i >= 0; i--) {
+		AFPSEnemyBase* Enemy = Enemies[i];
+		if (!IsValid(Enemy)) {
+			Enemies.RemoveAtSwap(i);
+			continue;
+		}
+		if (Enemy->IsInPool()) continue;
+
+		const EEnemySignificance Current = Enemy->GetSignificance();
+
+		// No viewer means nobody to save work for, keep everyone at full rate
+		EEnemySignificance Best = Viewers.Num() > 0 ? EEnemySignificance::Low : EEnemySignificance::Critical;
+		for (const FSignificanceViewer& Viewer : Viewers) {
+			const FVector ToEnemy = Enemy->GetActorLocation() - Viewer.Location;
+			const float Distance = ToEnemy.Size();
+			const float ViewDot = Distance > KINDA_SMALL_NUMBER ? FVector::DotProduct(Viewer.Direction, ToEnemy / Distance) : 1.0f;
+
+			const EEnemySignificance ForViewer = EvaluateSignificance(Current, Distance, ViewDot);
+			if (ForViewer < Best) {
+				Best = ForViewer;
+			}
+		}
+
+		if (Best != Current) {
+			Enemy->ApplyTickLOD(Best, GetTickLOD(Best));
+		}
+		BucketCounts[(int32)Best]++;
+	}
+
+	UpdateStats();
+}
+
+EEnemySignificance UFPSEnemySignificance::EvaluateSignificance(EEnemySignificance Current, float Distance, float ViewDot) const {
+	const EEnemySignificance Raw = Classify(Distance, ViewDot, 1.0f, ViewConeCos);
+	if (Raw <= Current) return Raw;
+
+	// Dropping a bucket: only go as far as the stretched thresholds allow
+	const EEnemySignificance Lenient = Classify(Distance, ViewDot, 1.0f + Hysteresis, ViewConeCos - Hysteresis);
+	return FMath::Max(Current, Lenient);
+}
+
+EEnemySignificance UFPSEnemySignificance::Classify(float Distance, float ViewDot, float DistanceScale, float ConeCos) const {
+	if (Distance <= NearDistance * DistanceScale) return EEnemySignificance::Critical;
+
+	const bool bInView = ViewDot >= ConeCos;
+	const bool bMidRange = Distance <= MidDistance * DistanceScale;
+	if (bInView && bMidRange) return EEnemySignificance::High;
+	if (bInView || bMidRange) return EEnemySignificance::Medium;
+	return EEnemySignificance::Low;
+}
+
+void UFPSEnemySignificance::UpdateFromPlayers() {
+	TArray<FSignificanceViewer> Viewers;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It) {
+		const APlayerController* PC = It->Get();
+		if (!PC || !PC->GetPawn()) continue;
+
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+		FSignificanceViewer& Viewer = Viewers.AddDefaulted_GetRef();
+		Viewer.Location = ViewLocation;
+		Viewer.Direction = ViewRotation.Vector();
+	}
+
+	UpdateSignificance(Viewers);
+}
+
+void UFPSEnemySignificance::UpdateStats() {
+	SET_DWORD_STAT(STAT_EnemySignificanceCritical, BucketCounts[(int32)EEnemySignificance::Critical]);
+	SET_DWORD_STAT(STAT_EnemySignificanceHigh, BucketCounts[(int32)EEnemySignificance::High]);
+	SET_DWORD_STAT(STAT_EnemySignificanceMedium, BucketCounts[(int32)EEnemySignificance::Medium]);
+	SET_DWORD_STAT(STAT_EnemySignificanceLow, BucketCounts[(int32)EEnemySignificance::Low]);
+}
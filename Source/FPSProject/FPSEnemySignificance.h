@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FPSEnemySignificance.generated.h"
+
+class AFPSEnemyBase;
+
+// Ordered from most to least significant
+UENUM(BlueprintType)
+enum class EEnemySignificance : uint8 {
+	Critical,
+	High,
+	Medium,
+	Low,
+	Num UMETA(Hidden)
+};
+
+USTRUCT(BlueprintType)
+struct FEnemyTickLOD {
+	GENERATED_BODY()
+
+	// 0 ticks every frame
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float ActorTickInterval = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float MovementTickInterval = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float MeshTickInterval = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bTickPoseWhenOffscreen = true;
+};
+
+struct FSignificanceViewer {
+	FVector Location = FVector::ZeroVector;
+	FVector Direction = FVector::ForwardVector;
+};
+
+/**
+ * Buckets every enemy by distance to and view direction of the players a few times a second, and scales actor,
+ * movement and mesh tick rates per bucket. Demotion to a less significant bucket needs the enemy to clear the
+ * thresholds by Hysteresis, so enemies on a boundary do not flip every pass.
+ */
+UCLASS()
+class FPSPROJECT_API UFPSEnemySignificance : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UFPSEnemySignificance();
+
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	void RegisterEnemy(AFPSEnemyBase* Enemy);
+	void UnregisterEnemy(AFPSEnemyBase* Enemy);
+
+	// Re-buckets every registered enemy against the given viewers and applies the tick LODs of changed buckets
+	void UpdateSignificance(const TArray<FSignificanceViewer>& Viewers);
+
+	EEnemySignificance EvaluateSignificance(EEnemySignificance Current, float Distance, float ViewDot) const;
+
+	const FEnemyTickLOD& GetTickLOD(EEnemySignificance Significance) const { return BucketLODs[(int32)Significance]; }
+
+	int32 GetBucketCount(EEnemySignificance Significance) const { return BucketCounts[(int32)Significance]; }
+
+	float NearDistance = 1500.0f;
+	float MidDistance = 4000.0f;
+
+	// Cosine of the half angle counted as in view
+	float ViewConeCos = 0.5f;
+
+	// Fraction by which distances (and the view cone) are stretched before an enemy may drop a bucket
+	float Hysteresis = 0.15f;
+
+	float UpdateInterval = 0.2f;
+
+	TArray<FEnemyTickLOD> BucketLODs;
+
+protected:
+	void UpdateFromPlayers();
+	EEnemySignificance Classify(float Distance, float ViewDot, float DistanceScale, float ConeCos) const;
+	void UpdateStats();
+
+	UPROPERTY()
+	TArray<AFPSEnemyBase*> Enemies;
+
+	int32 BucketCounts[(int32)EEnemySignificance::Num] = {};
+
+	FTimerHandle UpdateTimerHandle;
+};
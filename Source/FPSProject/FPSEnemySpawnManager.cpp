@@ -4,6 +4,10 @@
 #include "FPSEnemySpawnManager.h"
 #include "FPSEnemyPatrol.h"
 #include "FPSEnemyDumb.h"
+#include "FPSEnemyPool.h"
+#include "FPSSpawnPointService.h"
+#include "FPSPopulationDirector.h"
+#include "FPSSwarmSubsystem.h"
 #include "Engine/Engine.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Kismet/GameplayStatics.h"
@@ -19,12 +23,89 @@ AFPSEnemySpawnManager::AFPSEnemySpawnManager()
 
 }
 
+void AFPSEnemySpawnManager::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Before BeginPlay, so a spawner placed in the level has its points sampled while the world loads
+	UWorld* World = GetWorld();
+	if (UFPSSpawnPointService* SpawnPoints = World && World->IsGameWorld() ? World->GetSubsystem<UFPSSpawnPointService>() : nullptr) {
+		SpawnPoints->RegisterReservoir(SpawnOrigin, SpawnRadius, SpawnPointReservoirSize);
+	}
+}
+
 // Called when the game starts or when spawned
 void AFPSEnemySpawnManager::BeginPlay()
 {
 	Super::BeginPlay();
-	SpawnSmartEnemy();
-	
+
+	if (UFPSEnemyPool* Pool = GetWorld()->GetSubsystem<UFPSEnemyPool>()) {
+		Pool->Prewarm(SmartEnemy, PrewarmSmartEnemies);
+		Pool->Prewarm(DumbEnemy, PrewarmDumbEnemies);
+	}
+
+	if (UFPSPopulationDirector* Director = GetWorld()->GetSubsystem<UFPSPopulationDirector>()) {
+		Director->SetDefaultBudget(SmartEnemy, MaxAliveSmartEnemies);
+		Director->SetDefaultBudget(DumbEnemy, MaxAliveDumbEnemies);
+	}
+
+	if (bUseSwarmForDumbEnemies) {
+		if (UFPSSwarmSubsystem* Swarm = GetWorld()->GetSubsystem<UFPSSwarmSubsystem>()) {
+			Swarm->Configure(DumbEnemy, SwarmProxyMesh);
+		}
+	}
+
+	StartSpawning();
+}
+
+void AFPSEnemySpawnManager::StartSpawning() {
+	if (WaveTimeline) {
+		StartWaveTimeline();
+		return;
+	}
+
+	SetActorTickEnabled(true);
+	SpawnSmartEnemyOrDefer();
+}
+
+void AFPSEnemySpawnManager::ResetSpawner() {
+	StopWaveTimeline();
+	GetWorldTimerManager().ClearTimer(Phase2Handle);
+	GetWorldTimerManager().ClearTimer(DeferredSpawnHandle);
+
+	for (AFPSEnemyPatrol* Enemy : SmartEnemies) {
+		ReleaseEnemy(Enemy);
+	}
+	for (AFPSEnemyDumb* Enemy : DumbEnemies) {
+		ReleaseEnemy(Enemy);
+	}
+	SmartEnemies.Reset();
+	DumbEnemies.Reset();
+	CurrentSmartEnemy = nullptr;
+
+	CurrentPhase = ESpawnerPhase::Phase1;
+	SmartKillCount = 0;
+	DumbKillCount = 0;
+	TotalKillCount = 0;
+	Phase2Spawned = 0;
+	DumbEnemySpawnTimer = 0.0f;
+	Phase3SpawnTimer = 0.0f;
+	DeferredSmartSpawns = 0;
+	DeferredDumbSpawns = 0;
+
+	StartSpawning();
+}
+
+void AFPSEnemySpawnManager::ReleaseEnemy(AFPSEnemyBase* Enemy) {
+	if (!IsValid(Enemy)) return;
+
+	if (UFPSPopulationDirector* Director = GetWorld()->GetSubsystem<UFPSPopulationDirector>()) {
+		Director->Unregister(Enemy);
+	}
+
+	// Cleared first so Recycle does not report back an enemy the spawner already dropped
+	Enemy->OwningSpawner = nullptr;
+	Enemy->Recycle();
 }
 
 // Called every frame
@@ -38,7 +119,7 @@ void AFPSEnemySpawnManager::Tick(float DeltaTime)
 			});
 
 		DumbEnemySpawnTimer += DeltaTime;
-		int32 AvailableSlots = MaxDumbEnemiesPhase1 - DumbEnemies.Num();
+		int32 AvailableSlots = MaxDumbEnemiesPhase1 - GetNumDumbEnemies();
 		if (DumbEnemySpawnTimer >= 10.0f && AvailableSlots > 0) {
 			GEngine->AddOnScreenDebugMessage(-1, 4.0f, FColor::Red, TEXT("Spawning Dumb enemy"));
 			SpawnDumbEnemy();
@@ -49,7 +130,7 @@ void AFPSEnemySpawnManager::Tick(float DeltaTime)
 		DumbEnemies.RemoveAll([](AFPSEnemyDumb* E) {
 			return !IsValid(E);
 			});
-		if (Phase2Spawned <= 0 && DumbEnemies.Num() == 0) {
+		if (Phase2Spawned <= 0 && GetNumDumbEnemies() == 0) {
 			CurrentPhase = ESpawnerPhase::Phase3;
 			Phase3SpawnTimer = 0.0f;
 		}
@@ -75,49 +156,128 @@ void AFPSEnemySpawnManager::Tick(float DeltaTime)
 	}
 }
 
-void AFPSEnemySpawnManager::SpawnSmartEnemy() {
+bool AFPSEnemySpawnManager::SpawnSmartEnemy() {
 	if (!SmartEnemy) {
 		GEngine->AddOnScreenDebugMessage(-1, 4.0f, FColor::Red, TEXT("SMART ENEMY NOT SET!"));
 		CurrentSmartEnemy = nullptr;
-		return;
+		return false;
 	}
+	if (!RequestPopulationSlot(SmartEnemy)) return false;
+
 	FVector Loc = GetRandomNavMeshPoint();
 	FRotator Rot = FRotator::ZeroRotator;
 
-	FActorSpawnParameters SpawnParams;
-	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-
-	AFPSEnemyPatrol* Enemy = GetWorld()->SpawnActor<AFPSEnemyPatrol>(SmartEnemy, Loc, Rot, SpawnParams);
+	AFPSEnemyPatrol* Enemy = Cast<AFPSEnemyPatrol>(AcquireEnemy(SmartEnemy, Loc, Rot));
 	if (Enemy) {
-		Enemy->SpawnDefaultController();
 		CurrentSmartEnemy = Enemy;
+		SmartEnemies.Add(Enemy);
 		Enemy->OwningSpawner = this;
-	} else {
-		CurrentSmartEnemy = nullptr;
+		if (UFPSPopulationDirector* Director = GetWorld()->GetSubsystem<UFPSPopulationDirector>()) {
+			Director->Register(Enemy);
+		}
+		return true;
 	}
+
+	CurrentSmartEnemy = nullptr;
+	return false;
 }
 
-void AFPSEnemySpawnManager::SpawnDumbEnemy() {
-	if (!DumbEnemy) return;
+bool AFPSEnemySpawnManager::SpawnDumbEnemy() {
+	if (!DumbEnemy) return false;
+
 	FVector Loc = GetRandomNavMeshPoint();
 	FRotator Rot = FRotator::ZeroRotator;
 	Loc.Z += 100.0f;
 
-	FActorSpawnParameters SpawnParams;
-	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	// Swarm agents are not actors, the director's budgets do not apply to them
+	if (UFPSSwarmSubsystem* Swarm = GetSwarm()) {
+		if (Swarm->SpawnAgent(Loc, this) == INDEX_NONE) return false;
+		if (CurrentPhase == ESpawnerPhase::Phase2) {
+			Phase2Spawned++;
+		}
+		return true;
+	}
+
+	if (!RequestPopulationSlot(DumbEnemy)) return false;
 
-	AFPSEnemyDumb* Enemy = GetWorld()->SpawnActor<AFPSEnemyDumb>(DumbEnemy, Loc, Rot, SpawnParams);
+	AFPSEnemyDumb* Enemy = Cast<AFPSEnemyDumb>(AcquireEnemy(DumbEnemy, Loc, Rot));
 	if (Enemy) {
-		Enemy->SpawnDefaultController();
 		DumbEnemies.Add(Enemy);
 		Enemy->OwningSpawner = this;
 		if (CurrentPhase == ESpawnerPhase::Phase2) {
 			Phase2Spawned++;
 		}
+		if (UFPSPopulationDirector* Director = GetWorld()->GetSubsystem<UFPSPopulationDirector>()) {
+			Director->Register(Enemy);
+		}
+		return true;
+	}
+	return false;
+}
+
+void AFPSEnemySpawnManager::SpawnSmartEnemyOrDefer() {
+	if (!SpawnSmartEnemy() && SmartEnemy) {
+		DeferredSmartSpawns++;
+		ScheduleDeferredSpawnRetry();
+	}
+}
+
+void AFPSEnemySpawnManager::SpawnDumbEnemyOrDefer() {
+	if (!SpawnDumbEnemy() && DumbEnemy) {
+		DeferredDumbSpawns++;
+		ScheduleDeferredSpawnRetry();
+	}
+}
+
+void AFPSEnemySpawnManager::ScheduleDeferredSpawnRetry() {
+	// Our own deaths drain right away, the timer covers slots freed by other spawners sharing the budget
+	if (!GetWorldTimerManager().IsTimerActive(DeferredSpawnHandle)) {
+		GetWorldTimerManager().SetTimer(DeferredSpawnHandle, this, &AFPSEnemySpawnManager::DrainDeferredSpawns, DeferredSpawnRetryInterval, true);
+	}
+}
+
+void AFPSEnemySpawnManager::DrainDeferredSpawns() {
+	while (DeferredSmartSpawns > 0 && SpawnSmartEnemy()) {
+		DeferredSmartSpawns--;
+	}
+	while (DeferredDumbSpawns > 0 && SpawnDumbEnemy()) {
+		DeferredDumbSpawns--;
+		// The Phase 2 burst already counted this one when it was deferred
+		if (CurrentPhase == ESpawnerPhase::Phase2) {
+			Phase2Spawned--;
+		}
+	}
+
+	if (DeferredSmartSpawns == 0 && DeferredDumbSpawns == 0) {
+		GetWorldTimerManager().ClearTimer(DeferredSpawnHandle);
 	}
 }
 
+bool AFPSEnemySpawnManager::RequestPopulationSlot(UClass* EnemyClass) const {
+	UFPSPopulationDirector* Director = GetWorld()->GetSubsystem<UFPSPopulationDirector>();
+	return !Director || Director->RequestSpawn(EnemyClass);
+}
+
+AFPSEnemyBase* AFPSEnemySpawnManager::AcquireEnemy(TSubclassOf<AFPSEnemyBase> EnemyClass, const FVector& Location, const FRotator& Rotation) {
+	if (UFPSEnemyPool* Pool = GetWorld()->GetSubsystem<UFPSEnemyPool>()) {
+		return Pool->Acquire(EnemyClass, Location, Rotation);
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	AFPSEnemyBase* Enemy = GetWorld()->SpawnActor<AFPSEnemyBase>(EnemyClass, Location, Rotation, SpawnParams);
+	if (Enemy) {
+		Enemy->SpawnDefaultController();
+	}
+	return Enemy;
+}
+
 FVector AFPSEnemySpawnManager::GetRandomNavMeshPoint() const {
+	FVector CachedPoint;
+	UFPSSpawnPointService* SpawnPoints = GetWorld()->GetSubsystem<UFPSSpawnPointService>();
+	if (SpawnPoints && SpawnPoints->TryTakePoint(SpawnOrigin, SpawnRadius, CachedPoint)) return CachedPoint;
+
 	UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld());
 	if (!NavSys) {
 		FVector RandomOffset = FVector(FMath::RandRange(-SpawnRadius, SpawnRadius), FMath::RandRange(-SpawnRadius, SpawnRadius), 0.0f);
@@ -131,26 +291,41 @@ FVector AFPSEnemySpawnManager::GetRandomNavMeshPoint() const {
 
 void AFPSEnemySpawnManager::StartPhase2() {
 	for (int i = 0; i < 5; i++) {
-		SpawnDumbEnemy();
+		SpawnDumbEnemyOrDefer();
 	}
 	Phase2Spawned = 5;
 
 	GetWorldTimerManager().SetTimer(Phase2Handle, [this]() {
 		for (int i = 0; i < 5; i++) {
-			SpawnDumbEnemy();
+			SpawnDumbEnemyOrDefer();
 		}
 		Phase2Spawned += 5;
 		}, 10.0f, false);
 }
 
 void AFPSEnemySpawnManager::NotifySmartEnemyDeath(AFPSEnemyPatrol* Enemy) {
+	SmartEnemies.Remove(Enemy);
+	if (UFPSPopulationDirector* Director = GetWorld()->GetSubsystem<UFPSPopulationDirector>()) {
+		Director->Unregister(Enemy);
+	}
+
+	if (bWaveTimelineRunning) {
+		if (CurrentSmartEnemy == Enemy) {
+			CurrentSmartEnemy = SmartEnemies.Num() > 0 ? SmartEnemies.Last() : nullptr;
+		}
+		SmartKillCount++;
+		DrainDeferredSpawns();
+		OnWaveTimelineKill();
+		return;
+	}
+
 	if (CurrentSmartEnemy == Enemy) {
 		SmartKillCount++;
 		CurrentSmartEnemy = nullptr;
 		if (CurrentPhase == ESpawnerPhase::Phase1) {
 			if (SmartKillCount < 3) {
 				GEngine->AddOnScreenDebugMessage(-1, 4.0f, FColor::Red, TEXT("Spawning Smart enemy, P1"));
-				SpawnSmartEnemy();
+				SpawnSmartEnemyOrDefer();
 			}
 			else {
 				CurrentPhase = ESpawnerPhase::Phase2;
@@ -158,10 +333,261 @@ void AFPSEnemySpawnManager::NotifySmartEnemyDeath(AFPSEnemyPatrol* Enemy) {
 			}
 		}
 	}
+
+	DrainDeferredSpawns();
 }
 
 void AFPSEnemySpawnManager::NotifyDumbEnemyDeath(AFPSEnemyDumb* Enemy) {
 	DumbEnemies.Remove(Enemy);
+	if (UFPSPopulationDirector* Director = GetWorld()->GetSubsystem<UFPSPopulationDirector>()) {
+		Director->Unregister(Enemy);
+	}
+
+	HandleDumbEnemyDeath();
+}
+
+void AFPSEnemySpawnManager::NotifySwarmEnemyDeath() {
+	HandleDumbEnemyDeath();
+}
+
+void AFPSEnemySpawnManager::HandleDumbEnemyDeath() {
+	if (bWaveTimelineRunning) {
+		DumbKillCount++;
+		DrainDeferredSpawns();
+		OnWaveTimelineKill();
+		return;
+	}
+
 	if (CurrentPhase == ESpawnerPhase::Phase2)
 		Phase2Spawned--;
+
+	DrainDeferredSpawns();
+}
+
+int32 AFPSEnemySpawnManager::GetNumDumbEnemies() const {
+	const UFPSSwarmSubsystem* Swarm = GetSwarm();
+	return DumbEnemies.Num() + (Swarm ? Swarm->GetNumAgentsOwnedBy(this) : 0);
+}
+
+UFPSSwarmSubsystem* AFPSEnemySpawnManager::GetSwarm() const {
+	if (!bUseSwarmForDumbEnemies || !GetWorld()) return nullptr;
+
+	UFPSSwarmSubsystem* Swarm = GetWorld()->GetSubsystem<UFPSSwarmSubsystem>();
+	return Swarm && Swarm->IsConfigured() ? Swarm : nullptr;
+}
+
+void AFPSEnemySpawnManager::NotifyEnemyRecycled(AFPSEnemyBase* Enemy) {
+	if (UFPSPopulationDirector* Director = GetWorld()->GetSubsystem<UFPSPopulationDirector>()) {
+		Director->Unregister(Enemy);
+	}
+
+	AFPSEnemyPatrol* Smart = Cast<AFPSEnemyPatrol>(Enemy);
+	AFPSEnemyDumb* Dumb = Cast<AFPSEnemyDumb>(Enemy);
+	if (Smart) {
+		SmartEnemies.Remove(Smart);
+	}
+	if (Dumb) {
+		DumbEnemies.Remove(Dumb);
+	}
+
+	if (bWaveTimelineRunning) {
+		if (CurrentSmartEnemy == Smart) {
+			CurrentSmartEnemy = SmartEnemies.Num() > 0 ? SmartEnemies.Last() : nullptr;
+		}
+		DrainDeferredSpawns();
+		CheckClearEvents();
+		return;
+	}
+
+	// Recycling is not a kill, so Phase 1 gets a replacement to keep progressing
+	if (Smart && CurrentSmartEnemy == Smart) {
+		CurrentSmartEnemy = nullptr;
+		if (CurrentPhase == ESpawnerPhase::Phase1) {
+			SpawnSmartEnemyOrDefer();
+		}
+	}
+
+	if (Dumb && CurrentPhase == ESpawnerPhase::Phase2) {
+		Phase2Spawned--;
+	}
+
+	DrainDeferredSpawns();
+}
+
+void AFPSEnemySpawnManager::PruneInvalidEnemies() {
+	// Only enemies removed without dying (level cleanup, perf tests) end up here, so this runs per event, not per frame
+	SmartEnemies.RemoveAll([](AFPSEnemyPatrol* E) {
+		return !IsValid(E);
+		});
+	DumbEnemies.RemoveAll([](AFPSEnemyDumb* E) {
+		return !IsValid(E);
+		});
+	if (!IsValid(CurrentSmartEnemy)) {
+		CurrentSmartEnemy = SmartEnemies.Num() > 0 ? SmartEnemies.Last() : nullptr;
+	}
+}
+
+void AFPSEnemySpawnManager::StartWaveTimeline() {
+	if (!WaveTimeline) return;
+
+	StopWaveTimeline();
+	SetActorTickEnabled(false);
+	bWaveTimelineRunning = true;
+
+	TotalKillCount = 0;
+	SmartKillCount = 0;
+	DumbKillCount = 0;
+
+	const TArray<FWaveSpawnEvent>& Events = WaveTimeline->Events;
+	WaveEventTimers.SetNum(Events.Num());
+	WaveEventRepeatsLeft.SetNum(Events.Num());
+
+	for (int32 i = 0; i < Events.Num(); i++) {
+		WaveEventRepeatsLeft[i] = Events[i].Repeats;
+		switch (Events[i].Trigger) {
+		case EWaveTriggerType::AtTime:
+			break;
+		case EWaveTriggerType::OnKillCount:
+			PendingKillEvents.Add(i);
+			break;
+		case EWaveTriggerType::OnAllEnemiesDead:
+			PendingClearEvents.Add(i);
+			break;
+		}
+	}
+
+	PendingKillEvents.StableSort([&Events](int32 A, int32 B) {
+		return Events[A].KillCount < Events[B].KillCount;
+		});
+
+	// Scheduled after the queues are built so events firing at time zero see a consistent state
+	for (int32 i = 0; i < Events.Num(); i++) {
+		if (Events[i].Trigger == EWaveTriggerType::AtTime) {
+			ScheduleWaveEvent(i, Events[i].Time);
+		}
+	}
+}
+
+void AFPSEnemySpawnManager::StopWaveTimeline() {
+	for (FTimerHandle& Handle : WaveEventTimers) {
+		GetWorldTimerManager().ClearTimer(Handle);
+	}
+	WaveEventTimers.Reset();
+	WaveEventRepeatsLeft.Reset();
+	PendingKillEvents.Reset();
+	PendingClearEvents.Reset();
+	bWaveTimelineRunning = false;
+}
+
+void AFPSEnemySpawnManager::ScheduleWaveEvent(int32 EventIndex, float Delay) {
+	if (Delay <= 0.0f) {
+		FireWaveEvent(EventIndex);
+		return;
+	}
+
+	FTimerDelegate Delegate = FTimerDelegate::CreateUObject(this, &AFPSEnemySpawnManager::FireWaveEvent, EventIndex);
+	GetWorldTimerManager().SetTimer(WaveEventTimers[EventIndex], Delegate, Delay, false);
+}
+
+void AFPSEnemySpawnManager::FireWaveEvent(int32 EventIndex) {
+	if (!bWaveTimelineRunning || !WaveTimeline || !WaveTimeline->Events.IsValidIndex(EventIndex)) return;
+
+	const FWaveSpawnEvent& Event = WaveTimeline->Events[EventIndex];
+	if (Event.StopAfterKills > 0 && GetKillCount(Event.StopKillFilter) >= Event.StopAfterKills) {
+		return;
+	}
+
+	SpawnForWaveEvent(Event);
+
+	int32& RepeatsLeft = WaveEventRepeatsLeft[EventIndex];
+	if (RepeatsLeft != 0) {
+		if (RepeatsLeft > 0) {
+			RepeatsLeft--;
+		}
+		FTimerDelegate Delegate = FTimerDelegate::CreateUObject(this, &AFPSEnemySpawnManager::FireWaveEvent, EventIndex);
+		GetWorldTimerManager().SetTimer(WaveEventTimers[EventIndex], Delegate, FMath::Max(Event.RepeatInterval, KINDA_SMALL_NUMBER), false);
+	}
+}
+
+void AFPSEnemySpawnManager::SpawnForWaveEvent(const FWaveSpawnEvent& Event) {
+	PruneInvalidEnemies();
+
+	for (int32 i = 0; i < Event.Count; i++) {
+		if (WaveTimeline->MaxAliveTotal > 0 && GetAliveEnemyCount() >= WaveTimeline->MaxAliveTotal) {
+			return;
+		}
+
+		bool bSmart = Event.EnemyType == EWaveEnemyType::Smart;
+		if (Event.EnemyType == EWaveEnemyType::Random) {
+			bSmart = FMath::RandBool();
+		}
+
+		const int32 AliveOfType = bSmart ? SmartEnemies.Num() : GetNumDumbEnemies();
+		if (Event.MaxAlive > 0 && AliveOfType >= Event.MaxAlive) {
+			continue;
+		}
+
+		// Refused spawns are owed, not dropped, they come out once the director has room again
+		if (bSmart) {
+			SpawnSmartEnemyOrDefer();
+		}
+		else {
+			SpawnDumbEnemyOrDefer();
+		}
+	}
+}
+
+void AFPSEnemySpawnManager::OnWaveTimelineKill() {
+	TotalKillCount++;
+
+	const TArray<FWaveSpawnEvent>& Events = WaveTimeline->Events;
+
+	// Sorted by threshold, and no filtered count can exceed the total, so we can stop at the first unreachable one
+	for (int32 i = 0; i < PendingKillEvents.Num();) {
+		const FWaveSpawnEvent& Event = Events[PendingKillEvents[i]];
+		if (Event.KillCount > TotalKillCount) break;
+
+		if (GetKillCount(Event.KillFilter) >= Event.KillCount) {
+			const int32 EventIndex = PendingKillEvents[i];
+			PendingKillEvents.RemoveAt(i);
+			ScheduleWaveEvent(EventIndex, Event.Time);
+		}
+		else {
+			i++;
+		}
+	}
+
+	CheckClearEvents();
+}
+
+void AFPSEnemySpawnManager::CheckClearEvents() {
+	if (PendingClearEvents.Num() == 0) return;
+
+	const TArray<FWaveSpawnEvent>& Events = WaveTimeline->Events;
+
+	PruneInvalidEnemies();
+	if (GetAliveEnemyCount() > 0) return;
+
+	for (int32 i = 0; i < PendingClearEvents.Num();) {
+		const FWaveSpawnEvent& Event = Events[PendingClearEvents[i]];
+		if (GetKillCount(Event.KillFilter) >= Event.KillCount) {
+			const int32 EventIndex = PendingClearEvents[i];
+			PendingClearEvents.RemoveAt(i);
+			ScheduleWaveEvent(EventIndex, Event.Time);
+		}
+		else {
+			i++;
+		}
+	}
+}
+
+int32 AFPSEnemySpawnManager::GetKillCount(EWaveKillFilter Filter) const {
+	switch (Filter) {
+	case EWaveKillFilter::Smart:
+		return SmartKillCount;
+	case EWaveKillFilter::Dumb:
+		return DumbKillCount;
+	default:
+		return TotalKillCount;
+	}
 }
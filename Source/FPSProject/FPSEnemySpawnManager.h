@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "FPSWaveTimeline.h"
 #include "FPSEnemySpawnManager.generated.h"
 
 UENUM()
@@ -20,6 +21,7 @@ class FPSPROJECT_API AFPSEnemySpawnManager : public AActor
 	
 public:	
 	AFPSEnemySpawnManager();
+	virtual void PostInitializeComponents() override;
 	virtual void BeginPlay() override;
 	virtual void Tick(float DeltaTime) override;
 
@@ -38,10 +40,45 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Spawner")
 	int32 MaxDumbEnemiesPhase1 = 4;
 
+	// When set, the timeline drives all spawning and the hard-coded phases are skipped. The spawner does not tick.
+	UPROPERTY(EditAnywhere, Category = "Spawner")
+	UFPSWaveTimeline* WaveTimeline = nullptr;
+
+	// Enemies created up front in BeginPlay so the Phase 2 bursts come out of the pool
+	UPROPERTY(EditAnywhere, Category = "Spawner|Pool")
+	int32 PrewarmSmartEnemies = 3;
+
+	UPROPERTY(EditAnywhere, Category = "Spawner|Pool")
+	int32 PrewarmDumbEnemies = 10;
+
+	// Reachable points kept ready by UFPSSpawnPointService for this spawner
+	UPROPERTY(EditAnywhere, Category = "Spawner|Pool")
+	int32 SpawnPointReservoirSize = 32;
+
+	// Caps shared with every other spawner through UFPSPopulationDirector. 0 leaves the class uncapped.
+	UPROPERTY(EditAnywhere, Category = "Spawner|Population")
+	int32 MaxAliveSmartEnemies = 5;
+
+	UPROPERTY(EditAnywhere, Category = "Spawner|Population")
+	int32 MaxAliveDumbEnemies = 20;
+
+	// Seconds between retries of refused spawns while other spawners hold the shared budget
+	UPROPERTY(EditAnywhere, Category = "Spawner|Population", meta = (ClampMin = "0.01"))
+	float DeferredSpawnRetryInterval = 0.5f;
+
+	// Dumb enemies become UFPSSwarmSubsystem agents and only turn into actors near the player
+	UPROPERTY(EditAnywhere, Category = "Spawner|Swarm")
+	bool bUseSwarmForDumbEnemies = false;
+
+	// Drawn for swarm agents too far away to be actors. Leave empty to draw nothing.
+	UPROPERTY(EditAnywhere, Category = "Spawner|Swarm", meta = (EditCondition = "bUseSwarmForDumbEnemies"))
+	class UStaticMesh* SwarmProxyMesh = nullptr;
+
 	ESpawnerPhase CurrentPhase = ESpawnerPhase::Phase1;
 	int32 SmartKillCount = 0;
 
 	AFPSEnemyPatrol* CurrentSmartEnemy = nullptr;
+	TArray<AFPSEnemyPatrol*> SmartEnemies;
 	TArray<AFPSEnemyDumb*> DumbEnemies;
 
 	int32 Phase2Spawned = 0;
@@ -50,14 +87,66 @@ public:
 
 	FTimerHandle Phase2Handle;
 
-protected:
+	// Spawns the director refused, retried when one of our enemies goes away and on a timer while any are waiting.
+	// Works the same in phase and wave timeline mode, the spawner does not need to tick for it.
+	int32 DeferredSmartSpawns = 0;
+	int32 DeferredDumbSpawns = 0;
+	FTimerHandle DeferredSpawnHandle;
+
+	// Wave timeline state
+	int32 TotalKillCount = 0;
+	int32 DumbKillCount = 0;
+	TArray<FTimerHandle> WaveEventTimers;
+
+	void StartWaveTimeline();
+	void StopWaveTimeline();
+	bool IsWaveTimelineRunning() const { return bWaveTimelineRunning; }
+
+	// Returns every enemy this spawner owns and forgets all progress, then starts over as if BeginPlay just ran
+	void ResetSpawner();
 
-	void SpawnSmartEnemy();
-	void SpawnDumbEnemy();
+protected:
+	void StartSpawning();
+	void ReleaseEnemy(class AFPSEnemyBase* Enemy);
+
+	void FireWaveEvent(int32 EventIndex);
+	void ScheduleWaveEvent(int32 EventIndex, float Delay);
+	void SpawnForWaveEvent(const FWaveSpawnEvent& Event);
+	void OnWaveTimelineKill();
+	void CheckClearEvents();
+	int32 GetKillCount(EWaveKillFilter Filter) const;
+	int32 GetAliveEnemyCount() const { return SmartEnemies.Num() + GetNumDumbEnemies(); }
+
+	void PruneInvalidEnemies();
+
+	bool bWaveTimelineRunning = false;
+
+	// Kill-triggered events waiting to fire, sorted by KillCount
+	TArray<int32> PendingKillEvents;
+	TArray<int32> PendingClearEvents;
+	TArray<int32> WaveEventRepeatsLeft;
+
+	bool SpawnSmartEnemy();
+	bool SpawnDumbEnemy();
+	void SpawnSmartEnemyOrDefer();
+	void SpawnDumbEnemyOrDefer();
+	void DrainDeferredSpawns();
+	void ScheduleDeferredSpawnRetry();
+	bool RequestPopulationSlot(UClass* EnemyClass) const;
+	class AFPSEnemyBase* AcquireEnemy(TSubclassOf<class AFPSEnemyBase> EnemyClass, const FVector& Location, const FRotator& Rotation);
 	FVector GetRandomNavMeshPoint() const;
 	void StartPhase2();
 
 public:
 	void NotifySmartEnemyDeath(AFPSEnemyPatrol* Enemy);
 	void NotifyDumbEnemyDeath(AFPSEnemyDumb* Enemy);
+	void NotifyEnemyRecycled(class AFPSEnemyBase* Enemy);
+	void NotifySwarmEnemyDeath();
+
+	// Dumb enemy actors plus swarm agents owned by this spawner
+	int32 GetNumDumbEnemies() const;
+
+protected:
+	void HandleDumbEnemyDeath();
+	class UFPSSwarmSubsystem* GetSwarm() const;
 };
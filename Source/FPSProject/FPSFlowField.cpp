@@ -0,0 +1,279 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FPSFlowField.h"
+#include "FPSProject.h"
+#include "Engine/World.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "Kismet/GameplayStatics.h"
+
+DECLARE_CYCLE_STAT(TEXT("Flow Field Recompute"), STAT_FlowFieldRecompute, STATGROUP_FPSProject);
+DECLARE_CYCLE_STAT(TEXT("Flow Field Build"), STAT_FlowFieldBuild, STATGROUP_FPSProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Flow Field Reached Cells"), STAT_FlowFieldReachedCells, STATGROUP_FPSProject);
+
+namespace FlowField
+{
+	static const int32 NeighbourX[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+	static const int32 NeighbourY[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+	static const float NeighbourCost[8] = { 1.0f, 1.0f, 1.0f, 1.0f, UE_SQRT_2, UE_SQRT_2, UE_SQRT_2, UE_SQRT_2 };
+}
+
+void UFPSFlowField::Deinitialize() {
+	if (UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld())) {
+		NavSys->OnNavigationGenerationFinishedDelegate.RemoveAll(this);
+	}
+
+	CellHeights.Empty();
+	Walkable.Empty();
+	PathCosts.Empty();
+	Directions.Empty();
+	ReachedCells.Empty();
+	OpenCells.Empty();
+	Pending = FPendingGrid();
+	Super::Deinitialize();
+}
+
+void UFPSFlowField::OnWorldBeginPlay(UWorld& InWorld) {
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(&InWorld)) {
+		NavSys->OnNavigationGenerationFinishedDelegate.AddUniqueDynamic(this, &UFPSFlowField::HandleNavigationGenerationFinished);
+	}
+}
+
+TStatId UFPSFlowField::GetStatId() const {
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFPSFlowField, STATGROUP_Tickables);
+}
+
+void UFPSFlowField::Tick(float DeltaTime) {
+	if (bNeedsBuild && !IsBuilding()) {
+		BuildFromNavigation();
+	}
+	if (IsBuilding()) {
+		StepNavigationBuild();
+	}
+	if (!IsBuilt()) return;
+
+	const APawn* Player = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+	if (Player) {
+		SetTarget(Player->GetActorLocation());
+	}
+}
+
+bool UFPSFlowField::GetDirection(const FVector& Location, FVector& OutDirection) const {
+	const int32 Index = GetCellIndex(Location);
+	if (Index == INDEX_NONE || Index == TargetCell) return false;
+
+	const FVector2f& Direction = Directions[Index];
+	if (Direction.IsNearlyZero()) return false;
+
+	OutDirection = FVector(Direction.X, Direction.Y, 0.0f);
+	return true;
+}
+
+void UFPSFlowField::BuildGrid(const FVector& Origin, const FIntPoint& Size, float InCellSize, TFunctionRef<bool(const FVector&, float&)> Sampler) {
+	BeginGrid(Origin, Size, InCellSize);
+	SampleCells(Size.X * Size.Y, Sampler);
+}
+
+bool UFPSFlowField::BuildFromNavigation() {
+	UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld());
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : nullptr;
+	if (!NavData || NavSys->IsNavigationBuildInProgress()) return false;
+
+	const FBox Bounds = NavSys->GetNavigableWorldBounds();
+	if (!Bounds.IsValid) return false;
+
+	const FVector Extent = Bounds.GetSize();
+	const float Size = FMath::Max3(CellSize, (float)Extent.X / MaxCellsPerAxis, (float)Extent.Y / MaxCellsPerAxis);
+	const FIntPoint Cells(FMath::CeilToInt(Extent.X / Size), FMath::CeilToInt(Extent.Y / Size));
+
+	BeginGrid(FVector(Bounds.Min.X, Bounds.Min.Y, Bounds.GetCenter().Z), Cells, Size);
+	Pending.QueryExtent = FVector(Size * 0.5f, Size * 0.5f, Extent.Z * 0.5f + 100.0f);
+	return true;
+}
+
+bool UFPSFlowField::StepNavigationBuild() {
+	if (!IsBuilding()) return false;
+
+	UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld());
+	if (!NavSys) {
+		Pending.Cursor = INDEX_NONE;
+		return false;
+	}
+
+	// Tiles are changing, the rebuild that follows restarts the grid anyway
+	if (NavSys->IsNavigationBuildInProgress()) return false;
+
+	// A cell has floor if the navmesh projection of its center lands inside it, walls project to a neighbour
+	const FVector QueryExtent = Pending.QueryExtent;
+	const float HalfCell = Pending.CellSize * 0.5f;
+	return SampleCells(BuildCellsPerTick, [NavSys, &QueryExtent, HalfCell](const FVector& Center, float& OutHeight) {
+		FNavLocation Projected;
+		if (!NavSys->ProjectPointToNavigation(Center, Projected, QueryExtent)) return false;
+		if (FMath::Abs(Projected.Location.X - Center.X) > HalfCell || FMath::Abs(Projected.Location.Y - Center.Y) > HalfCell) return false;
+
+		OutHeight = Projected.Location.Z;
+		return true;
+		});
+}
+
+void UFPSFlowField::BeginGrid(const FVector& Origin, const FIntPoint& Size, float InCellSize) {
+	Pending.Origin = Origin;
+	Pending.Size = Size;
+	Pending.CellSize = InCellSize;
+	Pending.CellHeights.SetNumZeroed(Size.X * Size.Y);
+	Pending.Walkable.SetNumZeroed(Size.X * Size.Y);
+	Pending.Cursor = 0;
+}
+
+bool UFPSFlowField::SampleCells(int32 MaxCells, TFunctionRef<bool(const FVector&, float&)> Sampler) {
+	SCOPE_CYCLE_COUNTER(STAT_FlowFieldBuild);
+
+	const int32 NumCells = Pending.Size.X * Pending.Size.Y;
+	const int32 End = FMath::Min(NumCells, Pending.Cursor + FMath::Max(1, MaxCells));
+	const FVector HalfCell(Pending.CellSize * 0.5f, Pending.CellSize * 0.5f, 0.0f);
+	for (int32 Index = Pending.Cursor; Index < End; Index++) {
+		const int32 X = Index % Pending.Size.X;
+		const int32 Y = Index / Pending.Size.X;
+		const FVector Center = Pending.Origin + FVector(X * Pending.CellSize, Y * Pending.CellSize, 0.0f) + HalfCell;
+
+		float Height = 0.0f;
+		if (Sampler(Center, Height)) {
+			Pending.Walkable[Index] = 1;
+			Pending.CellHeights[Index] = Height;
+		}
+	}
+	Pending.Cursor = End;
+
+	if (End < NumCells) return false;
+	CommitGrid();
+	return true;
+}
+
+void UFPSFlowField::CommitGrid() {
+	GridOrigin = Pending.Origin;
+	GridSize = Pending.Size;
+	CellSize = Pending.CellSize;
+	CellHeights = MoveTemp(Pending.CellHeights);
+	Walkable = MoveTemp(Pending.Walkable);
+	Pending = FPendingGrid();
+
+	const int32 NumCells = GridSize.X * GridSize.Y;
+	PathCosts.Init(TNumericLimits<float>::Max(), NumCells);
+	Directions.Init(FVector2f::ZeroVector, NumCells);
+	ReachedCells.Reset();
+
+	TargetCell = INDEX_NONE;
+	bNeedsBuild = false;
+}
+
+bool UFPSFlowField::SetTarget(const FVector& TargetLocation) {
+	const int32 Index = GetCellIndex(TargetLocation);
+	if (Index == TargetCell) return false;
+
+	RecomputeField(Index);
+	return true;
+}
+
+int32 UFPSFlowField::GetCellIndex(const FVector& Location) const {
+	if (GridSize.X <= 0) return INDEX_NONE;
+
+	const int32 X = FMath::FloorToInt((Location.X - GridOrigin.X) / CellSize);
+	const int32 Y = FMath::FloorToInt((Location.Y - GridOrigin.Y) / CellSize);
+	if (X < 0 || Y < 0 || X >= GridSize.X || Y >= GridSize.Y) return INDEX_NONE;
+	return Y * GridSize.X + X;
+}
+
+bool UFPSFlowField::CanStep(int32 From, int32 To) const {
+	return Walkable[To] && FMath::Abs(CellHeights[To] - CellHeights[From]) <= MaxStepHeight;
+}
+
+void UFPSFlowField::RecomputeField(int32 TargetIndex) {
+	SCOPE_CYCLE_COUNTER(STAT_FlowFieldRecompute);
+
+	TargetCell = TargetIndex;
+	NumRecomputes++;
+
+	// Cells outside the last pass never held a cost, so clearing is bounded by MaxPathLength and not the grid size
+	for (const int32 Index : ReachedCells) {
+		PathCosts[Index] = TNumericLimits<float>::Max();
+		Directions[Index] = FVector2f::ZeroVector;
+	}
+	ReachedCells.Reset();
+	if (TargetIndex == INDEX_NONE || !Walkable[TargetIndex]) return;
+
+	// Dijkstra outward from the target, costs in cells
+	const float MaxCost = MaxPathLength / CellSize;
+	typedef TPair<float, int32> FOpenCell;
+	TArray<FOpenCell>& Open = OpenCells;
+	Open.Reset();
+	auto Less = [](const FOpenCell& A, const FOpenCell& B) { return A.Key < B.Key; };
+
+	PathCosts[TargetIndex] = 0.0f;
+	Open.HeapPush(FOpenCell(0.0f, TargetIndex), Less);
+
+	while (Open.Num() > 0) {
+		FOpenCell Current;
+		Open.HeapPop(Current, Less);
+		if (Current.Key > PathCosts[Current.Value]) continue;
+		ReachedCells.Add(Current.Value);
+
+		const int32 CX = Current.Value % GridSize.X;
+		const int32 CY = Current.Value / GridSize.X;
+		for (int32 N = 0; N < 8; N++) {
+			const int32 NX = CX + FlowField::NeighbourX[N];
+			const int32 NY = CY + FlowField::NeighbourY[N];
+			if (NX < 0 || NY < 0 || NX >= GridSize.X || NY >= GridSize.Y) continue;
+
+			const int32 Next = NY * GridSize.X + NX;
+			if (!CanStep(Current.Value, Next)) continue;
+
+			// No cutting corners past a wall
+			if (N >= 4 && (!Walkable[CY * GridSize.X + NX] || !Walkable[NY * GridSize.X + CX])) continue;
+
+			const float NewCost = Current.Key + FlowField::NeighbourCost[N];
+			if (NewCost < PathCosts[Next] && NewCost <= MaxCost) {
+				PathCosts[Next] = NewCost;
+				Open.HeapPush(FOpenCell(NewCost, Next), Less);
+			}
+		}
+	}
+
+	// Each reached cell points at its cheapest neighbour
+	for (const int32 Index : ReachedCells) {
+		if (Index == TargetIndex) continue;
+
+		const int32 CX = Index % GridSize.X;
+		const int32 CY = Index / GridSize.X;
+		float BestCost = PathCosts[Index];
+		int32 BestN = INDEX_NONE;
+		for (int32 N = 0; N < 8; N++) {
+			const int32 NX = CX + FlowField::NeighbourX[N];
+			const int32 NY = CY + FlowField::NeighbourY[N];
+			if (NX < 0 || NY < 0 || NX >= GridSize.X || NY >= GridSize.Y) continue;
+
+			const int32 Next = NY * GridSize.X + NX;
+			if (!CanStep(Index, Next)) continue;
+			if (N >= 4 && (!Walkable[CY * GridSize.X + NX] || !Walkable[NY * GridSize.X + CX])) continue;
+
+			if (PathCosts[Next] < BestCost) {
+				BestCost = PathCosts[Next];
+				BestN = N;
+			}
+		}
+
+		if (BestN != INDEX_NONE) {
+			Directions[Index] = FVector2f((float)FlowField::NeighbourX[BestN], (float)FlowField::NeighbourY[BestN]).GetSafeNormal();
+		}
+	}
+
+	SET_DWORD_STAT(STAT_FlowFieldReachedCells, ReachedCells.Num());
+}
+
+void UFPSFlowField::HandleNavigationGenerationFinished(ANavigationData* NavData) {
+	// A grid half sampled from the old navmesh starts over
+	Pending = FPendingGrid();
+	bNeedsBuild = true;
+}
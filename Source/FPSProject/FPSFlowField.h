@@ -0,0 +1,107 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FPSFlowField.generated.h"
+
+class ANavigationData;
+
+/**
+ * Grid flow field toward the player, sampled from the navmesh. The field is recomputed only when the player moves
+ * to another cell, and chasing enemies read their steering direction with a single array lookup, so they go around
+ * walls at O(1) cost per enemy. Sampling the navmesh is spread over several ticks, the previous grid keeps steering
+ * until the new one is complete.
+ */
+UCLASS()
+class FPSPROJECT_API UFPSFlowField : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Unit direction to steer along from Location. Returns false outside the field, in the target's cell, or when
+	// the target cannot be reached from there; callers then steer straight at the target. Safe to call from workers
+	// while the game thread is not ticking this subsystem.
+	bool GetDirection(const FVector& Location, FVector& OutDirection) const;
+
+	// Lays out the grid and asks Sampler for the floor height of every cell center in one go. Sampler returns false
+	// for cells with no floor. Tests use this with their own sampler.
+	void BuildGrid(const FVector& Origin, const FIntPoint& Size, float InCellSize, TFunctionRef<bool(const FVector&, float&)> Sampler);
+
+	// Lays out a grid over the navigable bounds, its cells are projected onto the navmesh by StepNavigationBuild.
+	// Returns false while there is no navmesh or it is still being built.
+	bool BuildFromNavigation();
+
+	// Projects up to BuildCellsPerTick more cells. Returns true when that completed the grid and it replaced the old one.
+	bool StepNavigationBuild();
+
+	bool IsBuilding() const { return Pending.Cursor != INDEX_NONE; }
+
+	// Recomputes the field if the target moved to another cell. Returns true when it did.
+	bool SetTarget(const FVector& TargetLocation);
+
+	bool IsBuilt() const { return Walkable.Num() > 0; }
+	bool IsInsideGrid(const FVector& Location) const { return GetCellIndex(Location) != INDEX_NONE; }
+	int32 GetNumRecomputes() const { return NumRecomputes; }
+
+	float CellSize = 200.0f;
+
+	// Neighbouring cells further apart in height than this are not connected
+	float MaxStepHeight = 75.0f;
+
+	// Cells farther than this from the target (in path length) are left out of the field
+	float MaxPathLength = 20000.0f;
+
+	// Largest grid built from the navmesh, the cell size grows to fit big levels
+	int32 MaxCellsPerAxis = 256;
+
+	// Navmesh projections per tick while building, a full 256x256 grid takes 32 ticks
+	int32 BuildCellsPerTick = 2048;
+
+protected:
+	// A grid being sampled, swapped in once every cell has been visited
+	struct FPendingGrid {
+		FVector Origin = FVector::ZeroVector;
+		FIntPoint Size = FIntPoint::ZeroValue;
+		float CellSize = 0.0f;
+		FVector QueryExtent = FVector::ZeroVector;
+		TArray<float> CellHeights;
+		TArray<uint8> Walkable;
+		int32 Cursor = INDEX_NONE;
+	};
+
+	void BeginGrid(const FVector& Origin, const FIntPoint& Size, float InCellSize);
+	bool SampleCells(int32 MaxCells, TFunctionRef<bool(const FVector&, float&)> Sampler);
+	void CommitGrid();
+
+	int32 GetCellIndex(const FVector& Location) const;
+	bool CanStep(int32 From, int32 To) const;
+	void RecomputeField(int32 TargetIndex);
+
+	UFUNCTION()
+	void HandleNavigationGenerationFinished(ANavigationData* NavData);
+
+	FVector GridOrigin = FVector::ZeroVector;
+	FIntPoint GridSize = FIntPoint::ZeroValue;
+
+	TArray<float> CellHeights;
+	TArray<uint8> Walkable;
+	TArray<float> PathCosts;
+	TArray<FVector2f> Directions;
+
+	// Cells the last recompute gave a cost, the next one only has to clear these
+	TArray<int32> ReachedCells;
+	TArray<TPair<float, int32>> OpenCells;
+
+	FPendingGrid Pending;
+
+	int32 TargetCell = INDEX_NONE;
+	int32 NumRecomputes = 0;
+	bool bNeedsBuild = true;
+};
@@ -2,17 +2,31 @@
 
 
 #include "FPSHUD.h"
+#include "FPSProject.h"
 #include "Engine/Texture2D.h"
 #include "Engine/Engine.h"
 #include "Engine/World.h"
 #include "Engine/Canvas.h"
 #include "CanvasItem.h"
+#include "TimerManager.h"
 #include "FPSWeaponBase.h"
 #include "FPSCharacter.h"
 
+DECLARE_CYCLE_STAT(TEXT("HUD Draw"), STAT_HUDDraw, STATGROUP_FPSProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HUD Text Rebuilds"), STAT_HUDTextRebuilds, STATGROUP_FPSProject);
+
+void AFPSHUD::EndPlay(const EEndPlayReason::Type EndPlayReason) {
+	BindToPlayer(nullptr);
+	GetWorldTimerManager().ClearTimer(AchievementTimerHandle);
+	Super::EndPlay(EndPlayReason);
+}
+
 void AFPSHUD::DrawHUD() {
 	Super::DrawHUD();
 
+	SCOPE_CYCLE_COUNTER(STAT_HUDDraw);
+	const double StartTime = FPlatformTime::Seconds();
+
 	// Crosshair
 	if (CrosshairTexture && Canvas) {
 		const FVector2D Center(Canvas->ClipX * 0.5f, Canvas->ClipY * 0.5f);
@@ -24,54 +38,119 @@ void AFPSHUD::DrawHUD() {
 		Canvas->DrawIcon(Icon, X, Y);
 	}
 
-	// Health
 	AFPSCharacter* Player = Cast<AFPSCharacter>(GetOwningPawn());
-	if (Player) {
-		FString HealthStr = FString::Printf(TEXT("HP: %.0f"), Player->GetCurrentHealth());
-		FVector2D HealthPos(1300.f, 50.f);
-		FCanvasTextItem TextItem(HealthPos, FText::FromString(HealthStr), GEngine->GetLargeFont(), FLinearColor::White);
-		TextItem.Scale = FVector2D(3.0f, 3.0f);
-		Canvas->DrawItem(TextItem);
+	if (Player != BoundPlayer.Get()) {
+		BindToPlayer(Player);
 	}
 
-	//Ammo
 	if (Player) {
+		if (!bRetainedHUD) {
+			bHealthDirty = bAmmoDirty = bInventoryDirty = true;
+		}
+		RebuildTexts(Player);
+
+		// Health
+		FCanvasTextItem HealthItem(FVector2D(1300.f, 50.f), HealthText, GEngine->GetLargeFont(), FLinearColor::White);
+		HealthItem.Scale = FVector2D(3.0f, 3.0f);
+		Canvas->DrawItem(HealthItem);
+
+		//Ammo
 		if (Player->GetEquippedWeapon()) {
-			int32 CurrentBullets = Player->GetEquippedWeapon()->BulletsInMag;
-			int32 ReserveBullets = Player->GetEquippedWeapon()->GetTotalReserveBullets();
-			LastDrawnAmmoString = FString::Printf(TEXT("%d / %d"), CurrentBullets, ReserveBullets);
-			Canvas->DrawText(GEngine->GetLargeFont(), LastDrawnAmmoString, 50.f, 80.f);
+			FCanvasTextItem AmmoItem(FVector2D(50.f, 80.f), AmmoText, GEngine->GetLargeFont(), FLinearColor::White);
+			Canvas->DrawItem(AmmoItem);
 		}
-	}
 
-	//Inventory
-	if (Player) {
-		FString InvString = FString::Printf(TEXT("Red Ruby: %d     |     Blue Sapphire: %d"), Player->RedRubyCount, Player->BlueSapphireCount);
-		float X = Canvas->ClipX * 0.5f - 150.0f;
-		float Y = Canvas->ClipY - 120.0f; 
-		FVector2D TextPos(X, Y);
-		FCanvasTextItem TextItem(TextPos, FText::FromString(InvString), GEngine->GetLargeFont(), FLinearColor::White);
-		TextItem.Scale = FVector2D(2.f, 2.f);
-		Canvas->DrawItem(TextItem);
+		//Inventory
+		FCanvasTextItem InventoryItem(FVector2D(Canvas->ClipX * 0.5f - 150.0f, Canvas->ClipY - 120.0f), InventoryText, GEngine->GetLargeFont(), FLinearColor::White);
+		InventoryItem.Scale = FVector2D(2.f, 2.f);
+		Canvas->DrawItem(InventoryItem);
 	}
 
 	//Achievement
-	if (AchievementTimer > 0.0f) {
-		float X = Canvas->ClipX * 0.5f - 200.f;
-		float Y = Canvas->ClipY * 0.25f;
-		FCanvasTextItem TextItem(FVector2D(X, Y),
-			FText::FromString("Achievement: " + AchievementMessage),
-			GEngine->GetLargeFont(),
-			FLinearColor::Yellow);
+	if (bShowAchievement) {
+		FCanvasTextItem TextItem(FVector2D(Canvas->ClipX * 0.5f - 200.f, Canvas->ClipY * 0.25f), AchievementText, GEngine->GetLargeFont(), FLinearColor::Yellow);
 		TextItem.Scale = FVector2D(2.0f, 2.0f);
 		Canvas->DrawItem(TextItem);
-
-		AchievementTimer -= GetWorld()->GetDeltaSeconds();
-		if (AchievementTimer < 0.f) AchievementTimer = 0.f;
 	}
+
+	DrawSeconds += FPlatformTime::Seconds() - StartTime;
+	DrawCount++;
 }
 
 void AFPSHUD::ShowAchievement(const FString& Message) {
-	AchievementMessage = Message;
-	AchievementTimer = 2.0f;
-}
\ No newline at end of file
+	AchievementText = FText::FromString("Achievement: " + Message);
+	bShowAchievement = true;
+
+	// Hidden by a timer, the draw pass never counts time down
+	GetWorldTimerManager().SetTimer(AchievementTimerHandle, this, &AFPSHUD::HideAchievement, 2.0f, false);
+}
+
+void AFPSHUD::HideAchievement() {
+	bShowAchievement = false;
+}
+
+void AFPSHUD::ResetDrawStats() {
+	DrawSeconds = 0.0;
+	DrawCount = 0;
+	NumTextRebuilds = 0;
+}
+
+void AFPSHUD::BindToPlayer(AFPSCharacter* Player) {
+	if (AFPSCharacter* Old = BoundPlayer.Get()) {
+		Old->OnHealthChanged.RemoveAll(this);
+		Old->OnInventoryChanged.RemoveAll(this);
+		Old->OnEquippedWeaponChanged.RemoveAll(this);
+	}
+
+	BoundPlayer = Player;
+	if (Player) {
+		Player->OnHealthChanged.AddUObject(this, &AFPSHUD::HandleHealthChanged);
+		Player->OnInventoryChanged.AddUObject(this, &AFPSHUD::HandleInventoryChanged);
+		Player->OnEquippedWeaponChanged.AddUObject(this, &AFPSHUD::HandleEquippedWeaponChanged);
+	}
+	BindToWeapon(Player ? Player->GetEquippedWeapon() : nullptr);
+
+	bHealthDirty = bAmmoDirty = bInventoryDirty = true;
+}
+
+void AFPSHUD::BindToWeapon(AFPSWeaponBase* Weapon) {
+	if (AFPSWeaponBase* Old = BoundWeapon.Get()) {
+		Old->OnAmmoChanged.RemoveAll(this);
+	}
+
+	BoundWeapon = Weapon;
+	if (Weapon) {
+		Weapon->OnAmmoChanged.AddUObject(this, &AFPSHUD::HandleAmmoChanged);
+	}
+	bAmmoDirty = true;
+}
+
+void AFPSHUD::HandleEquippedWeaponChanged(AFPSCharacter* Player) {
+	BindToWeapon(Player ? Player->GetEquippedWeapon() : nullptr);
+}
+
+void AFPSHUD::RebuildTexts(AFPSCharacter* Player) {
+	if (bHealthDirty) {
+		HealthText = FText::FromString(FString::Printf(TEXT("HP: %.0f"), Player->GetCurrentHealth()));
+		bHealthDirty = false;
+		NumTextRebuilds++;
+		INC_DWORD_STAT(STAT_HUDTextRebuilds);
+	}
+
+	if (bAmmoDirty) {
+		if (const AFPSWeaponBase* Weapon = Player->GetEquippedWeapon()) {
+			LastDrawnAmmoString = FString::Printf(TEXT("%d / %d"), Weapon->BulletsInMag, Weapon->GetTotalReserveBullets());
+			AmmoText = FText::FromString(LastDrawnAmmoString);
+			NumTextRebuilds++;
+			INC_DWORD_STAT(STAT_HUDTextRebuilds);
+		}
+		bAmmoDirty = false;
+	}
+
+	if (bInventoryDirty) {
+		InventoryText = FText::FromString(FString::Printf(TEXT("Red Ruby: %d     |     Blue Sapphire: %d"), Player->RedRubyCount, Player->BlueSapphireCount));
+		bInventoryDirty = false;
+		NumTextRebuilds++;
+		INC_DWORD_STAT(STAT_HUDTextRebuilds);
+	}
+}
@@ -7,11 +7,13 @@
 #include "Engine/Canvas.h"
 
 class AFPSCharacter;
+class AFPSWeaponBase;
 
 #include "FPSHUD.generated.h"
 
 /**
- * 
+ * Retained canvas HUD. Texts are formatted once when the player or weapon reports a change and drawn from the cache
+ * every frame after that.
  */
 UCLASS()
 class FPSPROJECT_API AFPSHUD : public AHUD
@@ -23,14 +25,53 @@ protected:
 	UPROPERTY(EditDefaultsOnly)
 	UTexture2D* CrosshairTexture;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:
 	virtual void DrawHUD() override;
 	void ShowAchievement(const FString& Message);
 
+	bool IsShowingAchievement() const { return bShowAchievement; }
+
 	UPROPERTY(BlueprintReadOnly)
 	FString LastDrawnAmmoString;
 
+	// Off re-formats every text each frame like the old HUD, for comparing frame cost in the performance suite
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HUD")
+	bool bRetainedHUD = true;
+
+	// Times each text was formatted, stays flat while nothing changes
+	int32 NumTextRebuilds = 0;
+
+	double GetAverageDrawMs() const { return DrawCount > 0 ? DrawSeconds * 1000.0 / DrawCount : 0.0; }
+	void ResetDrawStats();
+
 protected:
-	FString AchievementMessage;
-	float AchievementTimer = 0.0f;
+	void BindToPlayer(AFPSCharacter* Player);
+	void BindToWeapon(AFPSWeaponBase* Weapon);
+	void RebuildTexts(AFPSCharacter* Player);
+	void HideAchievement();
+
+	void HandleHealthChanged(AFPSCharacter* Player) { bHealthDirty = true; }
+	void HandleInventoryChanged(AFPSCharacter* Player) { bInventoryDirty = true; }
+	void HandleEquippedWeaponChanged(AFPSCharacter* Player);
+	void HandleAmmoChanged(AFPSWeaponBase* Weapon) { bAmmoDirty = true; }
+
+	TWeakObjectPtr<AFPSCharacter> BoundPlayer;
+	TWeakObjectPtr<AFPSWeaponBase> BoundWeapon;
+
+	bool bHealthDirty = true;
+	bool bAmmoDirty = true;
+	bool bInventoryDirty = true;
+
+	FText HealthText;
+	FText AmmoText;
+	FText InventoryText;
+	FText AchievementText;
+
+	bool bShowAchievement = false;
+	FTimerHandle AchievementTimerHandle;
+
+	double DrawSeconds = 0.0;
+	int32 DrawCount = 0;
 };
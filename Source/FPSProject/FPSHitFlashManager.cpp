@@ -0,0 +1,106 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FPSHitFlashManager.h"
+#include "FPSProject.h"
+#include "Components/PrimitiveComponent.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+DECLARE_CYCLE_STAT(TEXT("Hit Flash Update"), STAT_HitFlashUpdate, STATGROUP_FPSProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Active Hit Flashes"), STAT_ActiveHitFlashes, STATGROUP_FPSProject);
+
+void UFPSHitFlashManager::Deinitialize() {
+	Flashes.Empty();
+	FlashIndices.Empty();
+	Super::Deinitialize();
+}
+
+TStatId UFPSHitFlashManager::GetStatId() const {
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFPSHitFlashManager, STATGROUP_Tickables);
+}
+
+void UFPSHitFlashManager::StartFlash(UPrimitiveComponent* Component, UMaterialInstanceDynamic* Material) {
+	if (!Component) return;
+
+	FActiveFlash* Flash = nullptr;
+	if (const int32* Existing = FlashIndices.Find(Component)) {
+		Flash = &Flashes[*Existing];
+	}
+	else {
+		FlashIndices.Add(Component, Flashes.Num());
+		Flash = &Flashes.AddDefaulted_GetRef();
+		Flash->Component = Component;
+	}
+	Flash->Material = Material;
+	Flash->Remaining = FlashDuration;
+
+	if (Material) {
+		Material->SetVectorParameterValue(ColorParameter, FlashColor);
+	}
+	else {
+		Component->SetCustomPrimitiveDataFloat(FlashDataIndex, 1.0f);
+	}
+}
+
+void UFPSHitFlashManager::StopFlash(UPrimitiveComponent* Component) {
+	if (!Component) return;
+
+	if (const int32* Existing = FlashIndices.Find(Component)) {
+		const int32 Index = *Existing;
+		EndFlash(Flashes[Index], Component);
+		RemoveFlash(Index);
+	}
+	else {
+		Component->SetCustomPrimitiveDataFloat(FlashDataIndex, 0.0f);
+	}
+}
+
+void UFPSHitFlashManager::Tick(float DeltaTime) {
+	SET_DWORD_STAT(STAT_ActiveHitFlashes, Flashes.Num());
+	if (Flashes.Num() == 0) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_HitFlashUpdate);
+
+	const float InvDuration = FlashDuration > 0.0f ? 1.0f / FlashDuration : 0.0f;
+
+	// Walk backwards so swap-removing a finished flash never skips one
+	for (int32 i = Flashes.Num() - 1; i >= 0; i--) {
+		FActiveFlash& Flash = Flashes[i];
+		UPrimitiveComponent* Component = Flash.Component.ResolveObjectPtr();
+		if (!Component) {
+			RemoveFlash(i);
+			continue;
+		}
+
+		Flash.Remaining -= DeltaTime;
+		if (Flash.Remaining <= 0.0f) {
+			EndFlash(Flash, Component);
+			RemoveFlash(i);
+			continue;
+		}
+
+		// A tinted material holds its color until the end, there is nothing to fade
+		if (!Flash.Material.IsValid()) {
+			Component->SetCustomPrimitiveDataFloat(FlashDataIndex, Flash.Remaining * InvDuration);
+		}
+	}
+}
+
+void UFPSHitFlashManager::EndFlash(const FActiveFlash& Flash, UPrimitiveComponent* Component) const {
+	if (UMaterialInstanceDynamic* Material = Flash.Material.Get()) {
+		Material->SetVectorParameterValue(ColorParameter, RestColor);
+	}
+	else {
+		Component->SetCustomPrimitiveDataFloat(FlashDataIndex, 0.0f);
+	}
+}
+
+void UFPSHitFlashManager::RemoveFlash(int32 Index) {
+	FlashIndices.Remove(Flashes[Index].Component);
+
+	const int32 Last = Flashes.Num() - 1;
+	if (Index != Last) {
+		FlashIndices.Add(Flashes[Last].Component, Index);
+	}
+	Flashes.RemoveAtSwap(Index);
+}
@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "FPSHitFlashManager.generated.h"
+
+class UPrimitiveComponent;
+class UMaterialInstanceDynamic;
+
+/**
+ * Drives the enemy hit flash through custom primitive data, so enemies share their material instead of each owning
+ * a dynamic instance and a timer. Active flashes live in one compact array and all fade together in a single tick.
+ * The enemy material reads the flash intensity (1 on hit, fading to 0) from custom primitive data at FlashDataIndex.
+ * Components whose material does not read it yet pass a dynamic instance instead, which is tinted for the duration.
+ */
+UCLASS()
+class FPSPROJECT_API UFPSHitFlashManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Restarts the flash at full intensity if the component is already flashing. With a Material, its ColorParameter
+	// is set to FlashColor until the flash ends and the custom primitive data is left alone.
+	void StartFlash(UPrimitiveComponent* Component, UMaterialInstanceDynamic* Material = nullptr);
+	void StopFlash(UPrimitiveComponent* Component);
+
+	int32 GetNumActiveFlashes() const { return Flashes.Num(); }
+
+	float FlashDuration = 0.2f;
+	int32 FlashDataIndex = 0;
+
+	FName ColorParameter = TEXT("BaseColor");
+	FLinearColor FlashColor = FLinearColor::Red;
+	FLinearColor RestColor = FLinearColor::White;
+
+protected:
+	struct FActiveFlash {
+		TObjectKey<UPrimitiveComponent> Component;
+		TWeakObjectPtr<UMaterialInstanceDynamic> Material;
+		float Remaining = 0.0f;
+	};
+
+	void EndFlash(const FActiveFlash& Flash, UPrimitiveComponent* Component) const;
+	void RemoveFlash(int32 Index);
+
+	TArray<FActiveFlash> Flashes;
+	TMap<TObjectKey<UPrimitiveComponent>, int32> FlashIndices;
+};
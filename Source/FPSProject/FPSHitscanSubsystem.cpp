@@ -0,0 +1,116 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FPSHitscanSubsystem.h"
+#include "FPSProject.h"
+#include "FPSDamageQueue.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Hitscan Batch"), STAT_HitscanBatch, STATGROUP_FPSProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hitscan Traces"), STAT_HitscanTraces, STATGROUP_FPSProject);
+
+void UFPSHitscanSubsystem::Deinitialize() {
+	Queued.Empty();
+	InFlight.Empty();
+	Super::Deinitialize();
+}
+
+void UFPSHitscanSubsystem::Reset() {
+	Queued.Reset();
+	InFlight.Reset();
+}
+
+TStatId UFPSHitscanSubsystem::GetStatId() const {
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFPSHitscanSubsystem, STATGROUP_Tickables);
+}
+
+void UFPSHitscanSubsystem::Tick(float DeltaTime) {
+	ResolveTraces();
+}
+
+void UFPSHitscanSubsystem::QueueTrace(const FVector& Start, const FVector& End, float Damage, AActor* Instigator) {
+	FHitscanTrace& Trace = Queued.AddDefaulted_GetRef();
+	Trace.Start = Start;
+	Trace.End = End;
+	Trace.Damage = Damage;
+	Trace.Instigator = Instigator;
+}
+
+void UFPSHitscanSubsystem::QueueShot(const FVector& Start, const FVector& Direction, float Range, int32 PelletCount, float SpreadDegrees, float Damage, AActor* Instigator) {
+	const FVector Aim = Direction.GetSafeNormal();
+	const float HalfAngle = FMath::DegreesToRadians(FMath::Max(0.0f, SpreadDegrees));
+
+	for (int32 i = 0; i < FMath::Max(1, PelletCount); i++) {
+		const FVector PelletDirection = HalfAngle > 0.0f ? FMath::VRandCone(Aim, HalfAngle) : Aim;
+		QueueTrace(Start, Start + PelletDirection * Range, Damage, Instigator);
+	}
+}
+
+void UFPSHitscanSubsystem::ResolveTraces() {
+	if (Queued.Num() == 0 && InFlight.Num() == 0) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_HitscanBatch);
+
+	// Last frame's async traces still land when async was switched off since
+	ResolveAsync();
+
+	if (bAsyncTraces) {
+		IssueAsync();
+	}
+	else {
+		TraceImmediate();
+	}
+}
+
+void UFPSHitscanSubsystem::TraceImmediate() {
+	if (Queued.Num() == 0) return;
+
+	INC_DWORD_STAT_BY(STAT_HitscanTraces, Queued.Num());
+
+	UWorld* World = GetWorld();
+	FHitResult Hit;
+	for (const FHitscanTrace& Trace : Queued) {
+		const FCollisionQueryParams Params(SCENE_QUERY_STAT(HitscanTrace), false, Trace.Instigator.Get());
+		if (World->LineTraceSingleByProfile(Hit, Trace.Start, Trace.End, CollisionProfile, Params)) {
+			ApplyHit(Trace, Hit);
+		}
+	}
+	Queued.Reset();
+}
+
+void UFPSHitscanSubsystem::ResolveAsync() {
+	UWorld* World = GetWorld();
+	for (const FInFlightTrace& Pending : InFlight) {
+		FTraceDatum Datum;
+		if (!World->QueryTraceData(Pending.Handle, Datum)) continue;
+
+		for (const FHitResult& Hit : Datum.OutHits) {
+			if (Hit.bBlockingHit) {
+				ApplyHit(Pending.Trace, Hit);
+				break;
+			}
+		}
+	}
+	InFlight.Reset();
+}
+
+void UFPSHitscanSubsystem::IssueAsync() {
+	INC_DWORD_STAT_BY(STAT_HitscanTraces, Queued.Num());
+
+	UWorld* World = GetWorld();
+	for (const FHitscanTrace& Trace : Queued) {
+		const FCollisionQueryParams Params(SCENE_QUERY_STAT(HitscanAsyncTrace), false, Trace.Instigator.Get());
+
+		FInFlightTrace& Pending = InFlight.AddDefaulted_GetRef();
+		Pending.Trace = Trace;
+		Pending.Handle = World->AsyncLineTraceByProfile(EAsyncTraceType::Single, Trace.Start, Trace.End, CollisionProfile, Params);
+	}
+	Queued.Reset();
+}
+
+void UFPSHitscanSubsystem::ApplyHit(const FHitscanTrace& Trace, const FHitResult& Hit) {
+	// Knocked back from where the shot landed
+	if (UFPSDamageQueue* DamageQueue = GetWorld()->GetSubsystem<UFPSDamageQueue>()) {
+		DamageQueue->QueueImpact(Hit.GetActor(), Hit.Location, Trace.Damage, KnockbackStrength, Trace.Instigator.Get());
+	}
+}
@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "FPSDamageQueue.h"
+#include "FPSHitscanSubsystem.generated.h"
+
+struct FHitscanTrace {
+	FVector Start = FVector::ZeroVector;
+	FVector End = FVector::ZeroVector;
+	float Damage = 0.0f;
+	TWeakObjectPtr<AActor> Instigator;
+};
+
+/**
+ * Resolves hitscan shots for every weapon in one batch per frame. Weapons queue their traces when they fire, and the
+ * batch runs them on the game thread, or as async traces that land the next frame. Hits go through UFPSDamageQueue with the
+ * same damage, knockback and kill handling as AFPSProjectile::OnHit.
+ */
+UCLASS()
+class FPSPROJECT_API UFPSHitscanSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void QueueTrace(const FVector& Start, const FVector& End, float Damage, AActor* Instigator);
+
+	// Queues PelletCount traces spread inside a cone of SpreadDegrees (half angle) around Direction
+	void QueueShot(const FVector& Start, const FVector& Direction, float Range, int32 PelletCount, float SpreadDegrees, float Damage, AActor* Instigator);
+
+	// Runs everything queued so far. Tick calls this, tests call it directly.
+	void ResolveTraces();
+
+	// Drops queued and in flight traces without applying them
+	void Reset();
+
+	int32 GetNumQueued() const { return Queued.Num(); }
+	int32 GetNumInFlight() const { return InFlight.Num(); }
+
+	FName CollisionProfile = TEXT("Projectile");
+	float KnockbackStrength = UFPSDamageQueue::ImpactKnockbackStrength;
+	bool bAsyncTraces = false;
+
+protected:
+	struct FInFlightTrace {
+		FHitscanTrace Trace;
+		FTraceHandle Handle;
+	};
+
+	void TraceImmediate();
+	void ResolveAsync();
+	void IssueAsync();
+	void ApplyHit(const FHitscanTrace& Trace, const FHitResult& Hit);
+
+	TArray<FHitscanTrace> Queued;
+	TArray<FInFlightTrace> InFlight;
+};
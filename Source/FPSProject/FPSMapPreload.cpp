@@ -0,0 +1,11 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FPSMapPreload.h"
+
+const FPrimaryAssetType UFPSMapPreload::PrimaryAssetType(TEXT("MapPreload"));
+const FName UFPSMapPreload::BundleName(TEXT("Preload"));
+
+FPrimaryAssetId UFPSMapPreload::GetPrimaryAssetId() const {
+	return FPrimaryAssetId(PrimaryAssetType, GetFName());
+}
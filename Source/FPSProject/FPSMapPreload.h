@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "FPSMapPreload.generated.h"
+
+/**
+ * Assets a map needs soon after it opens, loaded in the background by UFPSAssetPreloader while the map loads.
+ * Name the asset after its map (e.g. FPSMap) and keep it under /Game/Preload so the asset manager finds it.
+ */
+UCLASS(BlueprintType)
+class FPSPROJECT_API UFPSMapPreload : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	static const FPrimaryAssetType PrimaryAssetType;
+	static const FName BundleName;
+
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
+	// Meshes, materials, sounds and the like that are spawned or swapped in during play
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (AssetBundles = "Preload"))
+	TArray<TSoftObjectPtr<UObject>> Assets;
+
+	// Blueprint classes spawned at runtime, e.g. weapons and enemies, which otherwise load on their first spawn
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (AssetBundles = "Preload"))
+	TArray<TSoftClassPtr<AActor>> Classes;
+};
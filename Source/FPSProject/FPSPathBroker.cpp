@@ -0,0 +1,149 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FPSPathBroker.h"
+#include "FPSProject.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Path Broker"), STAT_PathBroker, STATGROUP_FPSProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Path Queries"), STAT_PathQueries, STATGROUP_FPSProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Path Requests Merged"), STAT_PathRequestsMerged, STATGROUP_FPSProject);
+
+void UFPSPathBroker::Deinitialize() {
+	if (UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld())) {
+		for (const FPathRequest& Request : InFlight) {
+			NavSys->AbortAsyncFindPathRequest(Request.QueryId);
+		}
+	}
+	Queued.Empty();
+	InFlight.Empty();
+	Super::Deinitialize();
+}
+
+TStatId UFPSPathBroker::GetStatId() const {
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFPSPathBroker, STATGROUP_Tickables);
+}
+
+void UFPSPathBroker::Tick(float DeltaTime) {
+	ProcessQueue();
+}
+
+bool UFPSPathBroker::IsSameGoal(const FVector& A, const FVector& B) const {
+	return FVector::DistSquared(A, B) <= FMath::Square(MergeTolerance);
+}
+
+void UFPSPathBroker::RequestPath(AActor* Agent, const FVector& Goal, FOnBrokeredPath OnPathReady) {
+	if (!Agent) return;
+
+	if (FPathRequest* Pending = Queued.FindByPredicate([Agent](const FPathRequest& Request) { return Request.Agent.Get() == Agent; })) {
+		if (IsSameGoal(Pending->Goal, Goal)) {
+			NumMerged++;
+			INC_DWORD_STAT(STAT_PathRequestsMerged);
+		}
+
+		// Keeps its place in the queue, only the goal moves
+		Pending->Goal = Goal;
+		Pending->OnPathReady = MoveTemp(OnPathReady);
+		return;
+	}
+
+	const int32 InFlightIndex = InFlight.IndexOfByPredicate([Agent](const FPathRequest& Request) { return Request.Agent.Get() == Agent; });
+	if (InFlightIndex != INDEX_NONE) {
+		FPathRequest& Running = InFlight[InFlightIndex];
+		if (IsSameGoal(Running.Goal, Goal)) {
+			NumMerged++;
+			INC_DWORD_STAT(STAT_PathRequestsMerged);
+			Running.OnPathReady = MoveTemp(OnPathReady);
+			return;
+		}
+
+		// A path to the old goal is of no use any more
+		if (UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld())) {
+			NavSys->AbortAsyncFindPathRequest(Running.QueryId);
+		}
+		InFlight.RemoveAtSwap(InFlightIndex);
+	}
+
+	FPathRequest& Request = Queued.AddDefaulted_GetRef();
+	Request.Agent = Agent;
+	Request.Goal = Goal;
+	Request.OnPathReady = MoveTemp(OnPathReady);
+}
+
+void UFPSPathBroker::CancelRequest(const AActor* Agent) {
+	Queued.RemoveAll([Agent](const FPathRequest& Request) { return Request.Agent.Get() == Agent; });
+
+	const int32 InFlightIndex = InFlight.IndexOfByPredicate([Agent](const FPathRequest& Request) { return Request.Agent.Get() == Agent; });
+	if (InFlightIndex == INDEX_NONE) return;
+
+	if (UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld())) {
+		NavSys->AbortAsyncFindPathRequest(InFlight[InFlightIndex].QueryId);
+	}
+	InFlight.RemoveAtSwap(InFlightIndex);
+}
+
+bool UFPSPathBroker::HasRequest(const AActor* Agent) const {
+	auto IsAgent = [Agent](const FPathRequest& Request) { return Request.Agent.Get() == Agent; };
+	return Queued.ContainsByPredicate(IsAgent) || InFlight.ContainsByPredicate(IsAgent);
+}
+
+void UFPSPathBroker::ProcessQueue() {
+	if (Queued.Num() == 0) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_PathBroker);
+
+	UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld());
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : nullptr;
+
+	// Oldest first, so an agent waits at most a few frames however many others keep asking
+	const int32 Budget = FMath::Min(FMath::Max(1, QueriesPerFrame), Queued.Num());
+	TArray<FPathRequest> Issuing(Queued.GetData(), Budget);
+	Queued.RemoveAt(0, Budget);
+
+	for (FPathRequest& Request : Issuing) {
+		AActor* Agent = Request.Agent.Get();
+		if (!IsValid(Agent)) continue;
+
+		// No navmesh is reported like an unreachable goal, so the agent falls back on its own recovery
+		if (!NavData) {
+			Request.OnPathReady.ExecuteIfBound(TArray<FVector>(), false);
+			continue;
+		}
+
+		// The same query FindPathToLocationSynchronously would build, started from where the agent stands now
+		const FVector Start = Agent->GetActorLocation();
+		FPathFindingQuery Query(Agent, *NavData, Start, Request.Goal, UNavigationQueryFilter::GetQueryFilter(*NavData, Agent, nullptr));
+		Request.QueryId = NavSys->FindPathAsync(NavData->GetConfig(), Query, FNavPathQueryDelegate::CreateUObject(this, &UFPSPathBroker::HandlePathFound), EPathFindingMode::Regular);
+		if (Request.QueryId == INVALID_NAVQUERYID) {
+			Request.OnPathReady.ExecuteIfBound(TArray<FVector>(), false);
+			continue;
+		}
+
+		InFlight.Add(MoveTemp(Request));
+		INC_DWORD_STAT(STAT_PathQueries);
+	}
+}
+
+void UFPSPathBroker::HandlePathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path) {
+	const int32 Index = InFlight.IndexOfByPredicate([QueryId](const FPathRequest& Request) { return Request.QueryId == QueryId; });
+
+	// Replaced or cancelled after it was issued
+	if (Index == INDEX_NONE) return;
+
+	FOnBrokeredPath OnPathReady = MoveTemp(InFlight[Index].OnPathReady);
+	InFlight.RemoveAtSwap(Index);
+
+	TArray<FVector> Points;
+	if (Result == ENavigationQueryResult::Success && Path.IsValid()) {
+		Points.Reserve(Path->GetPathPoints().Num());
+		for (const FNavPathPoint& Point : Path->GetPathPoints()) {
+			Points.Add(Point.Location);
+		}
+	}
+
+	// The callback may ask for the next path straight away, so the entry is gone before it runs
+	OnPathReady.ExecuteIfBound(Points, Points.Num() > 1);
+}
@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NavigationSystemTypes.h"
+#include "FPSPathBroker.generated.h"
+
+// Path points from the agent to the goal, empty when no path was found
+DECLARE_DELEGATE_TwoParams(FOnBrokeredPath, const TArray<FVector>& /*Points*/, bool /*bSuccess*/);
+
+/**
+ * Queues path requests and runs them through the navigation system's async pathfinding, at most QueriesPerFrame new
+ * queries a frame. Each agent has at most one request: asking again for the same goal merges into the pending one,
+ * asking for another goal replaces it. Callers keep following their old path until the callback delivers the new one.
+ */
+UCLASS()
+class FPSPROJECT_API UFPSPathBroker : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// The path starts wherever Agent stands when the query is issued, not where it stood when asking
+	void RequestPath(AActor* Agent, const FVector& Goal, FOnBrokeredPath OnPathReady);
+	void CancelRequest(const AActor* Agent);
+
+	bool HasRequest(const AActor* Agent) const;
+
+	// Issues queued queries up to the budget. Tick calls this, tests call it directly.
+	void ProcessQueue();
+
+	int32 GetNumQueued() const { return Queued.Num(); }
+	int32 GetNumInFlight() const { return InFlight.Num(); }
+	int32 GetNumMerged() const { return NumMerged; }
+
+	int32 QueriesPerFrame = 4;
+
+	// Goals closer than this count as the same target
+	float MergeTolerance = 50.0f;
+
+protected:
+	struct FPathRequest {
+		TWeakObjectPtr<AActor> Agent;
+		FVector Goal = FVector::ZeroVector;
+		FOnBrokeredPath OnPathReady;
+		uint32 QueryId = INVALID_NAVQUERYID;
+	};
+
+	void HandlePathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path);
+	bool IsSameGoal(const FVector& A, const FVector& B) const;
+
+	TArray<FPathRequest> Queued;
+	TArray<FPathRequest> InFlight;
+
+	int32 NumMerged = 0;
+};
@@ -0,0 +1,243 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FPSPickupField.h"
+#include "FPSProject.h"
+#include "PickupBase.h"
+#include "FPSCharacter.h"
+#include "FPSPopulationDirector.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+DECLARE_CYCLE_STAT(TEXT("Pickup Collection"), STAT_PickupCollection, STATGROUP_FPSProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pickup Records"), STAT_PickupRecords, STATGROUP_FPSProject);
+
+void UFPSPickupField::Deinitialize() {
+	if (UWorld* World = GetWorld()) {
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+	RemoveAll();
+	Characters.Reset();
+	Types.Reset();
+	InstanceComponents.Reset();
+	InstanceHost = nullptr;
+	Super::Deinitialize();
+}
+
+TStatId UFPSPickupField::GetStatId() const {
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFPSPickupField, STATGROUP_Tickables);
+}
+
+void UFPSPickupField::OnWorldBeginPlay(UWorld& InWorld) {
+	Super::OnWorldBeginPlay(InWorld);
+
+	for (TActorIterator<AFPSCharacter> It(&InWorld); It; ++It) {
+		Characters.AddUnique(*It);
+	}
+	ActorSpawnedHandle = InWorld.AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UFPSPickupField::HandleActorSpawned));
+}
+
+void UFPSPickupField::HandleActorSpawned(AActor* Actor) {
+	if (AFPSCharacter* Character = Cast<AFPSCharacter>(Actor)) {
+		Characters.AddUnique(Character);
+	}
+}
+
+void UFPSPickupField::Tick(float DeltaTime) {
+	if (NumPickups == 0) return;
+
+	CharacterBuffer.Reset();
+	for (int32 i = Characters.Num() - 1; i >= 0; i--) {
+		if (AFPSCharacter* Character = Characters[i].Get()) {
+			CharacterBuffer.Add(Character);
+		}
+		else {
+			Characters.RemoveAtSwap(i);
+		}
+	}
+	CollectPickups(CharacterBuffer);
+}
+
+bool UFPSPickupField::AddPickup(TSubclassOf<APickupBase> PickupClass, const FVector& Location) {
+	if (!PickupClass) return false;
+
+	const int32 TypeIndex = FindOrAddType(PickupClass);
+	FPickupType& Type = Types[TypeIndex];
+
+	const FTransform InstanceTransform = Type.MeshTransform * FTransform(Location);
+	int32 Slot;
+	if (Type.FreeSlots.Num() > 0) {
+		Slot = Type.FreeSlots.Pop();
+		Type.Locations[Slot] = Location;
+		Type.Alive[Slot] = 1;
+		if (Type.Instances) {
+			Type.Instances->UpdateInstanceTransform(Slot, InstanceTransform, true, true, true);
+		}
+	}
+	else {
+		Slot = Type.Locations.Add(Location);
+		Type.Alive.Add(1);
+		if (Type.Instances) {
+			Type.Instances->AddInstance(InstanceTransform, true);
+		}
+	}
+
+	Grid.FindOrAdd(CellOf(Location)).Add({ TypeIndex, Slot });
+	Type.NumAlive++;
+	NumPickups++;
+	if (UFPSPopulationDirector* Director = GetWorld()->GetSubsystem<UFPSPopulationDirector>()) {
+		Director->RegisterRecords(PickupClass);
+	}
+	SET_DWORD_STAT(STAT_PickupRecords, NumPickups);
+	return true;
+}
+
+int32 UFPSPickupField::CollectPickups(const TArray<AFPSCharacter*>& Characters) {
+	if (NumPickups == 0) return 0;
+
+	SCOPE_CYCLE_COUNTER(STAT_PickupCollection);
+
+	const FTransform Hidden(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector);
+	int32 Collected = 0;
+	for (AFPSCharacter* Character : Characters) {
+		if (!IsValid(Character)) continue;
+
+		// Same test as the old overlap sphere against the character's capsule
+		const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+		const float CapsuleRadius = Capsule ? Capsule->GetScaledCapsuleRadius() : 0.0f;
+		const float CapsuleHalfHeight = Capsule ? Capsule->GetScaledCapsuleHalfHeight() : 0.0f;
+		const FVector Center = Character->GetActorLocation();
+
+		const float Reach = MaxRadius + CapsuleRadius;
+		const FIntPoint Min = CellOf(Center - FVector(Reach, Reach, 0.0f));
+		const FIntPoint Max = CellOf(Center + FVector(Reach, Reach, 0.0f));
+
+		for (int32 X = Min.X; X <= Max.X; X++) {
+			for (int32 Y = Min.Y; Y <= Max.Y; Y++) {
+				TArray<FPickupRef>* Cell = Grid.Find(FIntPoint(X, Y));
+				if (!Cell) continue;
+
+				for (int32 i = Cell->Num() - 1; i >= 0; i--) {
+					const FPickupRef Ref = (*Cell)[i];
+					FPickupType& Type = Types[Ref.Type];
+					const FVector& Location = Type.Locations[Ref.Slot];
+
+					const float Radial = Type.Radius + CapsuleRadius;
+					const float Vertical = Type.Radius + CapsuleHalfHeight;
+					if (FVector::DistSquared2D(Location, Center) > Radial * Radial || FMath::Abs(Location.Z - Center.Z) > Vertical) continue;
+
+					Cell->RemoveAtSwap(i, 1, EAllowShrinking::No);
+					Type.Alive[Ref.Slot] = 0;
+					Type.FreeSlots.Add(Ref.Slot);
+					Type.NumAlive--;
+					NumPickups--;
+					Collected++;
+					if (Type.Instances) {
+						Type.Instances->UpdateInstanceTransform(Ref.Slot, Hidden, true, true, true);
+					}
+
+					PendingCollections.Add({ Type.Class, Character });
+				}
+			}
+		}
+	}
+	SET_DWORD_STAT(STAT_PickupRecords, NumPickups);
+
+	// The grid and the types are left alone from here on, an OnCollected adding pickups cannot pull them from under the walk
+	UFPSPopulationDirector* Director = GetWorld()->GetSubsystem<UFPSPopulationDirector>();
+	TArray<FCollection> Collections = MoveTemp(PendingCollections);
+	for (const FCollection& Collection : Collections) {
+		if (Director) {
+			Director->UnregisterRecords(Collection.Class);
+		}
+		Collection.Class->GetDefaultObject<APickupBase>()->OnCollected(Collection.Character);
+	}
+
+	// Hand the allocation back for the next frame unless an OnCollected started a collection of its own
+	if (PendingCollections.Num() == 0) {
+		Collections.Reset();
+		PendingCollections = MoveTemp(Collections);
+	}
+	return Collected;
+}
+
+void UFPSPickupField::RemoveAll() {
+	UWorld* World = GetWorld();
+	UFPSPopulationDirector* Director = World ? World->GetSubsystem<UFPSPopulationDirector>() : nullptr;
+	for (FPickupType& Type : Types) {
+		if (Director) {
+			Director->UnregisterRecords(Type.Class, Type.NumAlive);
+		}
+		Type.Locations.Reset();
+		Type.Alive.Reset();
+		Type.FreeSlots.Reset();
+		Type.NumAlive = 0;
+		if (Type.Instances) {
+			Type.Instances->ClearInstances();
+		}
+	}
+	Grid.Reset();
+	NumPickups = 0;
+	SET_DWORD_STAT(STAT_PickupRecords, 0);
+}
+
+int32 UFPSPickupField::GetNumPickups(TSubclassOf<APickupBase> PickupClass) const {
+	int32 Total = 0;
+	for (const FPickupType& Type : Types) {
+		if (Type.Class && Type.Class->IsChildOf(PickupClass)) {
+			Total += Type.NumAlive;
+		}
+	}
+	return Total;
+}
+
+int32 UFPSPickupField::FindOrAddType(TSubclassOf<APickupBase> PickupClass) {
+	for (int32 i = 0; i < Types.Num(); i++) {
+		if (Types[i].Class == PickupClass) return i;
+	}
+
+	const APickupBase* CDO = PickupClass->GetDefaultObject<APickupBase>();
+	FPickupType& Type = Types.AddDefaulted_GetRef();
+	Type.Class = PickupClass;
+	Type.Radius = CDO->GetCollectRadius();
+	Type.MeshTransform = CDO->GetPickupMeshTransform();
+	MaxRadius = FMath::Max(MaxRadius, Type.Radius);
+
+	if (bRender && CDO->GetPickupMesh()) {
+		CreateInstances(Type);
+	}
+	return Types.Num() - 1;
+}
+
+void UFPSPickupField::CreateInstances(FPickupType& Type) {
+	if (!InstanceHost) {
+		FActorSpawnParameters Params;
+		Params.ObjectFlags |= RF_Transient;
+		InstanceHost = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, Params);
+		if (!InstanceHost) return;
+
+		USceneComponent* Root = NewObject<USceneComponent>(InstanceHost, TEXT("PickupFieldRoot"));
+		InstanceHost->SetRootComponent(Root);
+		Root->RegisterComponent();
+	}
+
+	const APickupBase* CDO = Type.Class->GetDefaultObject<APickupBase>();
+	UHierarchicalInstancedStaticMeshComponent* Instances = NewObject<UHierarchicalInstancedStaticMeshComponent>(InstanceHost);
+	Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Instances->SetCanEverAffectNavigation(false);
+	Instances->SetStaticMesh(CDO->GetPickupMesh());
+	Instances->SetMaterial(0, CDO->GetPickupMaterial());
+	Instances->SetupAttachment(InstanceHost->GetRootComponent());
+	Instances->RegisterComponent();
+
+	Type.Instances = Instances;
+	InstanceComponents.Add(Instances);
+}
+
+FIntPoint UFPSPickupField::CellOf(const FVector& Location) const {
+	const float Size = FMath::Max(CellSize, 1.0f);
+	return FIntPoint(FMath::FloorToInt(Location.X / Size), FMath::FloorToInt(Location.Y / Size));
+}
@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FPSPickupField.generated.h"
+
+class APickupBase;
+class AFPSCharacter;
+class UHierarchicalInstancedStaticMeshComponent;
+
+/**
+ * Pickups without actors. Each pickup is a location in a per-class record list, drawn by one hierarchical instanced
+ * mesh per class and bucketed in a uniform grid. Once per frame the characters are looked up in the grid and touched
+ * pickups are collected through the class default object's OnCollected, exactly like an APickupBase overlap.
+ */
+UCLASS()
+class FPSPROJECT_API UFPSPickupField : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Returns false for a null class. The pickup counts against the UFPSPopulationDirector budget of its class until collected.
+	bool AddPickup(TSubclassOf<APickupBase> PickupClass, const FVector& Location);
+
+	// Collects every pickup overlapping one of the characters and returns how many were taken. Tick passes every AFPSCharacter.
+	// OnCollected runs once the grid walk is done, so it may add pickups of its own.
+	int32 CollectPickups(const TArray<AFPSCharacter*>& Characters);
+
+	void RemoveAll();
+
+	int32 GetNumPickups() const { return NumPickups; }
+	int32 GetNumPickups(TSubclassOf<APickupBase> PickupClass) const;
+
+	// Should be a few times the largest pickup radius so a character touches at most a handful of cells
+	float CellSize = 400.0f;
+
+	bool bRender = true;
+
+protected:
+	struct FPickupType {
+		TSubclassOf<APickupBase> Class;
+		float Radius = 0.0f;
+		FTransform MeshTransform;
+		UHierarchicalInstancedStaticMeshComponent* Instances = nullptr;
+
+		// Slots line up with instance indices. Collected slots are hidden and reused, so instances never reorder.
+		TArray<FVector> Locations;
+		TArray<uint8> Alive;
+		TArray<int32> FreeSlots;
+		int32 NumAlive = 0;
+	};
+
+	struct FPickupRef {
+		int32 Type;
+		int32 Slot;
+	};
+
+	struct FCollection {
+		TSubclassOf<APickupBase> Class;
+		AFPSCharacter* Character;
+	};
+
+	int32 FindOrAddType(TSubclassOf<APickupBase> PickupClass);
+	void HandleActorSpawned(AActor* Actor);
+	void CreateInstances(FPickupType& Type);
+	FIntPoint CellOf(const FVector& Location) const;
+
+	TArray<FPickupType> Types;
+	TMap<FIntPoint, TArray<FPickupRef>> Grid;
+	float MaxRadius = 0.0f;
+	int32 NumPickups = 0;
+
+	// Characters are tracked as they spawn rather than searched for every frame
+	TArray<TWeakObjectPtr<AFPSCharacter>> Characters;
+	TArray<AFPSCharacter*> CharacterBuffer;
+	TArray<FCollection> PendingCollections;
+	FDelegateHandle ActorSpawnedHandle;
+
+	UPROPERTY()
+	AActor* InstanceHost = nullptr;
+
+	// Keeps the instance components alive, Types holds the same pointers
+	UPROPERTY()
+	TArray<UHierarchicalInstancedStaticMeshComponent*> InstanceComponents;
+};
@@ -4,9 +4,13 @@
 #include "Kismet/GameplayStatics.h"
 #include "NavigationSystem.h"
 #include "Engine/World.h"
+#include "EngineUtils.h"
 #include "CollectiblePickup.h"
 #include "HealthPackPickup.h"
 #include "AmmoCratePickup.h"
+#include "FPSSpawnPointService.h"
+#include "FPSPopulationDirector.h"
+#include "FPSPickupField.h"
 
 // Sets default values
 AFPSPickupSpawner::AFPSPickupSpawner()
@@ -16,10 +20,25 @@ AFPSPickupSpawner::AFPSPickupSpawner()
 
 }
 
+void AFPSPickupSpawner::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Before BeginPlay, so the starting collectibles come out of a full reservoir
+	UWorld* World = GetWorld();
+	if (UFPSSpawnPointService* SpawnPoints = World && World->IsGameWorld() ? World->GetSubsystem<UFPSSpawnPointService>() : nullptr) {
+		SpawnPoints->RegisterReservoir(GetActorLocation(), SpawnRadius, FMath::Max(32, NumberRubies + NumberSapphires));
+	}
+}
+
 // Called when the game starts or when spawned
 void AFPSPickupSpawner::BeginPlay()
 {
 	Super::BeginPlay();
+	if (UFPSPopulationDirector* Director = GetWorld()->GetSubsystem<UFPSPopulationDirector>()) {
+		Director->SetDefaultBudget(HealthPackClass, MaxActiveHealthPacks);
+		Director->SetDefaultBudget(AmmoCrateClass, MaxActiveAmmoCrates);
+	}
 	SpawnCollectibles();
 	HealthPackSpawnTimer = 20.0f;
 	
@@ -43,27 +62,32 @@ void AFPSPickupSpawner::Tick(float DeltaTime)
 	}
 }
 
+void AFPSPickupSpawner::ResetSpawner() {
+	UFPSPopulationDirector* Director = GetWorld()->GetSubsystem<UFPSPopulationDirector>();
+	for (TActorIterator<APickupBase> It(GetWorld()); It; ++It) {
+		if (It->GetOwner() != this) continue;
+
+		if (Director) {
+			Director->Unregister(*It);
+		}
+		It->Destroy();
+	}
+	ActiveHealthPacks.Reset();
+	ActiveAmmoCrates.Reset();
+
+	// Field pickups are cleared by whoever resets the field
+	SpawnCollectibles();
+	HealthPackSpawnTimer = 20.0f;
+	AmmoCrateSpawnTimer = 0.0f;
+}
+
 void AFPSPickupSpawner::SpawnCollectibles() {
 	for (int32 i = 0; i < NumberRubies; i++) {
-		FVector Loc = GetRandomNavmeshLocation();
-		Loc.Z += 50.0f;
-		if (RedRubyClass) {
-			ACollectiblePickup* NewPickup = GetWorld()->SpawnActor<ACollectiblePickup>(RedRubyClass, Loc, FRotator::ZeroRotator);
-			if (NewPickup) {
-				NewPickup->SetActorScale3D(FVector(1.0f, 1.0f, 1.0f));
-			}
-		}
+		SpawnPickup(RedRubyClass);
 	}
 
 	for (int32 i = 0; i < NumberSapphires; i++) {
-		FVector Loc = GetRandomNavmeshLocation();
-		Loc.Z += 50.0f;
-		if (BlueSapphireClass) {
-			ACollectiblePickup* NewPickup = GetWorld()->SpawnActor<ACollectiblePickup>(BlueSapphireClass, Loc, FRotator::ZeroRotator);
-			if (NewPickup) {
-				NewPickup->SetActorScale3D(FVector(1.0f, 1.0f, 1.0f));
-			}
-		}
+		SpawnPickup(BlueSapphireClass);
 	}
 }
 
@@ -72,12 +96,9 @@ void AFPSPickupSpawner::TryRespawnHealthPack() {
 		return !IsValid(P);
 		});
 
-	if (ActiveHealthPacks.Num() < MaxActiveHealthPacks && HealthPackClass) {
-		FVector Loc = GetRandomNavmeshLocation();
-		Loc.Z += 50.0f;
-		AActor* NewPickup = GetWorld()->SpawnActor<AHealthPackPickup>(HealthPackClass, Loc, FRotator::ZeroRotator);
+	if (GetNumActive(ActiveHealthPacks, HealthPackClass) < MaxActiveHealthPacks && HealthPackClass) {
+		AActor* NewPickup = SpawnPickup(HealthPackClass);
 		if (NewPickup) {
-			NewPickup->SetActorScale3D(FVector(1.0f, 1.0f, 1.0f));
 			ActiveHealthPacks.Add(NewPickup);
 		}
 	}
@@ -88,24 +109,63 @@ void AFPSPickupSpawner::TryRespawnAmmoCrate() {
 		return !IsValid(P);
 		});
 
-	if (ActiveAmmoCrates.Num() < MaxActiveAmmoCrates && AmmoCrateClass) {
-		FVector Loc = GetRandomNavmeshLocation();
-		Loc.Z += 50.0f;
-		AActor* NewPickup = GetWorld()->SpawnActor<AAmmoCratePickup>(AmmoCrateClass, Loc, FRotator::ZeroRotator);
+	if (GetNumActive(ActiveAmmoCrates, AmmoCrateClass) < MaxActiveAmmoCrates && AmmoCrateClass) {
+		AActor* NewPickup = SpawnPickup(AmmoCrateClass);
 		if (NewPickup) {
-			NewPickup->SetActorScale3D(FVector(1.0f, 1.0f, 1.0f));
 			ActiveAmmoCrates.Add(NewPickup);
 		}
 	}
 }
 
+AActor* AFPSPickupSpawner::SpawnPickup(TSubclassOf<APickupBase> PickupClass) {
+	if (!PickupClass) return nullptr;
+
+	// Over budget pickups are simply skipped, the respawn timers try again later
+	UFPSPopulationDirector* Director = GetWorld()->GetSubsystem<UFPSPopulationDirector>();
+	if (Director && !Director->RequestSpawn(PickupClass)) return nullptr;
+
+	// The field registers its records with the director itself
+	if (bUsePickupField) {
+		if (UFPSPickupField* Field = GetWorld()->GetSubsystem<UFPSPickupField>()) {
+			FVector Loc = GetRandomNavmeshLocation();
+			Loc.Z += 50.0f;
+			Field->AddPickup(PickupClass, Loc);
+		}
+		return nullptr;
+	}
+
+	FVector Loc = GetRandomNavmeshLocation();
+	Loc.Z += 50.0f;
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Owner = this;
+	APickupBase* NewPickup = GetWorld()->SpawnActor<APickupBase>(PickupClass, Loc, FRotator::ZeroRotator, SpawnParams);
+	if (NewPickup) {
+		NewPickup->SetActorScale3D(FVector(1.0f, 1.0f, 1.0f));
+		if (Director) {
+			Director->Register(NewPickup);
+		}
+	}
+	return NewPickup;
+}
+
+int32 AFPSPickupSpawner::GetNumActive(const TArray<AActor*>& Actors, TSubclassOf<APickupBase> PickupClass) const {
+	if (bUsePickupField) {
+		const UFPSPickupField* Field = GetWorld()->GetSubsystem<UFPSPickupField>();
+		return Field ? Field->GetNumPickups(PickupClass) : 0;
+	}
+	return Actors.Num();
+}
+
 FVector AFPSPickupSpawner::GetRandomNavmeshLocation() const {
 	UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld());
 	if (!NavSys) return FVector::ZeroVector;
-	FNavLocation NavLoc;
 	FVector Origin = GetActorLocation();
-	float Radius = 2000.f;
-	if (NavSys->GetRandomReachablePointInRadius(Origin, Radius, NavLoc)) return NavLoc.Location;
+	FVector CachedPoint;
+	UFPSSpawnPointService* SpawnPoints = GetWorld()->GetSubsystem<UFPSSpawnPointService>();
+	if (SpawnPoints && SpawnPoints->TryTakePoint(Origin, SpawnRadius, CachedPoint)) return CachedPoint;
+
+	FNavLocation NavLoc;
+	if (NavSys->GetRandomReachablePointInRadius(Origin, SpawnRadius, NavLoc)) return NavLoc.Location;
 	return Origin;
 }
 
@@ -27,7 +27,16 @@ public:
 	UPROPERTY(EditAnywhere, Category = Spawning)
 	int32 MaxActiveAmmoCrates = 5;
 
+	// Spawns pickups as records in UFPSPickupField instead of actors
+	UPROPERTY(EditAnywhere, Category = Spawning)
+	bool bUsePickupField = false;
+
+	// Destroys the actor pickups this spawner made and spawns the starting set again
+	void ResetSpawner();
+
 protected:
+	virtual void PostInitializeComponents() override;
+
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 	virtual void Tick(float DeltaTime) override;
@@ -47,6 +56,9 @@ protected:
 	UPROPERTY(EditAnywhere, Category = Spawning)
 	float RespawnTime = 60.0f;
 
+	UPROPERTY(EditAnywhere, Category = Spawning)
+	float SpawnRadius = 2000.0f;
+
 	TArray<AActor*> ActiveHealthPacks;
 	TArray<AActor*> ActiveAmmoCrates;
 
@@ -56,5 +68,7 @@ protected:
 	void SpawnCollectibles();
 	void TryRespawnHealthPack();
 	void TryRespawnAmmoCrate();
+	AActor* SpawnPickup(TSubclassOf<class APickupBase> PickupClass);
+	int32 GetNumActive(const TArray<AActor*>& Actors, TSubclassOf<class APickupBase> PickupClass) const;
 	FVector GetRandomNavmeshLocation() const;
 };
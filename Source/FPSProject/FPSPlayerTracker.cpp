@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FPSPlayerTracker.h"
+#include "FPSProject.h"
+#include "FPSCharacter.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+DECLARE_CYCLE_STAT(TEXT("Player Tracker Refresh"), STAT_PlayerTrackerRefresh, STATGROUP_FPSProject);
+
+void UFPSPlayerTracker::Deinitialize() {
+	Players.Empty();
+	Super::Deinitialize();
+}
+
+const TArray<FTrackedPlayer>& UFPSPlayerTracker::GetPlayers() {
+	if (RefreshedFrame != GFrameCounter) {
+		Refresh();
+	}
+	return Players;
+}
+
+const FTrackedPlayer* UFPSPlayerTracker::FindNearestPlayer(const FVector& From) {
+	const FTrackedPlayer* Nearest = nullptr;
+	float NearestDistSq = TNumericLimits<float>::Max();
+
+	for (const FTrackedPlayer& Player : GetPlayers()) {
+		const float DistSq = FVector::DistSquared(From, Player.Location);
+		if (DistSq < NearestDistSq) {
+			NearestDistSq = DistSq;
+			Nearest = &Player;
+		}
+	}
+	return Nearest;
+}
+
+void UFPSPlayerTracker::Refresh() {
+	SCOPE_CYCLE_COUNTER(STAT_PlayerTrackerRefresh);
+
+	RefreshedFrame = GFrameCounter;
+	NumRefreshes++;
+	Players.Reset();
+
+	// Bots drive the same character through an AI controller, so characters rather than player controllers are tracked
+	for (TActorIterator<AFPSCharacter> It(GetWorld()); It; ++It) {
+		if (It->bIsDead) continue;
+
+		FTrackedPlayer& Player = Players.AddDefaulted_GetRef();
+		Player.Actor = *It;
+		Player.Location = It->GetActorLocation();
+	}
+}
@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FPSPlayerTracker.generated.h"
+
+struct FTrackedPlayer {
+	TWeakObjectPtr<AActor> Actor;
+	FVector Location = FVector::ZeroVector;
+};
+
+/**
+ * Where the living players are this frame, gathered once per frame on first use and shared by every enemy's
+ * behavior tree instead of each one finding the player itself.
+ */
+UCLASS()
+class FPSPROJECT_API UFPSPlayerTracker : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	const TArray<FTrackedPlayer>& GetPlayers();
+
+	// Nearest living player to From, or nullptr when there is none
+	const FTrackedPlayer* FindNearestPlayer(const FVector& From);
+
+	// Gathers the players again even if this frame already did, e.g. after teleporting one
+	void Refresh();
+
+	int32 GetNumRefreshes() const { return NumRefreshes; }
+
+protected:
+	TArray<FTrackedPlayer> Players;
+
+	uint64 RefreshedFrame = MAX_uint64;
+	int32 NumRefreshes = 0;
+};
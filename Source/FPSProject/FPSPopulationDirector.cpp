@@ -0,0 +1,205 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FPSPopulationDirector.h"
+#include "FPSProject.h"
+#include "FPSEnemyBase.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "TimerManager.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Population Tracked Enemies"), STAT_PopulationTracked, STATGROUP_FPSProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Population Refused Spawns"), STAT_PopulationRefused, STATGROUP_FPSProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Population Recycled Enemies"), STAT_PopulationRecycled, STATGROUP_FPSProject);
+
+void UFPSPopulationDirector::Deinitialize() {
+	Budgets.Empty();
+	RecycleCandidates.Empty();
+	Stats = FPopulationStats();
+	Super::Deinitialize();
+}
+
+void UFPSPopulationDirector::OnWorldBeginPlay(UWorld& InWorld) {
+	Super::OnWorldBeginPlay(InWorld);
+
+	InWorld.GetTimerManager().SetTimer(RecycleTimerHandle, this, &UFPSPopulationDirector::UpdateRecycling, RecycleCheckInterval, true);
+}
+
+void UFPSPopulationDirector::SetBudget(TSubclassOf<AActor> ActorClass, int32 MaxAlive) {
+	if (!ActorClass) return;
+
+	if (MaxAlive <= 0) {
+		Budgets.Remove(ActorClass.Get());
+		return;
+	}
+	Budgets.FindOrAdd(ActorClass.Get()).MaxAlive = MaxAlive;
+}
+
+void UFPSPopulationDirector::SetDefaultBudget(TSubclassOf<AActor> ActorClass, int32 MaxAlive) {
+	if (!ActorClass || Budgets.Contains(ActorClass.Get())) return;
+	SetBudget(ActorClass, MaxAlive);
+}
+
+int32 UFPSPopulationDirector::GetBudget(TSubclassOf<AActor> ActorClass) const {
+	for (UClass* Class = ActorClass.Get(); Class; Class = Class->GetSuperClass()) {
+		if (const FPopulationBudget* Budget = Budgets.Find(Class)) {
+			return Budget->MaxAlive;
+		}
+	}
+	return 0;
+}
+
+bool UFPSPopulationDirector::RequestSpawn(TSubclassOf<AActor> ActorClass) {
+	FPopulationBudget* Budget = FindBudget(ActorClass.Get());
+	if (Budget) {
+		PruneAlive(*Budget);
+		if (Budget->Alive.Num() + Budget->NumRecords >= Budget->MaxAlive) {
+			Stats.Refused++;
+			UpdateStats();
+			return false;
+		}
+	}
+
+	Stats.Granted++;
+	return true;
+}
+
+void UFPSPopulationDirector::Register(AActor* Actor) {
+	if (!IsValid(Actor)) return;
+
+	if (FPopulationBudget* Budget = FindBudget(Actor->GetClass())) {
+		Budget->Alive.AddUnique(Actor);
+	}
+
+	if (AFPSEnemyBase* Enemy = Cast<AFPSEnemyBase>(Actor)) {
+		// Pooled enemies come back with the same pointer, so reset their clock instead of adding a second entry
+		FRecycleCandidate* Existing = RecycleCandidates.FindByPredicate([Enemy](const FRecycleCandidate& C) {
+			return C.Enemy.Get() == Enemy;
+			});
+		if (!Existing) {
+			Existing = &RecycleCandidates.AddDefaulted_GetRef();
+			Existing->Enemy = Enemy;
+		}
+		Existing->IrrelevantTime = 0.0f;
+	}
+	UpdateStats();
+}
+
+void UFPSPopulationDirector::Unregister(AActor* Actor) {
+	if (!Actor) return;
+
+	if (FPopulationBudget* Budget = FindBudget(Actor->GetClass())) {
+		Budget->Alive.RemoveSwap(Actor);
+	}
+	RecycleCandidates.RemoveAllSwap([Actor](const FRecycleCandidate& C) {
+		return C.Enemy.Get() == Actor;
+		});
+	UpdateStats();
+}
+
+void UFPSPopulationDirector::RegisterRecords(TSubclassOf<AActor> RecordClass, int32 Count) {
+	if (FPopulationBudget* Budget = FindBudget(RecordClass.Get())) {
+		Budget->NumRecords += FMath::Max(0, Count);
+	}
+}
+
+void UFPSPopulationDirector::UnregisterRecords(TSubclassOf<AActor> RecordClass, int32 Count) {
+	// The budget may have been set after the records were added, so never go below zero
+	if (FPopulationBudget* Budget = FindBudget(RecordClass.Get())) {
+		Budget->NumRecords = FMath::Max(0, Budget->NumRecords - FMath::Max(0, Count));
+	}
+}
+
+int32 UFPSPopulationDirector::GetNumAlive(TSubclassOf<AActor> ActorClass) {
+	FPopulationBudget* Budget = FindBudget(ActorClass.Get());
+	if (!Budget) return 0;
+
+	PruneAlive(*Budget);
+	return Budget->Alive.Num() + Budget->NumRecords;
+}
+
+int32 UFPSPopulationDirector::RecycleIrrelevantEnemies(const TArray<FVector>& ViewerLocations, float DeltaSeconds) {
+	// Without a player there is nothing to be far from
+	if (ViewerLocations.Num() == 0) return 0;
+
+	const float RecycleDistanceSq = RecycleDistance * RecycleDistance;
+	const float UnseenDistanceSq = RecycleUnseenDistance * RecycleUnseenDistance;
+
+	TArray<AFPSEnemyBase*> ToRecycle;
+	for (int32 i = RecycleCandidates.Num() - 1; i >= 0; i--) {
+		FRecycleCandidate& Candidate = RecycleCandidates[i];
+		AFPSEnemyBase* Enemy = Candidate.Enemy.Get();
+		if (!IsValid(Enemy) || Enemy->IsInPool()) {
+			RecycleCandidates.RemoveAtSwap(i);
+			continue;
+		}
+
+		float ClosestSq = TNumericLimits<float>::Max();
+		for (const FVector& Viewer : ViewerLocations) {
+			ClosestSq = FMath::Min(ClosestSq, (float)FVector::DistSquared(Viewer, Enemy->GetActorLocation()));
+		}
+
+		const bool bFar = ClosestSq > RecycleDistanceSq;
+		const bool bUnseen = ClosestSq > UnseenDistanceSq && !Enemy->WasRecentlyRendered(RecycleCheckInterval);
+		if (!bFar && !bUnseen) {
+			Candidate.IrrelevantTime = 0.0f;
+			continue;
+		}
+
+		Candidate.IrrelevantTime += DeltaSeconds;
+		if (Candidate.IrrelevantTime >= RecycleAfterSeconds) {
+			RecycleCandidates.RemoveAtSwap(i);
+			ToRecycle.Add(Enemy);
+		}
+	}
+
+	// Recycling notifies spawners, which may spawn replacements and register them, so do it after the scan
+	for (AFPSEnemyBase* Enemy : ToRecycle) {
+		Enemy->Recycle();
+	}
+
+	Stats.Recycled += ToRecycle.Num();
+	UpdateStats();
+	return ToRecycle.Num();
+}
+
+void UFPSPopulationDirector::UpdateRecycling() {
+	if (!bRecycleEnabled || RecycleCandidates.Num() == 0) return;
+
+	TArray<FVector> ViewerLocations;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It) {
+		const APlayerController* PC = It->Get();
+		if (PC && PC->GetPawn()) {
+			ViewerLocations.Add(PC->GetPawn()->GetActorLocation());
+		}
+	}
+
+	RecycleIrrelevantEnemies(ViewerLocations, RecycleCheckInterval);
+}
+
+FPopulationBudget* UFPSPopulationDirector::FindBudget(UClass* ActorClass) {
+	for (UClass* Class = ActorClass; Class; Class = Class->GetSuperClass()) {
+		if (FPopulationBudget* Budget = Budgets.Find(Class)) {
+			return Budget;
+		}
+	}
+	return nullptr;
+}
+
+void UFPSPopulationDirector::PruneAlive(FPopulationBudget& Budget) {
+	Budget.Alive.RemoveAllSwap([](const TWeakObjectPtr<AActor>& Weak) {
+		const AActor* Actor = Weak.Get();
+		if (!IsValid(Actor)) return true;
+
+		const AFPSEnemyBase* Enemy = Cast<AFPSEnemyBase>(Actor);
+		return Enemy && Enemy->IsInPool();
+		});
+}
+
+void UFPSPopulationDirector::UpdateStats() {
+	Stats.Tracked = RecycleCandidates.Num();
+
+	SET_DWORD_STAT(STAT_PopulationTracked, Stats.Tracked);
+	SET_DWORD_STAT(STAT_PopulationRefused, Stats.Refused);
+	SET_DWORD_STAT(STAT_PopulationRecycled, Stats.Recycled);
+}
@@ -0,0 +1,120 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FPSPopulationDirector.generated.h"
+
+class AFPSEnemyBase;
+
+USTRUCT(BlueprintType)
+struct FPopulationStats {
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 Granted = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 Refused = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 Recycled = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 Tracked = 0;
+};
+
+USTRUCT()
+struct FPopulationBudget {
+	GENERATED_BODY()
+
+	int32 MaxAlive = 0;
+
+	UPROPERTY()
+	TArray<TWeakObjectPtr<AActor>> Alive;
+
+	// Counted things without an actor, such as UFPSPickupField records
+	int32 NumRecords = 0;
+};
+
+USTRUCT()
+struct FRecycleCandidate {
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TWeakObjectPtr<AFPSEnemyBase> Enemy;
+
+	float IrrelevantTime = 0.0f;
+};
+
+/**
+ * World-wide population budgets shared by every spawner. Spawners ask before spawning and register what they spawned,
+ * budgets apply to a class and all its subclasses. Enemies that stay far from or unseen by every player for too long
+ * are handed back to their spawner and the pool.
+ */
+UCLASS()
+class FPSPROJECT_API UFPSPopulationDirector : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	// 0 or less removes the budget
+	UFUNCTION(BlueprintCallable, Category = "Population")
+	void SetBudget(TSubclassOf<AActor> ActorClass, int32 MaxAlive);
+
+	// Only sets the budget if nobody configured one yet, spawners use this so a game mode can override them
+	void SetDefaultBudget(TSubclassOf<AActor> ActorClass, int32 MaxAlive);
+
+	int32 GetBudget(TSubclassOf<AActor> ActorClass) const;
+
+	// Returns false when the budget covering ActorClass is full. Classes without a budget are always granted.
+	bool RequestSpawn(TSubclassOf<AActor> ActorClass);
+
+	// Counts the actor against its budget. Enemies also become candidates for recycling.
+	void Register(AActor* Actor);
+
+	// Frees the actor's slot right away. Destroyed and pooled actors are dropped automatically, this is for the rest.
+	void Unregister(AActor* Actor);
+
+	// Counts records standing in for RecordClass actors against its budget, whoever removes them unregisters them
+	void RegisterRecords(TSubclassOf<AActor> RecordClass, int32 Count = 1);
+	void UnregisterRecords(TSubclassOf<AActor> RecordClass, int32 Count = 1);
+
+	int32 GetNumAlive(TSubclassOf<AActor> ActorClass);
+
+	// Ages every tracked enemy and recycles the ones irrelevant for RecycleAfterSeconds. Returns how many were recycled.
+	int32 RecycleIrrelevantEnemies(const TArray<FVector>& ViewerLocations, float DeltaSeconds);
+
+	UFUNCTION(BlueprintCallable, Category = "Population")
+	FPopulationStats GetStats() const { return Stats; }
+
+	bool bRecycleEnabled = true;
+
+	// Enemies this far from every player are irrelevant
+	float RecycleDistance = 6000.0f;
+
+	// Enemies not rendered recently and at least this far away are irrelevant too
+	float RecycleUnseenDistance = 2500.0f;
+
+	float RecycleAfterSeconds = 20.0f;
+	float RecycleCheckInterval = 1.0f;
+
+protected:
+	void UpdateRecycling();
+	FPopulationBudget* FindBudget(UClass* ActorClass);
+	static void PruneAlive(FPopulationBudget& Budget);
+	void UpdateStats();
+
+	UPROPERTY()
+	TMap<UClass*, FPopulationBudget> Budgets;
+
+	UPROPERTY()
+	TArray<FRecycleCandidate> RecycleCandidates;
+
+	FTimerHandle RecycleTimerHandle;
+	FPopulationStats Stats;
+};
@@ -2,13 +2,15 @@
 
 
 #include "FPSProjectile.h"
-#include "UObject/ConstructorHelpers.h"
 #include "Components/StaticMeshComponent.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Materials/MaterialInterface.h"
 #include "Engine/Engine.h"
 #include "Engine/StaticMesh.h"
-#include "FPSEnemyBase.h"
+#include "Engine/World.h"
+#include "FPSProjectilePool.h"
+#include "FPSDamageQueue.h"
+#include "FPSAssetPreloader.h"
 
 // Sets default values
 AFPSProjectile::AFPSProjectile()
@@ -42,27 +44,8 @@ AFPSProjectile::AFPSProjectile()
 	if (!ProjectileMeshComponent)
 	{
 		ProjectileMeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("ProjectileMeshComponent"));
-		static const TCHAR* MeshPath = TEXT("/Game/Static/Bullet.Bullet");
-		if (UStaticMesh* Mesh = LoadObject<UStaticMesh>(nullptr, MeshPath))
-		{
-			ProjectileMeshComponent->SetStaticMesh(Mesh);
-		}
-		else
-		{
-			UE_LOG(LogTemp, Warning, TEXT("AFPSProjectile: Missing mesh at %s"), MeshPath);
-		}
-
-		static const TCHAR* MatPath = TEXT("/Game/Static/SphereMaterial.SphereMaterial");
-		if (UMaterialInterface* BaseMat = LoadObject<UMaterialInterface>(nullptr, MatPath))
-		{
-			ProjectileMaterialInstance = UMaterialInstanceDynamic::Create(BaseMat, ProjectileMeshComponent);
-			ProjectileMeshComponent->SetMaterial(0, ProjectileMaterialInstance);
-		}
-		else
-		{
-			UE_LOG(LogTemp, Warning, TEXT("AFPSProjectile: Missing material at %s"), MatPath);
-		}
-
+		ProjectileMesh = TSoftObjectPtr<UStaticMesh>(FSoftObjectPath(TEXT("/Game/Static/Bullet.Bullet")));
+		ProjectileMaterial = TSoftObjectPtr<UMaterialInterface>(FSoftObjectPath(TEXT("/Game/Static/SphereMaterial.SphereMaterial")));
 		ProjectileMeshComponent->SetRelativeScale3D(FVector(3.0f, 3.0f, 3.0f));
 		ProjectileMeshComponent->SetupAttachment(RootComponent);
 	}
@@ -75,6 +58,35 @@ AFPSProjectile::AFPSProjectile()
 void AFPSProjectile::BeginPlay()
 {
 	Super::BeginPlay();
+	ApplyMeshAssets();
+}
+
+void AFPSProjectile::OnConstruction(const FTransform& Transform) {
+	Super::OnConstruction(Transform);
+	ApplyMeshAssets();
+}
+
+void AFPSProjectile::ApplyMeshAssets() {
+	if (!ProjectileMeshComponent) return;
+
+	if (!ProjectileMeshComponent->GetStaticMesh()) {
+		if (UStaticMesh* Mesh = UFPSAssetPreloader::Resolve(ProjectileMesh)) {
+			ProjectileMeshComponent->SetStaticMesh(Mesh);
+		}
+		else {
+			UE_LOG(LogTemp, Warning, TEXT("AFPSProjectile: Missing mesh at %s"), *ProjectileMesh.ToString());
+		}
+	}
+
+	if (!ProjectileMaterialInstance && ProjectileMeshComponent->GetNumOverrideMaterials() == 0) {
+		if (UMaterialInterface* BaseMat = UFPSAssetPreloader::Resolve(ProjectileMaterial)) {
+			ProjectileMaterialInstance = UMaterialInstanceDynamic::Create(BaseMat, ProjectileMeshComponent);
+			ProjectileMeshComponent->SetMaterial(0, ProjectileMaterialInstance);
+		}
+		else {
+			UE_LOG(LogTemp, Warning, TEXT("AFPSProjectile: Missing material at %s"), *ProjectileMaterial.ToString());
+		}
+	}
 }
 
 // Called every frame
@@ -84,22 +96,72 @@ void AFPSProjectile::Tick(float DeltaTime)
 
 }
 
-void AFPSProjectile::FireInDirection(const FVector& ShootDirection) {
+void AFPSProjectile::FireInDirection(const FVector& ShootDirection, float TimeInFlight) {
 	ProjectileMovementComponent->Velocity = ShootDirection * ProjectileMovementComponent->InitialSpeed;
+
+	if (TimeInFlight > 0.0f) {
+		// Swept, so anything in the way is hit through OnHit as usual
+		AddActorWorldOffset(ProjectileMovementComponent->Velocity * TimeInFlight, true);
+	}
 }
 
 void AFPSProjectile::OnHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComponent, FVector NormalImpulse, const FHitResult& Hit) {
-	if (OtherActor != this && OtherActor->IsA(AFPSEnemyBase::StaticClass())) {
-		AFPSEnemyBase* Enemy = Cast<AFPSEnemyBase>(OtherActor);
-		if (Enemy) {
-			GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Magenta, FString::Printf(TEXT("ENEMY HIT")));
-			Enemy->ReceiveDamage(Damage);
-
-			FVector KnockbackDirection = Enemy->GetActorLocation() - GetActorLocation();
-			KnockbackDirection.Normalize();
-			float KnockbackStrength = 800.f;	//Just set it like that?
-			Enemy->ApplyKnockback(KnockbackDirection, KnockbackStrength);
+	// Applied after physics by the damage queue, not from inside the hit callback
+	if (OtherActor != this) {
+		if (UFPSDamageQueue* DamageQueue = GetWorld()->GetSubsystem<UFPSDamageQueue>()) {
+			DamageQueue->QueueImpact(OtherActor, Hit.Location, Damage, UFPSDamageQueue::ImpactKnockbackStrength, GetOwner());
+		}
+	}
+	Expire();
+}
+
+void AFPSProjectile::ActivateFromPool(const FVector& Location, const FRotator& Rotation) {
+	bInPool = false;
+	SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::ResetPhysics);
+
+	// A bounce that comes to rest calls StopSimulating, which clears the updated component
+	ProjectileMovementComponent->SetUpdatedComponent(CollisionComponent);
+	ProjectileMovementComponent->Velocity = FVector::ZeroVector;
+	ProjectileMovementComponent->Activate(true);
+
+	SetActorEnableCollision(true);
+	SetActorHiddenInGame(false);
+	SetActorTickEnabled(true);
+	SetLifeSpan(InitialLifeSpan);
+}
+
+void AFPSProjectile::DeactivateToPool() {
+	bInPool = true;
+	SetLifeSpan(0.0f);
+
+	ProjectileMovementComponent->StopMovementImmediately();
+	ProjectileMovementComponent->ClearPendingForce(true);
+	ProjectileMovementComponent->Deactivate();
+
+	SetActorEnableCollision(false);
+	SetActorHiddenInGame(true);
+	SetActorTickEnabled(false);
+	SetOwner(nullptr);
+	SetInstigator(nullptr);
+	Damage = 1.0f;
+}
+
+void AFPSProjectile::Expire() {
+	if (bInPool) return;
+
+	if (bIsPooled) {
+		if (UFPSProjectilePool* Pool = GetWorld() ? GetWorld()->GetSubsystem<UFPSProjectilePool>() : nullptr) {
+			Pool->Release(this);
+			return;
 		}
 	}
 	Destroy();
 }
+
+void AFPSProjectile::LifeSpanExpired() {
+	if (bIsPooled) {
+		Expire();
+		return;
+	}
+	Super::LifeSpanExpired();
+}
@@ -20,6 +20,10 @@ public:
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void OnConstruction(const FTransform& Transform) override;
+
+	// Puts the soft referenced mesh and material on the mesh component unless a blueprint already set its own
+	void ApplyMeshAssets();
 
 public:	
 	// Called every frame
@@ -37,11 +41,37 @@ public:
 	UPROPERTY(VisibleDefaultsOnly, Category = Movement)
 	UMaterialInstanceDynamic* ProjectileMaterialInstance;
 
+	// Soft, so loading the class does not load them. UFPSAssetPreloader streams them in with the map.
+	UPROPERTY(EditDefaultsOnly, Category = Projectile)
+	TSoftObjectPtr<class UStaticMesh> ProjectileMesh;
+
+	UPROPERTY(EditDefaultsOnly, Category = Projectile)
+	TSoftObjectPtr<class UMaterialInterface> ProjectileMaterial;
+
 	UFUNCTION()
 	void OnHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComponent, FVector NormalImpulse, const FHitResult& Hit);
 
-	void FireInDirection(const FVector& ShootDirection);
+	// TimeInFlight moves the projectile along its path right away, as if it had been fired that many seconds ago
+	void FireInDirection(const FVector& ShootDirection, float TimeInFlight = 0.0f);
 
 	float Damage = 1.0f;
 
+	// Pool hooks, see UFPSProjectilePool
+	void ActivateFromPool(const FVector& Location, const FRotator& Rotation);
+	void DeactivateToPool();
+
+	// Returns the projectile to its pool, or destroys it when it was spawned outside of one
+	void Expire();
+
+	bool IsPooled() const { return bIsPooled; }
+	bool IsInPool() const { return bInPool; }
+
+protected:
+	virtual void LifeSpanExpired() override;
+
+private:
+	friend class UFPSProjectilePool;
+
+	bool bIsPooled = false;
+	bool bInPool = false;
 };
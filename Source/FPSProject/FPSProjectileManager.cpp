@@ -0,0 +1,285 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FPSProjectileManager.h"
+#include "FPSProject.h"
+#include "FPSProjectile.h"
+#include "FPSDamageQueue.h"
+#include "FPSAssetPreloader.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/SphereComponent.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInterface.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Projectile Step"), STAT_ProjectileStep, STATGROUP_FPSProject);
+DECLARE_CYCLE_STAT(TEXT("Projectile Sweeps"), STAT_ProjectileSweeps, STATGROUP_FPSProject);
+DECLARE_CYCLE_STAT(TEXT("Projectile Instances"), STAT_ProjectileInstances, STATGROUP_FPSProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Projectiles In Flight"), STAT_ProjectilesInFlight, STATGROUP_FPSProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projectile Hits"), STAT_ProjectileHits, STATGROUP_FPSProject);
+
+void UFPSProjectileManager::Deinitialize() {
+	RemoveAll();
+	InstanceHost = nullptr;
+	Instances = nullptr;
+	Super::Deinitialize();
+}
+
+TStatId UFPSProjectileManager::GetStatId() const {
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFPSProjectileManager, STATGROUP_Tickables);
+}
+
+void UFPSProjectileManager::Tick(float DeltaTime) {
+	StepProjectiles(DeltaTime);
+}
+
+void UFPSProjectileManager::ConfigureFromClass(TSubclassOf<AFPSProjectile> ProjectileClass) {
+	if (!ProjectileClass) return;
+
+	const AFPSProjectile* CDO = ProjectileClass->GetDefaultObject<AFPSProjectile>();
+	if (CDO->CollisionComponent) {
+		Radius = CDO->CollisionComponent->GetUnscaledSphereRadius();
+	}
+	if (CDO->ProjectileMovementComponent) {
+		Speed = CDO->ProjectileMovementComponent->InitialSpeed;
+	}
+	if (CDO->InitialLifeSpan > 0.0f) {
+		Lifetime = CDO->InitialLifeSpan;
+	}
+	if (CDO->ProjectileMeshComponent) {
+		// The class default only carries soft references unless a blueprint set the component's mesh itself
+		Mesh = CDO->ProjectileMeshComponent->GetStaticMesh();
+		if (!Mesh) {
+			Mesh = UFPSAssetPreloader::Resolve(CDO->ProjectileMesh);
+		}
+		Material = CDO->ProjectileMeshComponent->GetNumOverrideMaterials() > 0 ? CDO->ProjectileMeshComponent->GetMaterial(0) : UFPSAssetPreloader::Resolve(CDO->ProjectileMaterial);
+		MeshScale = CDO->ProjectileMeshComponent->GetRelativeScale3D();
+	}
+
+	if (Instances) {
+		Instances->SetStaticMesh(Mesh);
+		Instances->SetMaterial(0, Material);
+	}
+}
+
+bool UFPSProjectileManager::Fire(const FVector& Location, const FVector& Direction, float Damage, AActor* Owner, float TimeInFlight) {
+	if (Positions.Num() >= MaxProjectiles) return false;
+
+	const FVector Velocity = Direction.GetSafeNormal() * Speed;
+	FVector Start = Location;
+	if (TimeInFlight > 0.0f) {
+		// Swept, so a bullet fired earlier in a long frame still hits what stood within reach of the muzzle
+		const FVector Next = Location + Velocity * TimeInFlight;
+		const FCollisionQueryParams Params(SCENE_QUERY_STAT(ProjectileManagerLaunch), false, Owner);
+		FHitResult Hit;
+		if (GetWorld()->SweepSingleByProfile(Hit, Location, Next, FQuat::Identity, CollisionProfile, FCollisionShape::MakeSphere(Radius), Params)) {
+			ApplyHit(Hit, Damage, Owner);
+			return true;
+		}
+		Start = Next;
+	}
+
+	Positions.Add(Start);
+	Velocities.Add(Velocity);
+	Damages.Add(Damage);
+	Ages.Add(FMath::Max(0.0f, TimeInFlight));
+	Owners.Add(Owner);
+	return true;
+}
+
+void UFPSProjectileManager::RemoveAll() {
+	Positions.Reset();
+	Velocities.Reset();
+	Damages.Reset();
+	Ages.Reset();
+	Owners.Reset();
+	PendingTraces.Reset();
+
+	if (Instances) {
+		Instances->ClearInstances();
+	}
+}
+
+void UFPSProjectileManager::StepProjectiles(float DeltaTime) {
+	if (Positions.Num() == 0 && PendingTraces.Num() == 0) {
+		if (Instances && Instances->GetInstanceCount() > 0) {
+			Instances->ClearInstances();
+		}
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_ProjectileStep);
+
+	const int32 Num = Positions.Num();
+	Dead.Reset();
+	Dead.SetNumZeroed(Num);
+
+	// Last frame's traces refer to the bullets as they were before anything below adds or removes
+	if (bAsyncSweeps) {
+		ResolveAsyncSweeps();
+	}
+	else {
+		PendingTraces.Reset();
+	}
+
+	for (int32 i = 0; i < Num; i++) {
+		Ages[i] += DeltaTime;
+		if (Ages[i] >= Lifetime) {
+			Dead[i] = 1;
+		}
+	}
+
+	if (!bAsyncSweeps) {
+		SweepImmediate(DeltaTime);
+	}
+
+	Compact();
+
+	if (bAsyncSweeps) {
+		IssueAsyncSweeps(DeltaTime);
+	}
+
+	UpdateInstances();
+	SET_DWORD_STAT(STAT_ProjectilesInFlight, Positions.Num());
+}
+
+void UFPSProjectileManager::SweepImmediate(float DeltaTime) {
+	SCOPE_CYCLE_COUNTER(STAT_ProjectileSweeps);
+
+	UWorld* World = GetWorld();
+	const FCollisionShape Shape = FCollisionShape::MakeSphere(Radius);
+	FHitResult SweepHit;
+
+	// Blocking scene queries stay on the game thread, bAsyncSweeps moves them off it
+	for (int32 i = 0; i < Positions.Num(); i++) {
+		if (Dead[i]) continue;
+
+		const float StepTime = FMath::Min(Ages[i], DeltaTime);
+		if (StepTime <= 0.0f) continue;
+
+		const FVector Next = Positions[i] + Velocities[i] * StepTime;
+		const FCollisionQueryParams Params(SCENE_QUERY_STAT(ProjectileManagerSweep), false, Owners[i].Get());
+		if (World->SweepSingleByProfile(SweepHit, Positions[i], Next, FQuat::Identity, CollisionProfile, Shape, Params)) {
+			Positions[i] = SweepHit.Location;
+			ApplyHit(SweepHit, Damages[i], Owners[i].Get());
+			Dead[i] = 1;
+		}
+		else {
+			Positions[i] = Next;
+		}
+	}
+}
+
+void UFPSProjectileManager::ResolveAsyncSweeps() {
+	UWorld* World = GetWorld();
+	const int32 Num = FMath::Min(PendingTraces.Num(), Positions.Num());
+	for (int32 i = 0; i < Num; i++) {
+		FTraceDatum Datum;
+		if (!World->QueryTraceData(PendingTraces[i], Datum)) continue;
+
+		for (const FHitResult& Hit : Datum.OutHits) {
+			if (!Hit.bBlockingHit) continue;
+
+			ApplyHit(Hit, Damages[i], Owners[i].Get());
+			Dead[i] = 1;
+			break;
+		}
+	}
+	PendingTraces.Reset();
+}
+
+void UFPSProjectileManager::IssueAsyncSweeps(float DeltaTime) {
+	SCOPE_CYCLE_COUNTER(STAT_ProjectileSweeps);
+
+	UWorld* World = GetWorld();
+	const FCollisionShape Shape = FCollisionShape::MakeSphere(Radius);
+
+	// Bullets move ahead now and are removed next frame if their segment turned out to be blocked
+	PendingTraces.SetNum(Positions.Num());
+	for (int32 i = 0; i < Positions.Num(); i++) {
+		const FVector Next = Positions[i] + Velocities[i] * FMath::Clamp(Ages[i], 0.0f, DeltaTime);
+		const FCollisionQueryParams Params(SCENE_QUERY_STAT(ProjectileManagerAsyncSweep), false, Owners[i].Get());
+		PendingTraces[i] = World->AsyncSweepByProfile(EAsyncTraceType::Single, Positions[i], Next, FQuat::Identity, CollisionProfile, Shape, Params);
+		Positions[i] = Next;
+	}
+}
+
+void UFPSProjectileManager::ApplyHit(const FHitResult& Hit, float Damage, const AActor* Owner) {
+	INC_DWORD_STAT(STAT_ProjectileHits);
+
+	if (UFPSDamageQueue* DamageQueue = GetWorld()->GetSubsystem<UFPSDamageQueue>()) {
+		DamageQueue->QueueImpact(Hit.GetActor(), Hit.Location, Damage, KnockbackStrength, Owner);
+	}
+}
+
+void UFPSProjectileManager::Compact() {
+	// Order preserving, so async traces issued after this line up with the surviving bullets
+	int32 Write = 0;
+	for (int32 Read = 0; Read < Positions.Num(); Read++) {
+		if (Dead[Read]) continue;
+
+		if (Write != Read) {
+			Positions[Write] = Positions[Read];
+			Velocities[Write] = Velocities[Read];
+			Damages[Write] = Damages[Read];
+			Ages[Write] = Ages[Read];
+			Owners[Write] = Owners[Read];
+		}
+		Write++;
+	}
+
+	Positions.SetNum(Write, EAllowShrinking::No);
+	Velocities.SetNum(Write, EAllowShrinking::No);
+	Damages.SetNum(Write, EAllowShrinking::No);
+	Ages.SetNum(Write, EAllowShrinking::No);
+	Owners.SetNum(Write, EAllowShrinking::No);
+}
+
+void UFPSProjectileManager::UpdateInstances() {
+	if (!bRender || !Mesh) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_ProjectileInstances);
+
+	if (!Instances) {
+		FActorSpawnParameters Params;
+		Params.ObjectFlags |= RF_Transient;
+		InstanceHost = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, Params);
+		if (!InstanceHost) return;
+
+		Instances = NewObject<UInstancedStaticMeshComponent>(InstanceHost, TEXT("ProjectileInstances"));
+		Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Instances->SetCanEverAffectNavigation(false);
+		Instances->SetCastShadow(false);
+		Instances->SetStaticMesh(Mesh);
+		Instances->SetMaterial(0, Material);
+		InstanceHost->SetRootComponent(Instances);
+		Instances->RegisterComponent();
+	}
+
+	InstanceTransforms.Reset();
+	for (int32 i = 0; i < Positions.Num(); i++) {
+		InstanceTransforms.Emplace(Velocities[i].Rotation(), Positions[i], MeshScale);
+	}
+
+	// Bullets come and go every frame, so the instance count only grows and spare instances are collapsed to zero
+	// scale. It is rebuilt once a storm is over and most of them sit unused.
+	const int32 Needed = InstanceTransforms.Num();
+	int32 Current = Instances->GetInstanceCount();
+	if (Current > Needed * 2 + 64) {
+		Instances->ClearInstances();
+		Current = 0;
+	}
+	if (Current < Needed) {
+		Instances->AddInstances(TArray<FTransform>(InstanceTransforms.GetData() + Current, Needed - Current), false);
+		Current = Needed;
+	}
+
+	const FTransform Hidden(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector);
+	while (InstanceTransforms.Num() < Current) {
+		InstanceTransforms.Add(Hidden);
+	}
+	if (Current > 0) {
+		Instances->BatchUpdateInstancesTransforms(0, InstanceTransforms, false, true, true);
+	}
+}
@@ -0,0 +1,94 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "FPSDamageQueue.h"
+#include "FPSProjectileManager.generated.h"
+
+class AFPSProjectile;
+class UStaticMesh;
+class UMaterialInterface;
+class UInstancedStaticMeshComponent;
+
+/**
+ * Bullets without actors. Every bullet is a slot in a set of parallel arrays, all of them are swept in one pass per
+ * frame (on the game thread, or as async traces resolved the next frame) and drawn by a single instanced static mesh.
+ * Hits go through UFPSDamageQueue with the same damage and knockback as AFPSProjectile::OnHit.
+ */
+UCLASS()
+class FPSPROJECT_API UFPSProjectileManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Takes radius, speed, lifetime, mesh and material from the projectile class the manager stands in for
+	void ConfigureFromClass(TSubclassOf<AFPSProjectile> ProjectileClass);
+
+	// Returns false when MaxProjectiles are already in flight. TimeInFlight is how long ago the bullet left the muzzle,
+	// it is swept ahead that far right away, the same as AFPSProjectile::FireInDirection.
+	bool Fire(const FVector& Location, const FVector& Direction, float Damage, AActor* Owner, float TimeInFlight = 0.0f);
+
+	// Advances every bullet by DeltaTime. Tick calls this, tests and benchmarks drive it directly.
+	void StepProjectiles(float DeltaTime);
+
+	void RemoveAll();
+
+	int32 GetNumProjectiles() const { return Positions.Num(); }
+	const FVector& GetProjectileLocation(int32 Index) const { return Positions[Index]; }
+
+	float Speed = 30000.0f;
+	float Radius = 15.0f;
+	float Lifetime = 3.0f;
+	float KnockbackStrength = UFPSDamageQueue::ImpactKnockbackStrength;
+	FName CollisionProfile = TEXT("Projectile");
+
+	// Sweeps are issued as async traces and their hits applied a frame later
+	bool bAsyncSweeps = false;
+
+	bool bRender = true;
+	int32 MaxProjectiles = 65536;
+
+protected:
+	void SweepImmediate(float DeltaTime);
+	void ResolveAsyncSweeps();
+	void IssueAsyncSweeps(float DeltaTime);
+	void ApplyHit(const FHitResult& Hit, float Damage, const AActor* Owner);
+	void Compact();
+	void UpdateInstances();
+
+	// Fragments, one entry per bullet
+	TArray<FVector> Positions;
+	TArray<FVector> Velocities;
+	TArray<float> Damages;
+	// Seconds since the bullet left the muzzle
+	TArray<float> Ages;
+	TArray<TWeakObjectPtr<AActor>> Owners;
+
+	// Scratch, sized to the bullet count
+	TArray<uint8> Dead;
+
+	// Async traces issued last frame, aligned with the first PendingTraces.Num() bullets
+	TArray<FTraceHandle> PendingTraces;
+
+	UPROPERTY()
+	UStaticMesh* Mesh = nullptr;
+
+	UPROPERTY()
+	UMaterialInterface* Material = nullptr;
+
+	UPROPERTY()
+	AActor* InstanceHost = nullptr;
+
+	UPROPERTY()
+	UInstancedStaticMeshComponent* Instances = nullptr;
+
+	FVector MeshScale = FVector::OneVector;
+	TArray<FTransform> InstanceTransforms;
+};
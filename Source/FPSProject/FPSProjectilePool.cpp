@@ -0,0 +1,101 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FPSProjectilePool.h"
+#include "FPSProject.h"
+#include "FPSProjectile.h"
+#include "Engine/World.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Projectiles In Use"), STAT_ProjectilePoolInUse, STATGROUP_FPSProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Projectile Pool High Water Mark"), STAT_ProjectilePoolHighWater, STATGROUP_FPSProject);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Projectile Pool Hit Rate"), STAT_ProjectilePoolHitRate, STATGROUP_FPSProject);
+
+void UFPSProjectilePool::Deinitialize() {
+	// Pooled actors belong to the world and go away with it
+	Buckets.Empty();
+	Stats = FProjectilePoolStats();
+	Super::Deinitialize();
+}
+
+void UFPSProjectilePool::Prewarm(TSubclassOf<AFPSProjectile> ProjectileClass, int32 Count) {
+	if (!ProjectileClass) return;
+
+	FProjectilePoolBucket& Bucket = Buckets.FindOrAdd(ProjectileClass.Get());
+	const int32 ToSpawn = Count - Bucket.Free.Num();
+	for (int32 i = 0; i < ToSpawn; i++) {
+		AFPSProjectile* Projectile = SpawnPooled(ProjectileClass.Get());
+		if (!Projectile) break;
+
+		Projectile->DeactivateToPool();
+		Bucket.Free.Add(Projectile);
+	}
+}
+
+AFPSProjectile* UFPSProjectilePool::Acquire(TSubclassOf<AFPSProjectile> ProjectileClass, const FVector& Location, const FRotator& Rotation, AActor* Owner, APawn* Instigator) {
+	if (!ProjectileClass) return nullptr;
+
+	AFPSProjectile* Projectile = nullptr;
+	FProjectilePoolBucket& Bucket = Buckets.FindOrAdd(ProjectileClass.Get());
+	while (Bucket.Free.Num() > 0 && !Projectile) {
+		AFPSProjectile* Candidate = Bucket.Free.Pop();
+		if (IsValid(Candidate)) {
+			Projectile = Candidate;
+		}
+	}
+
+	if (Projectile) {
+		Stats.Reused++;
+	}
+	else {
+		Projectile = SpawnPooled(ProjectileClass.Get());
+		if (!Projectile) return nullptr;
+		Stats.Spawned++;
+	}
+
+	Projectile->SetOwner(Owner);
+	Projectile->SetInstigator(Instigator);
+	Projectile->ActivateFromPool(Location, Rotation);
+
+	Stats.Acquired++;
+	Stats.InUse++;
+	Stats.HighWaterMark = FMath::Max(Stats.HighWaterMark, Stats.InUse);
+	UpdateStats();
+
+	return Projectile;
+}
+
+void UFPSProjectilePool::Release(AFPSProjectile* Projectile) {
+	if (!IsValid(Projectile) || !Projectile->bIsPooled || Projectile->bInPool) return;
+
+	Projectile->DeactivateToPool();
+	Buckets.FindOrAdd(Projectile->GetClass()).Free.Add(Projectile);
+
+	Stats.Released++;
+	Stats.InUse = FMath::Max(0, Stats.InUse - 1);
+	UpdateStats();
+}
+
+int32 UFPSProjectilePool::GetNumFree(TSubclassOf<AFPSProjectile> ProjectileClass) const {
+	const FProjectilePoolBucket* Bucket = Buckets.Find(ProjectileClass.Get());
+	return Bucket ? Bucket->Free.Num() : 0;
+}
+
+AFPSProjectile* UFPSProjectilePool::SpawnPooled(UClass* ProjectileClass) {
+	UWorld* World = GetWorld();
+	if (!World) return nullptr;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AFPSProjectile* Projectile = World->SpawnActor<AFPSProjectile>(ProjectileClass, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+	if (Projectile) {
+		Projectile->bIsPooled = true;
+	}
+	return Projectile;
+}
+
+void UFPSProjectilePool::UpdateStats() {
+	SET_DWORD_STAT(STAT_ProjectilePoolInUse, Stats.InUse);
+	SET_DWORD_STAT(STAT_ProjectilePoolHighWater, Stats.HighWaterMark);
+	SET_FLOAT_STAT(STAT_ProjectilePoolHitRate, Stats.GetHitRate());
+}
@@ -0,0 +1,77 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FPSProjectilePool.generated.h"
+
+class AFPSProjectile;
+
+USTRUCT(BlueprintType)
+struct FProjectilePoolStats {
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 Acquired = 0;
+
+	// Acquires served from an already pooled projectile
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 Reused = 0;
+
+	// Acquires that had to fall back to SpawnActor
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 Spawned = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 Released = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 InUse = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 HighWaterMark = 0;
+
+	float GetHitRate() const { return Acquired > 0 ? (float)Reused / (float)Acquired : 0.0f; }
+};
+
+USTRUCT()
+struct FProjectilePoolBucket {
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<AFPSProjectile*> Free;
+};
+
+/**
+ * Hands out pre-warmed projectiles and takes them back instead of spawning and destroying one per shot.
+ */
+UCLASS()
+class FPSPROJECT_API UFPSProjectilePool : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	UFUNCTION(BlueprintCallable, Category = "Projectile Pool")
+	void Prewarm(TSubclassOf<AFPSProjectile> ProjectileClass, int32 Count);
+
+	AFPSProjectile* Acquire(TSubclassOf<AFPSProjectile> ProjectileClass, const FVector& Location, const FRotator& Rotation, AActor* Owner = nullptr, APawn* Instigator = nullptr);
+
+	void Release(AFPSProjectile* Projectile);
+
+	UFUNCTION(BlueprintCallable, Category = "Projectile Pool")
+	FProjectilePoolStats GetStats() const { return Stats; }
+
+	int32 GetNumFree(TSubclassOf<AFPSProjectile> ProjectileClass) const;
+
+protected:
+	AFPSProjectile* SpawnPooled(UClass* ProjectileClass);
+	void UpdateStats();
+
+	UPROPERTY()
+	TMap<UClass*, FProjectilePoolBucket> Buckets;
+
+	FProjectilePoolStats Stats;
+};
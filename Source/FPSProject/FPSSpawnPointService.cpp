@@ -0,0 +1,259 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FPSSpawnPointService.h"
+#include "FPSProject.h"
+#include "Engine/World.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "Async/Async.h"
+
+DECLARE_CYCLE_STAT(TEXT("Spawn Point Refill Merge"), STAT_SpawnPointMerge, STATGROUP_FPSProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Spawn Point Reservoir Misses"), STAT_SpawnPointMisses, STATGROUP_FPSProject);
+
+void UFPSSpawnPointService::Initialize(FSubsystemCollectionBase& Collection) {
+	Super::Initialize(Collection);
+
+	// Finished refills are picked up at the start of the next world tick, a refill still running is left alone
+	TickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &UFPSSpawnPointService::HandleWorldTickStart);
+}
+
+void UFPSSpawnPointService::Deinitialize() {
+	FWorldDelegates::OnWorldTickStart.Remove(TickStartHandle);
+
+	if (RefillFuture.IsValid()) {
+		RefillFuture.Wait();
+		RefillFuture = TFuture<TArray<FRefillResult>>();
+	}
+	ReleaseNavigationLock();
+
+	if (UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld())) {
+		NavSys->OnNavigationGenerationFinishedDelegate.RemoveAll(this);
+	}
+
+	Reservoirs.Empty();
+	PendingRefills.Empty();
+	Super::Deinitialize();
+}
+
+void UFPSSpawnPointService::OnWorldBeginPlay(UWorld& InWorld) {
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(&InWorld)) {
+		NavSys->OnNavigationGenerationFinishedDelegate.AddUniqueDynamic(this, &UFPSSpawnPointService::HandleNavigationGenerationFinished);
+	}
+
+	// Spawners register in PostInitializeComponents, so their reservoirs are full before the first burst in BeginPlay
+	FlushRefill();
+}
+
+void UFPSSpawnPointService::RegisterReservoir(const FVector& Origin, float Radius, int32 TargetSize, float MinSpacing) {
+	const FSpawnPointReservoirKey Key(Origin, Radius);
+	FSpawnPointReservoir& Reservoir = Reservoirs.FindOrAdd(Key);
+	Reservoir.Origin = Origin;
+	Reservoir.Radius = Radius;
+	Reservoir.TargetSize = FMath::Max(1, TargetSize);
+	Reservoir.LowWaterMark = FMath::Max(1, Reservoir.TargetSize / 4);
+	Reservoir.MinSpacing = FMath::Max(0.0f, MinSpacing);
+
+	QueueRefill(Key);
+}
+
+bool UFPSSpawnPointService::TryTakePoint(const FVector& Origin, float Radius, FVector& OutPoint) {
+	if (Radius <= 0.0f) return false;
+
+	const FSpawnPointReservoirKey Key(Origin, Radius);
+	FSpawnPointReservoir* Reservoir = Reservoirs.Find(Key);
+	if (!Reservoir) {
+		RegisterReservoir(Origin, Radius);
+		Reservoir = Reservoirs.Find(Key);
+	}
+
+	bool bTaken = false;
+	if (Reservoir->Points.Num() > 0) {
+		// Points were sampled randomly, so order carries no bias and popping the tail is enough
+		OutPoint = Reservoir->Points.Pop();
+		bTaken = true;
+		ReservoirHits++;
+	}
+	else {
+		ReservoirMisses++;
+		INC_DWORD_STAT(STAT_SpawnPointMisses);
+	}
+
+	if (Reservoir->Points.Num() < Reservoir->LowWaterMark) {
+		QueueRefill(Key);
+	}
+	return bTaken;
+}
+
+void UFPSSpawnPointService::InvalidateAll() {
+	Generation++;
+	PendingRefills.Reset();
+	for (TPair<FSpawnPointReservoirKey, FSpawnPointReservoir>& Pair : Reservoirs) {
+		Pair.Value.Points.Reset();
+		Pair.Value.bRefillQueued = false;
+		QueueRefill(Pair.Key);
+	}
+}
+
+int32 UFPSSpawnPointService::GetNumCachedPoints(const FVector& Origin, float Radius) const {
+	const FSpawnPointReservoir* Reservoir = Reservoirs.Find(FSpawnPointReservoirKey(Origin, Radius));
+	return Reservoir ? Reservoir->Points.Num() : 0;
+}
+
+void UFPSSpawnPointService::FlushRefill() {
+	if (!RefillFuture.IsValid()) {
+		KickRefill();
+	}
+	if (RefillFuture.IsValid()) {
+		RefillFuture.Wait();
+	}
+	MergeRefill();
+}
+
+void UFPSSpawnPointService::QueueRefill(const FSpawnPointReservoirKey& Key) {
+	FSpawnPointReservoir* Reservoir = Reservoirs.Find(Key);
+	if (!Reservoir || Reservoir->bRefillQueued) return;
+
+	Reservoir->bRefillQueued = true;
+	PendingRefills.Add(Key);
+	KickRefill();
+}
+
+void UFPSSpawnPointService::KickRefill() {
+	if (RefillFuture.IsValid() || PendingRefills.Num() == 0) return;
+
+	UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld());
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : nullptr;
+	if (!NavData || NavSys->IsNavigationBuildInProgress()) return;
+
+	TArray<FRefillRequest> Requests;
+	for (const FSpawnPointReservoirKey& Key : PendingRefills) {
+		const FSpawnPointReservoir* Reservoir = Reservoirs.Find(Key);
+		if (!Reservoir) continue;
+
+		FRefillRequest& Request = Requests.AddDefaulted_GetRef();
+		Request.Key = Key;
+		Request.Origin = Reservoir->Origin;
+		Request.Radius = Reservoir->Radius;
+		Request.MinSpacing = Reservoir->MinSpacing;
+		Request.NumWanted = Reservoir->TargetSize - Reservoir->Points.Num();
+		Request.Existing = Reservoir->Points;
+	}
+	PendingRefills.Reset();
+
+	// Nothing is being built right now and the lock keeps it that way, so no tile is attached or removed while the worker reads the navmesh
+	NavSys->AddNavigationBuildLock(ENavigationBuildLock::Custom);
+	bHoldsNavigationLock = true;
+
+	InFlightGeneration = Generation;
+	RefillFuture = Async(EAsyncExecution::ThreadPool, [NavData, Requests = MoveTemp(Requests)]() mutable {
+		return RunRefill(NavData, MoveTemp(Requests));
+		});
+}
+
+void UFPSSpawnPointService::MergeRefill() {
+	// Still sampling, a later tick merges it
+	if (!RefillFuture.IsValid() || !RefillFuture.IsReady()) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_SpawnPointMerge);
+
+	TArray<FRefillResult> Results = RefillFuture.Get();
+	RefillFuture = TFuture<TArray<FRefillResult>>();
+	ReleaseNavigationLock();
+
+	// The navmesh was rebuilt while sampling, the points may no longer be reachable
+	const bool bStale = InFlightGeneration != Generation;
+
+	for (FRefillResult& Result : Results) {
+		FSpawnPointReservoir* Reservoir = Reservoirs.Find(Result.Key);
+		if (!Reservoir) continue;
+
+		Reservoir->bRefillQueued = false;
+		if (bStale) {
+			QueueRefill(Result.Key);
+			continue;
+		}
+		Reservoir->Points.Append(Result.Points);
+	}
+
+	KickRefill();
+}
+
+void UFPSSpawnPointService::ReleaseNavigationLock() {
+	if (!bHoldsNavigationLock) return;
+	bHoldsNavigationLock = false;
+
+	// Dirty areas gathered meanwhile are built on the next navigation tick, nothing needs a full rebuild
+	if (UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld())) {
+		NavSys->RemoveNavigationBuildLock(ENavigationBuildLock::Custom, UNavigationSystemV1::ELockRemovalRebuildAction::NoRebuild);
+	}
+}
+
+void UFPSSpawnPointService::HandleWorldTickStart(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds) {
+	if (InWorld != GetWorld()) return;
+
+	if (RefillFuture.IsValid()) {
+		MergeRefill();
+	}
+	else {
+		KickRefill();
+	}
+}
+
+void UFPSSpawnPointService::HandleNavigationGenerationFinished(ANavigationData* NavData) {
+	InvalidateAll();
+}
+
+TArray<UFPSSpawnPointService::FRefillResult> UFPSSpawnPointService::RunRefill(const ANavigationData* NavData, TArray<FRefillRequest> Requests) {
+	TArray<FRefillResult> Results;
+	Results.Reserve(Requests.Num());
+
+	for (const FRefillRequest& Request : Requests) {
+		FRefillResult& Result = Results.AddDefaulted_GetRef();
+		Result.Key = Request.Key;
+		SamplePoissonDisk(NavData, Request, Result.Points);
+	}
+	return Results;
+}
+
+void UFPSSpawnPointService::SamplePoissonDisk(const ANavigationData* NavData, const FRefillRequest& Request, TArray<FVector>& OutPoints) {
+	if (!NavData || Request.NumWanted <= 0) return;
+
+	// Dart throwing against a background grid with cells of MinSpacing / sqrt(2), so each cell holds at most one point
+	const float Spacing = Request.MinSpacing;
+	const float SpacingSq = Spacing * Spacing;
+	const float CellSize = FMath::Max(Spacing / UE_SQRT_2, 1.0f);
+
+	TMap<FIntPoint, FVector> Grid;
+	auto CellOf = [&Request, CellSize](const FVector& P) {
+		return FIntPoint(FMath::FloorToInt((P.X - Request.Origin.X) / CellSize), FMath::FloorToInt((P.Y - Request.Origin.Y) / CellSize));
+	};
+	auto IsFarEnough = [&Grid, &CellOf, SpacingSq](const FVector& P) {
+		const FIntPoint Cell = CellOf(P);
+		for (int32 DX = -2; DX <= 2; DX++) {
+			for (int32 DY = -2; DY <= 2; DY++) {
+				if (const FVector* Other = Grid.Find(FIntPoint(Cell.X + DX, Cell.Y + DY))) {
+					if (FVector::DistSquared2D(*Other, P) < SpacingSq) return false;
+				}
+			}
+		}
+		return true;
+	};
+
+	for (const FVector& P : Request.Existing) {
+		Grid.Add(CellOf(P), P);
+	}
+
+	const int32 MaxAttempts = Request.NumWanted * 30;
+	for (int32 Attempt = 0; Attempt < MaxAttempts && OutPoints.Num() < Request.NumWanted; Attempt++) {
+		FNavLocation NavLoc;
+		if (!NavData->GetRandomReachablePointInRadius(Request.Origin, Request.Radius, NavLoc)) continue;
+
+		if (Spacing > 0.0f && !IsFarEnough(NavLoc.Location)) continue;
+
+		Grid.Add(CellOf(NavLoc.Location), NavLoc.Location);
+		OutPoints.Add(NavLoc.Location);
+	}
+}
@@ -0,0 +1,110 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Async/Future.h"
+#include "FPSSpawnPointService.generated.h"
+
+class ANavigationData;
+
+struct FSpawnPointReservoirKey {
+	FIntVector Origin = FIntVector::ZeroValue;
+	int32 Radius = 0;
+
+	FSpawnPointReservoirKey() {}
+	FSpawnPointReservoirKey(const FVector& InOrigin, float InRadius)
+		: Origin(FMath::RoundToInt(InOrigin.X), FMath::RoundToInt(InOrigin.Y), FMath::RoundToInt(InOrigin.Z))
+		, Radius(FMath::RoundToInt(InRadius)) {}
+
+	bool operator==(const FSpawnPointReservoirKey& Other) const {
+		return Origin == Other.Origin && Radius == Other.Radius;
+	}
+
+	friend uint32 GetTypeHash(const FSpawnPointReservoirKey& Key) {
+		return HashCombine(GetTypeHash(Key.Origin), GetTypeHash(Key.Radius));
+	}
+};
+
+struct FSpawnPointReservoir {
+	FVector Origin = FVector::ZeroVector;
+	float Radius = 0.0f;
+	int32 TargetSize = 32;
+	int32 LowWaterMark = 8;
+	float MinSpacing = 150.0f;
+	TArray<FVector> Points;
+	bool bRefillQueued = false;
+};
+
+/**
+ * Keeps per origin/radius reservoirs of reachable navmesh points so spawners take a point in O(1) instead of
+ * querying the navmesh on the game thread. Reservoirs are refilled on a worker thread with Poisson-disk spacing,
+ * with navmesh building locked until the refill is merged, and thrown away whenever the navmesh is rebuilt.
+ * Reservoirs registered before the world begins play are filled up front.
+ */
+UCLASS()
+class FPSPROJECT_API UFPSSpawnPointService : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	// Creates the reservoir if needed and queues its first refill, ideally called from PostInitializeComponents
+	void RegisterReservoir(const FVector& Origin, float Radius, int32 TargetSize = 32, float MinSpacing = 150.0f);
+
+	// Pops a pre-sampled point. Returns false when the reservoir is empty, callers should fall back to a direct query.
+	bool TryTakePoint(const FVector& Origin, float Radius, FVector& OutPoint);
+
+	// Drops every cached point, e.g. after the navmesh changed
+	void InvalidateAll();
+
+	int32 GetNumCachedPoints(const FVector& Origin, float Radius) const;
+
+	// Blocks until the in-flight refill is done and merges it. Tests and loading screens use this.
+	void FlushRefill();
+
+	int32 ReservoirHits = 0;
+	int32 ReservoirMisses = 0;
+
+protected:
+	struct FRefillRequest {
+		FSpawnPointReservoirKey Key;
+		FVector Origin;
+		float Radius;
+		float MinSpacing;
+		int32 NumWanted;
+		TArray<FVector> Existing;
+	};
+
+	struct FRefillResult {
+		FSpawnPointReservoirKey Key;
+		TArray<FVector> Points;
+	};
+
+	static TArray<FRefillResult> RunRefill(const ANavigationData* NavData, TArray<FRefillRequest> Requests);
+	static void SamplePoissonDisk(const ANavigationData* NavData, const FRefillRequest& Request, TArray<FVector>& OutPoints);
+
+	void QueueRefill(const FSpawnPointReservoirKey& Key);
+	void KickRefill();
+	// Merges a finished refill, returns at once while the worker is still sampling
+	void MergeRefill();
+	void ReleaseNavigationLock();
+	void HandleWorldTickStart(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+
+	UFUNCTION()
+	void HandleNavigationGenerationFinished(ANavigationData* NavData);
+
+	TMap<FSpawnPointReservoirKey, FSpawnPointReservoir> Reservoirs;
+	TArray<FSpawnPointReservoirKey> PendingRefills;
+
+	TFuture<TArray<FRefillResult>> RefillFuture;
+	int32 Generation = 0;
+	int32 InFlightGeneration = 0;
+	bool bHoldsNavigationLock = false;
+
+	FDelegateHandle TickStartHandle;
+};
@@ -0,0 +1,345 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FPSSwarmSubsystem.h"
+#include "FPSProject.h"
+#include "FPSEnemyDumb.h"
+#include "FPSEnemyPool.h"
+#include "FPSEnemySpawnManager.h"
+#include "FPSCharacter.h"
+#include "FPSFlowField.h"
+#include "FPSDamageQueue.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "Async/ParallelFor.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Swarm Chase"), STAT_SwarmChase, STATGROUP_FPSProject);
+DECLARE_CYCLE_STAT(TEXT("Swarm Representation"), STAT_SwarmRepresentation, STATGROUP_FPSProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Swarm Agents"), STAT_SwarmAgents, STATGROUP_FPSProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Swarm Materialized Actors"), STAT_SwarmMaterialized, STATGROUP_FPSProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Swarm Proxy Instances"), STAT_SwarmProxies, STATGROUP_FPSProject);
+
+void UFPSSwarmSubsystem::Deinitialize() {
+	Positions.Empty();
+	Velocities.Empty();
+	Health.Empty();
+	ContactCooldowns.Empty();
+	TouchingTarget.Empty();
+	Actors.Empty();
+	Spawners.Empty();
+	AgentsPerSpawner.Empty();
+	ProxyHost = nullptr;
+	ProxyInstances = nullptr;
+	NumMaterialized = 0;
+	Super::Deinitialize();
+}
+
+TStatId UFPSSwarmSubsystem::GetStatId() const {
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFPSSwarmSubsystem, STATGROUP_Tickables);
+}
+
+void UFPSSwarmSubsystem::Tick(float DeltaTime) {
+	if (Positions.Num() == 0) return;
+
+	AFPSCharacter* Player = Cast<AFPSCharacter>(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0));
+	if (!Player || Player->bIsDead) return;
+
+	StepSwarm(Player->GetActorLocation(), Player, DeltaTime);
+}
+
+void UFPSSwarmSubsystem::Configure(TSubclassOf<AFPSEnemyDumb> InActorClass, UStaticMesh* InProxyMesh) {
+	if (!InActorClass) return;
+
+	ActorClass = InActorClass;
+	const AFPSEnemyDumb* CDO = InActorClass->GetDefaultObject<AFPSEnemyDumb>();
+	MaxHealth = CDO->MaxHealth;
+	ContactDamage = CDO->ContactDamage;
+	if (CDO->GetCharacterMovement()) {
+		MoveSpeed = CDO->GetCharacterMovement()->MaxWalkSpeed;
+	}
+
+	if (!InProxyMesh || ProxyMesh == InProxyMesh) return;
+	ProxyMesh = InProxyMesh;
+
+	if (!ProxyHost) {
+		FActorSpawnParameters Params;
+		Params.ObjectFlags |= RF_Transient;
+		ProxyHost = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, Params);
+		if (!ProxyHost) return;
+
+		ProxyInstances = NewObject<UInstancedStaticMeshComponent>(ProxyHost, TEXT("SwarmProxies"));
+		ProxyInstances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		ProxyInstances->SetCanEverAffectNavigation(false);
+		ProxyHost->SetRootComponent(ProxyInstances);
+		ProxyInstances->RegisterComponent();
+	}
+	ProxyInstances->SetStaticMesh(ProxyMesh);
+}
+
+int32 UFPSSwarmSubsystem::SpawnAgent(const FVector& Location, AFPSEnemySpawnManager* Spawner) {
+	if (!ActorClass) return INDEX_NONE;
+
+	Positions.Add(Location);
+	Velocities.Add(FVector::ZeroVector);
+	Health.Add(MaxHealth);
+	ContactCooldowns.Add(0.0f);
+	TouchingTarget.Add(0);
+	Actors.Add(nullptr);
+	AgentsPerSpawner.FindOrAdd(Spawner)++;
+	return Spawners.Add(Spawner);
+}
+
+void UFPSSwarmSubsystem::RemoveAllAgents() {
+	for (int32 i = 0; i < Actors.Num(); i++) {
+		if (Actors[i]) {
+			Dematerialize(i);
+		}
+	}
+
+	Positions.Reset();
+	Velocities.Reset();
+	Health.Reset();
+	ContactCooldowns.Reset();
+	TouchingTarget.Reset();
+	Actors.Reset();
+	Spawners.Reset();
+	AgentsPerSpawner.Reset();
+
+	if (ProxyInstances) {
+		ProxyInstances->ClearInstances();
+	}
+	UpdateStats();
+}
+
+int32 UFPSSwarmSubsystem::GetNumAgentsOwnedBy(const AFPSEnemySpawnManager* Spawner) const {
+	const int32* Count = AgentsPerSpawner.Find(Spawner);
+	return Count ? *Count : 0;
+}
+
+void UFPSSwarmSubsystem::NotifyMaterializedDeath(AFPSEnemyDumb* Enemy) {
+	const int32 Index = Enemy ? Enemy->SwarmAgentIndex : INDEX_NONE;
+	if (!Actors.IsValidIndex(Index) || Actors[Index] != Enemy) return;
+
+	AFPSEnemySpawnManager* Spawner = Spawners[Index];
+
+	Enemy->SwarmAgentIndex = INDEX_NONE;
+	Actors[Index] = nullptr;
+	NumMaterialized--;
+	RemoveAgent(Index);
+
+	if (IsValid(Spawner)) {
+		Spawner->NotifySwarmEnemyDeath();
+	}
+	UpdateStats();
+}
+
+void UFPSSwarmSubsystem::StepSwarm(const FVector& TargetLocation, AFPSCharacter* TargetCharacter, float DeltaTime) {
+	// Materialised agents are driven by their actor, pull their state back into the fragments first
+	NumMaterialized = 0;
+	for (int32 i = 0; i < Actors.Num(); i++) {
+		AFPSEnemyDumb* Enemy = Actors[i];
+		if (!Enemy) continue;
+
+		// Destroyed from outside (level cleanup, perf tests), the agent carries on as data
+		if (!IsValid(Enemy) || Enemy->IsInPool()) {
+			Actors[i] = nullptr;
+			continue;
+		}
+
+		Positions[i] = Enemy->GetActorLocation();
+		Velocities[i] = Enemy->GetVelocity();
+		Health[i] = Enemy->CurrentHealth;
+		NumMaterialized++;
+	}
+
+	UFPSCrowdSeparation::ComputeSeparation(Positions, SeparationRadius, SeparationStrength, SeparationOffsets, SeparationHash);
+	RunChase(TargetLocation, DeltaTime);
+	ApplyContacts(TargetCharacter);
+	UpdateRepresentation(TargetLocation);
+	UpdateStats();
+}
+
+void UFPSSwarmSubsystem::RunChase(const FVector& TargetLocation, float DeltaTime) {
+	SCOPE_CYCLE_COUNTER(STAT_SwarmChase);
+
+	const int32 Num = Positions.Num();
+	const int32 Chunk = FMath::Max(1, ChunkSize);
+	const int32 NumChunks = FMath::DivideAndRoundUp(Num, Chunk);
+	const float ContactRadiusSq = ContactRadius * ContactRadius;
+
+	// Read only while the chase runs, the flow field only changes in its own tick
+	const UFPSFlowField* FlowField = GetWorld() ? GetWorld()->GetSubsystem<UFPSFlowField>() : nullptr;
+
+	// Every chunk only touches its own slice of the fragments, so no locking is needed
+	ParallelFor(NumChunks, [&](int32 ChunkIndex) {
+		const int32 Start = ChunkIndex * Chunk;
+		const int32 End = FMath::Min(Start + Chunk, Num);
+		for (int32 i = Start; i < End; i++) {
+			ContactCooldowns[i] = FMath::Max(0.0f, ContactCooldowns[i] - DeltaTime);
+			if (Actors[i]) {
+				TouchingTarget[i] = 0;
+				continue;
+			}
+
+			FVector ToTarget = TargetLocation - Positions[i];
+			ToTarget.Z = 0.0f;
+			const float DistSq = ToTarget.SizeSquared();
+
+			TouchingTarget[i] = DistSq <= ContactRadiusSq && ContactCooldowns[i] <= 0.0f;
+
+			const float Dist = FMath::Sqrt(DistSq);
+			FVector Direction;
+			float MaxStep = MoveSpeed * DeltaTime;
+			if (!FlowField || !FlowField->GetDirection(Positions[i], Direction)) {
+				Direction = Dist > KINDA_SMALL_NUMBER ? ToTarget / Dist : FVector::ZeroVector;
+				MaxStep = FMath::Min(MaxStep, Dist);
+			}
+			Direction = (Direction + SeparationOffsets[i]).GetClampedToMaxSize(1.0f);
+			Velocities[i] = Direction * MoveSpeed;
+			Positions[i] += Direction * MaxStep;
+		}
+		});
+}
+
+void UFPSSwarmSubsystem::ApplyContacts(AFPSCharacter* TargetCharacter) {
+	UFPSDamageQueue* DamageQueue = GetWorld() ? GetWorld()->GetSubsystem<UFPSDamageQueue>() : nullptr;
+	if (!TargetCharacter || !DamageQueue) return;
+
+	for (int32 i = 0; i < TouchingTarget.Num(); i++) {
+		if (!TouchingTarget[i]) continue;
+
+		// Same damage and knockback as AFPSEnemyBase::OnOverlapBegin
+		FVector KnockbackDirection = TargetCharacter->GetActorLocation() - Positions[i];
+		KnockbackDirection.Z = 0;
+		KnockbackDirection.Normalize();
+
+		float KnockbackStrength = 800.f;
+		DamageQueue->QueueDamage(TargetCharacter, ContactDamage, KnockbackDirection * KnockbackStrength + FVector(0, 0, 300.f));
+
+		ContactCooldowns[i] = ContactCooldown;
+	}
+}
+
+void UFPSSwarmSubsystem::UpdateRepresentation(const FVector& ViewLocation) {
+	SCOPE_CYCLE_COUNTER(STAT_SwarmRepresentation);
+
+	const float MaterializeSq = FMath::Square(ActorDistance);
+	const float DematerializeSq = FMath::Square(ActorDistance * (1.0f + Hysteresis));
+
+	// Free slots first so the closest agents can take them this frame
+	TArray<TPair<float, int32>> Candidates;
+	for (int32 i = 0; i < Positions.Num(); i++) {
+		const float DistSq = FVector::DistSquared(ViewLocation, Positions[i]);
+		if (Actors[i]) {
+			if (DistSq > DematerializeSq) {
+				Dematerialize(i);
+			}
+		}
+		else if (DistSq <= MaterializeSq) {
+			Candidates.Emplace(DistSq, i);
+		}
+	}
+
+	const int32 FreeSlots = MaxMaterializedActors - NumMaterialized;
+	if (Candidates.Num() > FreeSlots) {
+		Candidates.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B) {
+			return A.Key < B.Key;
+			});
+	}
+	for (int32 i = 0; i < Candidates.Num() && NumMaterialized < MaxMaterializedActors; i++) {
+		Materialize(Candidates[i].Value);
+	}
+
+	UpdateProxies(ViewLocation);
+}
+
+void UFPSSwarmSubsystem::UpdateProxies(const FVector& ViewLocation) {
+	if (!ProxyInstances) return;
+
+	const float ProxySq = FMath::Square(ProxyDistance);
+
+	ProxyTransforms.Reset();
+	for (int32 i = 0; i < Positions.Num(); i++) {
+		if (Actors[i] || FVector::DistSquared(ViewLocation, Positions[i]) > ProxySq) continue;
+
+		const FRotator Facing = Velocities[i].IsNearlyZero() ? FRotator::ZeroRotator : Velocities[i].Rotation();
+		ProxyTransforms.Emplace(FRotator(0.0f, Facing.Yaw, 0.0f), Positions[i] + FVector(0.0f, 0.0f, ProxyZOffset));
+	}
+
+	// The proxy set changes size when agents cross the distance bands, otherwise only transforms move
+	if (ProxyInstances->GetInstanceCount() != ProxyTransforms.Num()) {
+		ProxyInstances->ClearInstances();
+		ProxyInstances->AddInstances(ProxyTransforms, false);
+	}
+	else if (ProxyTransforms.Num() > 0) {
+		ProxyInstances->BatchUpdateInstancesTransforms(0, ProxyTransforms, false, true, true);
+	}
+}
+
+void UFPSSwarmSubsystem::Materialize(int32 Index) {
+	UFPSEnemyPool* Pool = GetWorld()->GetSubsystem<UFPSEnemyPool>();
+	if (!Pool) return;
+
+	const FRotator Facing = Velocities[Index].IsNearlyZero() ? FRotator::ZeroRotator : FRotator(0.0f, Velocities[Index].Rotation().Yaw, 0.0f);
+	AFPSEnemyDumb* Enemy = Cast<AFPSEnemyDumb>(Pool->Acquire(ActorClass, Positions[Index], Facing));
+	if (!Enemy) return;
+
+	// Kills are reported through NotifyMaterializedDeath, not the spawner's actor list
+	Enemy->OwningSpawner = nullptr;
+	Enemy->SwarmAgentIndex = Index;
+	Enemy->CurrentHealth = Health[Index];
+	Enemy->GetCharacterMovement()->Velocity = Velocities[Index];
+
+	Actors[Index] = Enemy;
+	NumMaterialized++;
+}
+
+void UFPSSwarmSubsystem::Dematerialize(int32 Index) {
+	AFPSEnemyDumb* Enemy = Actors[Index];
+	Actors[Index] = nullptr;
+	NumMaterialized--;
+	if (!IsValid(Enemy)) return;
+
+	Positions[Index] = Enemy->GetActorLocation();
+	Velocities[Index] = Enemy->GetVelocity();
+	Health[Index] = Enemy->CurrentHealth;
+	Enemy->SwarmAgentIndex = INDEX_NONE;
+
+	UFPSEnemyPool* Pool = GetWorld()->GetSubsystem<UFPSEnemyPool>();
+	if (Pool && Enemy->IsPooled()) {
+		Pool->Release(Enemy);
+	}
+	else {
+		Enemy->Destroy();
+	}
+}
+
+void UFPSSwarmSubsystem::RemoveAgent(int32 Index) {
+	if (int32* Count = AgentsPerSpawner.Find(Spawners[Index])) {
+		if (--(*Count) <= 0) {
+			AgentsPerSpawner.Remove(Spawners[Index]);
+		}
+	}
+
+	Positions.RemoveAtSwap(Index);
+	Velocities.RemoveAtSwap(Index);
+	Health.RemoveAtSwap(Index);
+	ContactCooldowns.RemoveAtSwap(Index);
+	TouchingTarget.RemoveAtSwap(Index);
+	Actors.RemoveAtSwap(Index);
+	Spawners.RemoveAtSwap(Index);
+
+	// The last agent moved into the hole, its actor has to learn the new index
+	if (Actors.IsValidIndex(Index) && Actors[Index]) {
+		Actors[Index]->SwarmAgentIndex = Index;
+	}
+}
+
+void UFPSSwarmSubsystem::UpdateStats() {
+	SET_DWORD_STAT(STAT_SwarmAgents, Positions.Num());
+	SET_DWORD_STAT(STAT_SwarmMaterialized, NumMaterialized);
+	SET_DWORD_STAT(STAT_SwarmProxies, ProxyTransforms.Num());
+}
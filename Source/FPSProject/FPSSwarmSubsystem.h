@@ -0,0 +1,117 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FPSCrowdSeparation.h"
+#include "FPSSwarmSubsystem.generated.h"
+
+class AFPSEnemyDumb;
+class AFPSEnemySpawnManager;
+class AFPSCharacter;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+
+/**
+ * Runs dumb enemies as plain data instead of characters. Position, velocity and health live in flat arrays and a
+ * chase pass steers them toward the player in parallel chunks. Agents near the player are materialised as pooled
+ * AFPSEnemyDumb actors so they can be shot, farther ones are drawn as instances of a proxy mesh, and the farthest
+ * are not drawn at all.
+ */
+UCLASS()
+class FPSPROJECT_API UFPSSwarmSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Actor class used for materialised agents, its CDO also provides health, speed and contact damage
+	void Configure(TSubclassOf<AFPSEnemyDumb> InActorClass, UStaticMesh* InProxyMesh);
+	bool IsConfigured() const { return ActorClass != nullptr; }
+
+	// Returns the agent index, or INDEX_NONE when the swarm is not configured
+	int32 SpawnAgent(const FVector& Location, AFPSEnemySpawnManager* Spawner);
+
+	void RemoveAllAgents();
+
+	int32 GetNumAgents() const { return Positions.Num(); }
+	int32 GetNumMaterialized() const { return NumMaterialized; }
+	int32 GetNumAgentsOwnedBy(const AFPSEnemySpawnManager* Spawner) const;
+
+	const FVector& GetAgentLocation(int32 Index) const { return Positions[Index]; }
+	AFPSEnemyDumb* GetAgentActor(int32 Index) const { return Actors[Index]; }
+
+	// Called by a materialised actor when it dies, removes the agent and reports the kill to its spawner
+	void NotifyMaterializedDeath(AFPSEnemyDumb* Enemy);
+
+	// Runs one frame against an explicit target, Tick uses the player's location. Exposed for tests and benchmarks.
+	void StepSwarm(const FVector& TargetLocation, AFPSCharacter* TargetCharacter, float DeltaTime);
+
+	// Agents closer than this become actors, and go back to data past ActorDistance * (1 + Hysteresis)
+	float ActorDistance = 2500.0f;
+	float Hysteresis = 0.2f;
+	int32 MaxMaterializedActors = 64;
+
+	// Agents beyond this are simulated but not drawn
+	float ProxyDistance = 15000.0f;
+	float ProxyZOffset = 0.0f;
+
+	float ContactRadius = 80.0f;
+	float ContactCooldown = 1.0f;
+	int32 ChunkSize = 256;
+
+	// Simulated agents steer apart instead of stacking on the same flow field line
+	float SeparationRadius = 120.0f;
+	float SeparationStrength = 1.0f;
+
+protected:
+	void RunChase(const FVector& TargetLocation, float DeltaTime);
+	void ApplyContacts(AFPSCharacter* TargetCharacter);
+	void UpdateRepresentation(const FVector& ViewLocation);
+	void UpdateProxies(const FVector& ViewLocation);
+	void Materialize(int32 Index);
+	void Dematerialize(int32 Index);
+	void RemoveAgent(int32 Index);
+	void UpdateStats();
+
+	UPROPERTY()
+	TSubclassOf<AFPSEnemyDumb> ActorClass;
+
+	UPROPERTY()
+	UStaticMesh* ProxyMesh = nullptr;
+
+	UPROPERTY()
+	AActor* ProxyHost = nullptr;
+
+	UPROPERTY()
+	UInstancedStaticMeshComponent* ProxyInstances = nullptr;
+
+	float MoveSpeed = 600.0f;
+	float MaxHealth = 40.0f;
+	float ContactDamage = 20.0f;
+
+	// Fragments, one entry per agent
+	TArray<FVector> Positions;
+	TArray<FVector> Velocities;
+	TArray<float> Health;
+	TArray<float> ContactCooldowns;
+	TArray<uint8> TouchingTarget;
+	TArray<FVector> SeparationOffsets;
+
+	UPROPERTY()
+	TArray<AFPSEnemyDumb*> Actors;
+
+	UPROPERTY()
+	TArray<AFPSEnemySpawnManager*> Spawners;
+
+	TMap<const AFPSEnemySpawnManager*, int32> AgentsPerSpawner;
+
+	FCrowdSpatialHash SeparationHash;
+
+	TArray<FTransform> ProxyTransforms;
+	int32 NumMaterialized = 0;
+};
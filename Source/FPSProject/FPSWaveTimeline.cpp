@@ -0,0 +1,14 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FPSWaveTimeline.h"
+
+int32 UFPSWaveTimeline::GetFiniteEnemyCount() const {
+	int32 Total = 0;
+	for (const FWaveSpawnEvent& Event : Events) {
+		if (Event.Repeats >= 0) {
+			Total += Event.Count * (Event.Repeats + 1);
+		}
+	}
+	return Total;
+}
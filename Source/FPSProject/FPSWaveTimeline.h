@@ -0,0 +1,94 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "FPSWaveTimeline.generated.h"
+
+UENUM(BlueprintType)
+enum class EWaveTriggerType : uint8 {
+	AtTime UMETA(DisplayName = "At Time"),
+	OnKillCount UMETA(DisplayName = "On Kill Count"),
+	OnAllEnemiesDead UMETA(DisplayName = "On All Enemies Dead")
+};
+
+UENUM(BlueprintType)
+enum class EWaveEnemyType : uint8 {
+	Smart,
+	Dumb,
+	Random UMETA(DisplayName = "Random (coin flip)")
+};
+
+UENUM(BlueprintType)
+enum class EWaveKillFilter : uint8 {
+	Any,
+	Smart,
+	Dumb
+};
+
+USTRUCT(BlueprintType)
+struct FWaveSpawnEvent {
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FName Name;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EWaveTriggerType Trigger = EWaveTriggerType::AtTime;
+
+	// AtTime: seconds after the timeline starts. Other triggers: delay after the trigger fires.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Time = 0.0f;
+
+	// Kills (of KillFilter type) needed before the trigger can fire. Also gates OnAllEnemiesDead.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (EditCondition = "Trigger != EWaveTriggerType::AtTime", ClampMin = "0"))
+	int32 KillCount = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (EditCondition = "Trigger != EWaveTriggerType::AtTime"))
+	EWaveKillFilter KillFilter = EWaveKillFilter::Any;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EWaveEnemyType EnemyType = EWaveEnemyType::Dumb;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	int32 Count = 1;
+
+	// Spawns are skipped while this many enemies of the spawned type are alive. 0 means uncapped.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	int32 MaxAlive = 0;
+
+	// Extra times the event fires after the first, RepeatInterval apart. -1 repeats forever.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "-1"))
+	int32 Repeats = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float RepeatInterval = 5.0f;
+
+	// Stops further repeats once this many kills (of StopKillFilter type) happened. 0 never stops.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	int32 StopAfterKills = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EWaveKillFilter StopKillFilter = EWaveKillFilter::Any;
+};
+
+/**
+ * Authorable list of spawn events that AFPSEnemySpawnManager schedules with timers and kill notifications.
+ */
+UCLASS(BlueprintType)
+class FPSPROJECT_API UFPSWaveTimeline : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Waves")
+	TArray<FWaveSpawnEvent> Events;
+
+	// Hard cap on enemies alive from this timeline. 0 means uncapped.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Waves", meta = (ClampMin = "0"))
+	int32 MaxAliveTotal = 0;
+
+	// Enemies spawned by events that fire a bounded number of times, useful for sizing pools
+	int32 GetFiniteEnemyCount() const;
+};
@@ -6,6 +6,14 @@
 #include "TimerManager.h"
 #include "Engine/Engine.h"
 #include "FPSCharacter.h"
+#include "HAL/IConsoleManager.h"
+
+#if !UE_BUILD_SHIPPING
+static TAutoConsoleVariable<bool> CVarWeaponShotMessages(
+	TEXT("fps.Weapon.ShotMessages"),
+	false,
+	TEXT("Prints an on-screen message with the ammo left for every batch of shots a weapon fires."));
+#endif
 
 // Sets default values
 AFPSWeaponBase::AFPSWeaponBase()
@@ -13,6 +21,8 @@ AFPSWeaponBase::AFPSWeaponBase()
  	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 
 	PrimaryActorTick.bCanEverTick = true;
+	// Only ticks while the trigger is held or a cooldown is running
+	PrimaryActorTick.bStartWithTickEnabled = false;
 	BulletsInMag = MagazineSize;
 
 	MuzzleComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Muzzle"));
@@ -25,6 +35,7 @@ void AFPSWeaponBase::BeginPlay()
 {
 	Super::BeginPlay();
 	BulletsInMag = MagazineSize;
+	NotifyAmmoChanged();
 	
 }
 
@@ -33,13 +44,11 @@ void AFPSWeaponBase::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	UpdateFiring(DeltaTime);
 }
 
 bool AFPSWeaponBase::CanFire() const {
-	float TimeBetweenShots = 1.f / FireRate;
-	float Now = GetWorld()->GetTimeSeconds();
-	
-	return !bIsReloading && BulletsInMag > 0 && (Now - LastFireTime) >= TimeBetweenShots;
+	return !bIsReloading && BulletsInMag > 0 && ShotCooldown <= 0.0f;
 }
 
 void AFPSWeaponBase::Fire() {
@@ -48,12 +57,71 @@ void AFPSWeaponBase::Fire() {
 	}
 
 	BulletsInMag--;
-	LastFireTime = GetWorld()->GetTimeSeconds();
-	GEngine->AddOnScreenDebugMessage(-1, 0.5f, FColor::Yellow, FString::Printf(TEXT("%s fired! Bullets left: %d"), *WeaponName, BulletsInMag));
+	ShotCooldown = FireRate > 0.0f ? 1.0f / FireRate : 0.0f;
+	CooldownArmedFrame = GFrameCounter;
+	SetActorTickEnabled(true);
+
+	ShotTimes.Reset();
+	ShotTimes.Add(0.0f);
+	DispatchShots();
+}
+
+void AFPSWeaponBase::StartFiring() {
+	bTriggerHeld = true;
+	SetActorTickEnabled(true);
+	Fire();
+}
+
+void AFPSWeaponBase::StopFiring() {
+	bTriggerHeld = false;
+}
+
+int32 AFPSWeaponBase::UpdateFiring(float DeltaTime) {
+	ShotTimes.Reset();
+
+	// The cooldown only starts counting with the next frame when the shot came earlier in this one
+	if (GFrameCounter == CooldownArmedFrame) {
+		DeltaTime = 0.0f;
+	}
+	ShotCooldown -= DeltaTime;
+
+	const bool bAutomatic = bTriggerHeld && FireMode == EWeaponFireMode::FullAuto && FireRate > 0.0f;
+	if (bAutomatic) {
+		// A negative cooldown is how long ago the next shot fell due, so every shot of a long frame gets its own time
+		const float TimeBetweenShots = 1.0f / FireRate;
+		while (ShotCooldown <= 0.0f && !bIsReloading && BulletsInMag > 0) {
+			ShotTimes.Add(FMath::Max(0.0f, DeltaTime + ShotCooldown));
+			BulletsInMag--;
+			ShotCooldown += TimeBetweenShots;
+		}
+	}
+
+	// No credit is banked while reloading or out of ammo
+	ShotCooldown = FMath::Max(ShotCooldown, 0.0f);
+
+	const int32 NumShots = ShotTimes.Num();
+	if (NumShots > 0) {
+		DispatchShots();
+	}
+
+	if (!bAutomatic && ShotCooldown <= 0.0f) {
+		SetActorTickEnabled(false);
+	}
+	return NumShots;
+}
+
+void AFPSWeaponBase::DispatchShots() {
+#if !UE_BUILD_SHIPPING
+	if (GEngine && CVarWeaponShotMessages.GetValueOnGameThread()) {
+		GEngine->AddOnScreenDebugMessage(-1, 0.5f, FColor::Yellow, FString::Printf(TEXT("%s fired! Bullets left: %d"), *WeaponName, BulletsInMag));
+	}
+#endif
+
+	NotifyAmmoChanged();
 
 	AFPSCharacter* OwnerCharacter = Cast<AFPSCharacter>(GetOwner());
 	if (OwnerCharacter) {
-		OwnerCharacter->HandleWeaponFired(this);
+		OwnerCharacter->HandleWeaponFired(this, ShotTimes);
 	}
 
 	if (BulletsInMag <= 0 && Magazines > 0) {
@@ -76,6 +144,19 @@ void AFPSWeaponBase::FinishReload() {
 	BulletsInMag += BulletsNeeded;
 	Magazines -= 1;
 	bIsReloading = false;
+	NotifyAmmoChanged();
+}
+
+void AFPSWeaponBase::ResetWeapon() {
+	StopFiring();
+	GetWorld()->GetTimerManager().ClearTimer(ReloadTimerHandle);
+	bIsReloading = false;
+	ShotCooldown = 0.0f;
+	SetActorTickEnabled(false);
+
+	BulletsInMag = MagazineSize;
+	Magazines = GetClass()->GetDefaultObject<AFPSWeaponBase>()->Magazines;
+	NotifyAmmoChanged();
 }
 
 FVector AFPSWeaponBase::GetMuzzleWorldLocation() const {
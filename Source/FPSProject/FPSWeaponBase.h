@@ -13,6 +13,16 @@ enum class EWeaponFireMode : uint8
 	FullAuto UMETA(DisplayName="Full-Auto")
 };
 
+// How a shot reaches its target, independent of the trigger behaviour above
+UENUM(BlueprintType)
+enum class EWeaponHitMode : uint8
+{
+	Projectile,
+	Hitscan
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnWeaponAmmoChanged, class AFPSWeaponBase*);
+
 UCLASS(Blueprintable)
 class FPSPROJECT_API AFPSWeaponBase : public AActor
 {
@@ -42,6 +52,20 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon")
 	float FireRate = 5.0f;
 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon")
+	EWeaponHitMode HitMode = EWeaponHitMode::Projectile;
+
+	// Traces per shot, each dealing full Damage. More than one makes a shotgun.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon", meta = (EditCondition = "HitMode == EWeaponHitMode::Hitscan", ClampMin = "1"))
+	int32 PelletCount = 1;
+
+	// Half angle of the cone pellets are spread in
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon", meta = (EditCondition = "HitMode == EWeaponHitMode::Hitscan", ClampMin = "0"))
+	float SpreadDegrees = 0.0f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon", meta = (EditCondition = "HitMode == EWeaponHitMode::Hitscan"))
+	float HitscanRange = 10000.0f;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon")
 	int32 MagazineSize = 7;
 
@@ -55,17 +79,43 @@ public:
 	float ReloadTime = 1.0f;
 
 	bool bIsReloading = false;
-	float LastFireTime = -1000.0f;
+
+	// Seconds until the next shot is allowed, counted down in Tick
+	float ShotCooldown = 0.0f;
 
 	UFUNCTION(BlueprintCallable, Category = "Weapon")
 	virtual bool CanFire() const;
 
+	// Fires a single shot right away if the cooldown allows it
 	UFUNCTION(BlueprintCallable, Category = "Weapon")
 	virtual void Fire();
 
+	// Pulls the trigger. Full-auto weapons keep firing from Tick until StopFiring, calling it again while held is harmless.
+	UFUNCTION(BlueprintCallable, Category = "Weapon")
+	void StartFiring();
+
+	UFUNCTION(BlueprintCallable, Category = "Weapon")
+	void StopFiring();
+
+	bool IsTriggerHeld() const { return bTriggerHeld; }
+
+	// Emits every shot that fell due during DeltaTime and hands them to the owner in one batch. Returns the shot count.
+	int32 UpdateFiring(float DeltaTime);
+
+	// Seconds after the start of the frame at which each shot of the last batch left the muzzle, oldest first
+	const TArray<float>& GetLastShotTimes() const { return ShotTimes; }
+
 	UFUNCTION(BlueprintCallable, Category = "Weapon")
 	virtual void Reload();
 
+	// Back to a full magazine and the default reserve, with any reload or trigger pull cancelled
+	void ResetWeapon();
+
+	// Fired whenever BulletsInMag or Magazines change. Code that edits them directly should call NotifyAmmoChanged.
+	FOnWeaponAmmoChanged OnAmmoChanged;
+
+	void NotifyAmmoChanged() { OnAmmoChanged.Broadcast(this); }
+
 	int32 GetTotalReserveBullets() const {
 		return Magazines * MagazineSize;
 	}
@@ -78,4 +128,12 @@ public:
 protected:
 	FTimerHandle ReloadTimerHandle;
 	void FinishReload();
+
+	void DispatchShots();
+
+	bool bTriggerHeld = false;
+	TArray<float> ShotTimes;
+
+	// Frame the last single shot armed the cooldown on, a tick later in that frame covers time from before the shot
+	uint64 CooldownArmedFrame = 0;
 };
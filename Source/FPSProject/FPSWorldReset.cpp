@@ -0,0 +1,200 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FPSWorldReset.h"
+#include "FPSProject.h"
+#include "FPSCharacter.h"
+#include "FPSEnemyBase.h"
+#include "FPSEnemySpawnManager.h"
+#include "FPSPickupSpawner.h"
+#include "FPSPickupField.h"
+#include "FPSSwarmSubsystem.h"
+#include "FPSProjectileManager.h"
+#include "FPSProjectile.h"
+#include "FPSHitscanSubsystem.h"
+#include "FPSDamageQueue.h"
+#include "FPSDamageOverTime.h"
+#include "PickupBase.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "TimerManager.h"
+#include "GameFramework/GameModeBase.h"
+#include "Kismet/GameplayStatics.h"
+
+DECLARE_CYCLE_STAT(TEXT("World Reset"), STAT_WorldReset, STATGROUP_FPSProject);
+
+void UFPSWorldReset::Deinitialize() {
+	PlacedPickups.Empty();
+	PlacedEnemies.Empty();
+	PlayerSpawns.Empty();
+	bRecorded = false;
+	Super::Deinitialize();
+}
+
+void UFPSWorldReset::OnWorldBeginPlay(UWorld& InWorld) {
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Runs before any actor's BeginPlay, so spawners have not added anything yet and only placed actors are recorded
+	RecordPlacedActors(InWorld);
+}
+
+void UFPSWorldReset::RequestReset(FName InFallbackLevel) {
+	FallbackLevel = InFallbackLevel;
+	if (IsResetPending()) return;
+
+	ResetTimerHandle = GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UFPSWorldReset::HandleResetTimer);
+}
+
+bool UFPSWorldReset::ResetWorld() {
+	UWorld* World = GetWorld();
+	if (!World || !bRecorded) return false;
+
+	SCOPE_CYCLE_COUNTER(STAT_WorldReset);
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	// Shots and effects still in flight belong to the previous run
+	if (UFPSProjectileManager* ProjectileManager = World->GetSubsystem<UFPSProjectileManager>()) {
+		ProjectileManager->RemoveAll();
+	}
+	for (TActorIterator<AFPSProjectile> It(World); It; ++It) {
+		It->Expire();
+	}
+	if (UFPSHitscanSubsystem* Hitscan = World->GetSubsystem<UFPSHitscanSubsystem>()) {
+		Hitscan->Reset();
+	}
+	if (UFPSDamageOverTime* DamageOverTime = World->GetSubsystem<UFPSDamageOverTime>()) {
+		DamageOverTime->RemoveAllEffects();
+	}
+	if (UFPSDamageQueue* DamageQueue = World->GetSubsystem<UFPSDamageQueue>()) {
+		DamageQueue->Reset();
+	}
+
+	// Players first, so restored pickups and enemies do not overlap them where they died
+	ResetPlayers();
+	ResetEnemies();
+	ResetPickups();
+
+	NumResets++;
+	LastResetSeconds = FPlatformTime::Seconds() - StartSeconds;
+	UE_LOG(LogTemp, Log, TEXT("World reset %d took %.2f ms"), NumResets, LastResetSeconds * 1000.0);
+
+	OnWorldReset.Broadcast(World);
+	return true;
+}
+
+void UFPSWorldReset::HandleResetTimer() {
+	ResetTimerHandle.Invalidate();
+	if (ResetWorld()) return;
+
+	UE_LOG(LogTemp, Warning, TEXT("World reset failed, opening %s instead"), *FallbackLevel.ToString());
+	UGameplayStatics::OpenLevel(this, FallbackLevel);
+}
+
+void UFPSWorldReset::RecordPlacedActors(UWorld& InWorld) {
+	auto Record = [](TArray<FWorldResetRecord>& Records, AActor* Actor) {
+		FWorldResetRecord& Entry = Records.AddDefaulted_GetRef();
+		Entry.Actor = Actor;
+		Entry.ActorClass = Actor->GetClass();
+		Entry.Transform = Actor->GetActorTransform();
+	};
+
+	for (TActorIterator<APickupBase> It(&InWorld); It; ++It) {
+		It->bHideWhenCollected = true;
+		Record(PlacedPickups, *It);
+	}
+	for (TActorIterator<AFPSEnemyBase> It(&InWorld); It; ++It) {
+		It->MarkLevelPlaced();
+		Record(PlacedEnemies, *It);
+	}
+	for (TActorIterator<AFPSCharacter> It(&InWorld); It; ++It) {
+		Record(PlayerSpawns, *It);
+	}
+	bRecorded = true;
+}
+
+AActor* UFPSWorldReset::RespawnRecord(FWorldResetRecord& Record) {
+	if (!Record.ActorClass) return nullptr;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	AActor* Actor = GetWorld()->SpawnActor<AActor>(Record.ActorClass, Record.Transform, SpawnParams);
+	Record.Actor = Actor;
+	return Actor;
+}
+
+void UFPSWorldReset::ResetPlayers() {
+	UWorld* World = GetWorld();
+	AGameModeBase* GameMode = World->GetAuthGameMode();
+
+	for (TActorIterator<AFPSCharacter> It(World); It; ++It) {
+		AFPSCharacter* Player = *It;
+
+		FTransform Spawn = Player->GetActorTransform();
+		const AActor* PlayerStart = GameMode && Player->GetController() ? GameMode->FindPlayerStart(Player->GetController()) : nullptr;
+		if (PlayerStart) {
+			Spawn = PlayerStart->GetActorTransform();
+		}
+		else if (const FWorldResetRecord* Recorded = PlayerSpawns.FindByPredicate([Player](const FWorldResetRecord& Entry) { return Entry.Actor.Get() == Player; })) {
+			Spawn = Recorded->Transform;
+		}
+
+		Player->ResetPlayer(Spawn.GetLocation(), Spawn.Rotator());
+	}
+}
+
+void UFPSWorldReset::ResetEnemies() {
+	UWorld* World = GetWorld();
+
+	if (UFPSSwarmSubsystem* Swarm = World->GetSubsystem<UFPSSwarmSubsystem>()) {
+		Swarm->RemoveAllAgents();
+	}
+
+	// Enemies nobody owns any more, e.g. spawned by a test harness, go back to the pool or away
+	TSet<AActor*> Placed;
+	for (const FWorldResetRecord& Entry : PlacedEnemies) {
+		Placed.Add(Entry.Actor.Get());
+	}
+	for (TActorIterator<AFPSEnemyBase> It(World); It; ++It) {
+		AFPSEnemyBase* Enemy = *It;
+		if (Enemy->OwningSpawner || Enemy->IsInPool() || Placed.Contains(Enemy)) continue;
+		Enemy->Recycle();
+	}
+
+	for (FWorldResetRecord& Entry : PlacedEnemies) {
+		AFPSEnemyBase* Enemy = Cast<AFPSEnemyBase>(Entry.Actor.Get());
+		if (IsValid(Enemy)) {
+			Enemy->ActivateFromPool(Entry.Transform.GetLocation(), Entry.Transform.Rotator());
+		}
+		// Destroyed some other way, the class defaults are the best we can do
+		else if (AFPSEnemyBase* Respawned = Cast<AFPSEnemyBase>(RespawnRecord(Entry))) {
+			Respawned->SpawnDefaultController();
+			Respawned->MarkLevelPlaced();
+		}
+	}
+
+	for (TActorIterator<AFPSEnemySpawnManager> It(World); It; ++It) {
+		It->ResetSpawner();
+	}
+}
+
+void UFPSWorldReset::ResetPickups() {
+	UWorld* World = GetWorld();
+
+	if (UFPSPickupField* Field = World->GetSubsystem<UFPSPickupField>()) {
+		Field->RemoveAll();
+	}
+
+	for (FWorldResetRecord& Entry : PlacedPickups) {
+		APickupBase* Pickup = Cast<APickupBase>(Entry.Actor.Get());
+		if (IsValid(Pickup)) {
+			Pickup->Restore();
+		}
+		else if (APickupBase* Respawned = Cast<APickupBase>(RespawnRecord(Entry))) {
+			Respawned->bHideWhenCollected = true;
+		}
+	}
+
+	for (TActorIterator<AFPSPickupSpawner> It(World); It; ++It) {
+		It->ResetSpawner();
+	}
+}
@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FPSWorldReset.generated.h"
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnWorldReset, class UWorld*);
+
+// A level placed actor as it was when play began
+USTRUCT()
+struct FWorldResetRecord {
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TWeakObjectPtr<AActor> Actor;
+
+	UPROPERTY()
+	TSubclassOf<AActor> ActorClass;
+
+	FTransform Transform;
+};
+
+/**
+ * Restarts play in the loaded world instead of reloading the map. Level placed pickups and enemies are recorded
+ * when the world begins play and restored on reset, spawners start over, everything spawned at runtime goes back
+ * to its pool, and players return to a player start with their starting loadout.
+ */
+UCLASS()
+class FPSPROJECT_API UFPSWorldReset : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	// Resets on the next tick, so the overlap or damage flush asking for it finishes first. Opens FallbackLevel if the reset fails.
+	void RequestReset(FName FallbackLevel);
+	bool IsResetPending() const { return ResetTimerHandle.IsValid(); }
+
+	// Resets right away. Returns false if the world never began play, there is no initial state to go back to then.
+	bool ResetWorld();
+
+	int32 GetNumResets() const { return NumResets; }
+	double GetLastResetSeconds() const { return LastResetSeconds; }
+
+	// Broadcast once everything is back in place, for systems that keep per-run state of their own
+	FOnWorldReset OnWorldReset;
+
+protected:
+	void HandleResetTimer();
+	void RecordPlacedActors(UWorld& InWorld);
+	AActor* RespawnRecord(FWorldResetRecord& Record);
+	void ResetEnemies();
+	void ResetPickups();
+	void ResetPlayers();
+
+	UPROPERTY()
+	TArray<FWorldResetRecord> PlacedPickups;
+
+	UPROPERTY()
+	TArray<FWorldResetRecord> PlacedEnemies;
+
+	// Where each player stood when play began, used when the game mode has no player start to offer
+	UPROPERTY()
+	TArray<FWorldResetRecord> PlayerSpawns;
+
+	bool bRecorded = false;
+	FName FallbackLevel;
+	FTimerHandle ResetTimerHandle;
+
+	int32 NumResets = 0;
+	double LastResetSeconds = 0.0;
+};
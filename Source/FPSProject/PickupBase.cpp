@@ -46,9 +46,39 @@ void APickupBase::OnCollected(AFPSCharacter* Character) {
 
 void APickupBase::HandleOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult) {
 	AFPSCharacter* Character = Cast<AFPSCharacter>(OtherActor);
-	if (Character) {
+	if (Character && !bCollected) {
 		OnCollected(Character);
-		Destroy();
+		if (bHideWhenCollected) {
+			bCollected = true;
+			SetActorHiddenInGame(true);
+			SetActorEnableCollision(false);
+		}
+		else {
+			Destroy();
+		}
 	}
 }
 
+void APickupBase::Restore() {
+	if (!bCollected) return;
+
+	bCollected = false;
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+}
+
+float APickupBase::GetCollectRadius() const {
+	return CollisionComp ? CollisionComp->GetUnscaledSphereRadius() : 0.0f;
+}
+
+UStaticMesh* APickupBase::GetPickupMesh() const {
+	return MeshComp ? MeshComp->GetStaticMesh() : nullptr;
+}
+
+UMaterialInterface* APickupBase::GetPickupMaterial() const {
+	return MeshComp ? MeshComp->GetMaterial(0) : nullptr;
+}
+
+FTransform APickupBase::GetPickupMeshTransform() const {
+	return MeshComp ? MeshComp->GetRelativeTransform() : FTransform::Identity;
+}
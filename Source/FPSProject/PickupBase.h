@@ -29,9 +29,24 @@ public:
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
 
+	// UFPSPickupField calls this on the class default object, so overrides should not rely on instance state beyond defaults
 	virtual void OnCollected(class AFPSCharacter* Character);
 
+	float GetCollectRadius() const;
+	class UStaticMesh* GetPickupMesh() const;
+	class UMaterialInterface* GetPickupMaterial() const;
+	// Relative to the pickup's location
+	FTransform GetPickupMeshTransform() const;
+
+	// Set by UFPSWorldReset on level placed pickups. They hide when collected instead of being destroyed, so Restore can bring them back as placed.
+	bool bHideWhenCollected = false;
+
+	void Restore();
+	bool IsCollected() const { return bCollected; }
+
 	UFUNCTION()
 	void HandleOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
 
+protected:
+	bool bCollected = false;
 };
@@ -5,18 +5,19 @@
 #include "Components/BoxComponent.h"
 #include "Components/MeshComponent.h" 
 #include "Components/StaticMeshComponent.h"
-#include "UObject/ConstructorHelpers.h"
 #include "FPSCharacter.h"
 #include "Materials/Material.h"
 #include "Materials/MaterialInterface.h"
 #include "Engine/Engine.h"
 #include "Engine/StaticMesh.h"
+#include "FPSDamageOverTime.h"
+#include "FPSAssetPreloader.h"
 
 // Sets default values
 APoisonTile::APoisonTile()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+ 	// Poison is applied by UFPSDamageOverTime, the tile itself never ticks
+	PrimaryActorTick.bCanEverTick = false;
 
 	BoxComponent = CreateDefaultSubobject<UBoxComponent>(TEXT("BoxComponent"));
 	RootComponent = BoxComponent;
@@ -26,27 +27,12 @@ APoisonTile::APoisonTile()
 	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("MeshComponent"));
 	MeshComponent->SetupAttachment(RootComponent);
 
-	if (UStaticMesh* Plane = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Plane.Plane")))
-	{
-		MeshComponent->SetStaticMesh(Plane);
-	}
-	else
-	{
-		UE_LOG(LogTemp, Warning, TEXT("Missing plane mesh /Engine/BasicShapes/Plane.Plane"));
-	}
+	TileMesh = TSoftObjectPtr<UStaticMesh>(FSoftObjectPath(TEXT("/Engine/BasicShapes/Plane.Plane")));
+	TileMaterial = TSoftObjectPtr<UMaterialInterface>(FSoftObjectPath(TEXT("/Game/Static/M_Green.M_Green")));
 
 	MeshComponent->SetRelativeScale3D(FVector(4.0f, 4.0f, 1.0f));
 	MeshComponent->SetRelativeLocation(FVector(0.0f, 0.04, -50.0f));
 
-	if (UMaterialInterface* Green = LoadObject<UMaterialInterface>(nullptr, TEXT("/Game/Static/M_Green.M_Green")))
-	{
-		MeshComponent->SetMaterial(0, Green);
-	}
-	else
-	{
-		UE_LOG(LogTemp, Warning, TEXT("Missing material /Game/Static/M_Green.M_Green"));
-	}
-
 	MeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 	MeshComponent->SetCastShadow(false);
 
@@ -61,34 +47,52 @@ APoisonTile::APoisonTile()
 void APoisonTile::BeginPlay()
 {
 	Super::BeginPlay();
-	
+
+	// Tiles saved before the mesh became a soft reference come out of the level without one
+	ApplyMeshAssets();
 }
 
-// Called every frame
-void APoisonTile::Tick(float DeltaTime)
+void APoisonTile::OnConstruction(const FTransform& Transform)
 {
-	Super::Tick(DeltaTime);
-
-	TArray<AFPSCharacter*> ToRemove;
-	for (auto& Elem : PoisonTimer) {
-		AFPSCharacter* Player = Elem.Key;
-		float& TimeLeft = Elem.Value;
-		if (IsValid(Player) && TimeLeft > 0.0f) {
-			Player->ApplyDamage(DamagePerSecond * DeltaTime);
-			TimeLeft -= DeltaTime;
-			if (TimeLeft <= 0.0f)
-				ToRemove.Add(Player);
+	Super::OnConstruction(Transform);
+	ApplyMeshAssets();
+}
+
+void APoisonTile::ApplyMeshAssets()
+{
+	if (!MeshComponent->GetStaticMesh()) {
+		if (UStaticMesh* Plane = UFPSAssetPreloader::Resolve(TileMesh)) {
+			MeshComponent->SetStaticMesh(Plane);
+		}
+		else {
+			UE_LOG(LogTemp, Warning, TEXT("Missing plane mesh %s"), *TileMesh.ToString());
+		}
+	}
+
+	if (MeshComponent->GetNumOverrideMaterials() == 0) {
+		if (UMaterialInterface* Green = UFPSAssetPreloader::Resolve(TileMaterial)) {
+			MeshComponent->SetMaterial(0, Green);
 		}
 		else {
-			ToRemove.Add(Player);
+			UE_LOG(LogTemp, Warning, TEXT("Missing material %s"), *TileMaterial.ToString());
 		}
 	}
-	for (AFPSCharacter* Player : ToRemove)
-		PoisonTimer.Remove(Player);
+}
+
+void APoisonTile::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UFPSDamageOverTime* DamageOverTime = GetWorld()->GetSubsystem<UFPSDamageOverTime>()) {
+		DamageOverTime->RemoveEffects(this);
+	}
+	Super::EndPlay(EndPlayReason);
 }
 
 void APoisonTile::OnBeginOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult) {
 	AFPSCharacter* Player = Cast<AFPSCharacter>(OtherActor);
-	if (Player)
-		PoisonTimer.Add(Player, MaxDuration);
+	if (!Player) return;
+
+	// Entering again restarts this tile's poison, like the old per-tile timer map did
+	if (UFPSDamageOverTime* DamageOverTime = GetWorld()->GetSubsystem<UFPSDamageOverTime>()) {
+		DamageOverTime->ApplyEffect(Player, this, DamagePerSecond, MaxDuration);
+	}
 }
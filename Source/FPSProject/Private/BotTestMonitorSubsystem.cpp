@@ -12,6 +12,7 @@
 #include "UObject/NameTypes.h"
 #include "GameFramework/GameModeBase.h"
 #include "GameFramework/PlayerController.h"
+#include "../FPSWorldReset.h"
 
 
 void UBotTestMonitorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
@@ -301,10 +302,29 @@ void UBotTestMonitorSubsystem::OnWorldInitialized(UWorld* World, const UWorld::I
             FTickerDelegate::CreateUObject(this, &UBotTestMonitorSubsystem::Tick)
         );
 
+        if (UFPSWorldReset* WorldReset = World->GetSubsystem<UFPSWorldReset>())
+        {
+            WorldReset->OnWorldReset.AddUObject(this, &UBotTestMonitorSubsystem::OnWorldReset);
+        }
+
         StartTest();
     }
 }
 
+void UBotTestMonitorSubsystem::OnWorldReset(UWorld* World)
+{
+    if (!bIsAIPlaytest) return;
+
+    UE_LOG(LogTemp, Warning, TEXT("World soft reset. Starting a new run."));
+    if (!TickHandle.IsValid())
+    {
+        TickHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateUObject(this, &UBotTestMonitorSubsystem::Tick)
+        );
+    }
+    StartTest();
+}
+
 void UBotTestMonitorSubsystem::OnWorldTearDown(UWorld* World)
 {
     if (World && World->IsGameWorld() && bIsAIPlaytest)
@@ -142,4 +142,6 @@ private:
 
 	void OnWorldInitialized(UWorld* World, const UWorld::InitializationValues IVS);
 	void OnWorldTearDown(UWorld* World);
+	// A soft reset starts a new run just like the map reload it replaces
+	void OnWorldReset(UWorld* World);
 };
\ No newline at end of file
@@ -0,0 +1,95 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "FMinimalWorldLatentHelpers.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/PlatformTime.h"
+#include "../FPSEnemyDumb.h"
+
+// Times CharacterMovement against UFPSEnemyMovementComponent on the same chase, ticking only the movement components
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEnemyMovementBenchmark, "Game.Performance.EnemyMovementBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace EnemyMovementBenchmark
+{
+	static const int32 EnemyCounts[] = { 100, 500, 1000 };
+	static const int32 WarmupFrames = 10;
+	static const int32 MeasuredFrames = 120;
+	static const float FrameTime = 1.0f / 60.0f;
+	static const float SpawnHalfExtent = 1800.0f;
+
+	// Average microseconds for one enemy's movement tick
+	static double Run(UWorld* World, UClass* EnemyClass, int32 Count) {
+		FActorSpawnParameters Params;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		TArray<AFPSEnemyDumb*> Enemies;
+		const int32 Side = FMath::CeilToInt(FMath::Sqrt((float)Count));
+		const float Spacing = SpawnHalfExtent * 2.0f / Side;
+		for (int32 i = 0; i < Count; i++) {
+			const FVector Location(-SpawnHalfExtent + (i % Side) * Spacing, -SpawnHalfExtent + (i / Side) * Spacing, 100.0f);
+			AFPSEnemyDumb* Enemy = World->SpawnActor<AFPSEnemyDumb>(EnemyClass, Location, FRotator::ZeroRotator, Params);
+			if (!Enemy) continue;
+
+			if (!Enemy->GetController()) {
+				Enemy->SpawnDefaultController();
+			}
+
+			// The benchmark drives input and movement itself, nothing else on the enemy should run
+			Enemy->SetActorTickEnabled(false);
+			Enemy->GetCharacterMovement()->SetComponentTickEnabled(false);
+			if (Enemy->GetMesh()) {
+				Enemy->GetMesh()->SetComponentTickEnabled(false);
+			}
+			Enemies.Add(Enemy);
+		}
+
+		uint64 Cycles = 0;
+		for (int32 Frame = 0; Frame < WarmupFrames + MeasuredFrames; Frame++) {
+			for (AFPSEnemyDumb* Enemy : Enemies) {
+				Enemy->AddMovementInput((-Enemy->GetActorLocation()).GetSafeNormal2D(), 1.0f);
+			}
+
+			const uint64 Start = FPlatformTime::Cycles64();
+			for (AFPSEnemyDumb* Enemy : Enemies) {
+				UCharacterMovementComponent* Movement = Enemy->GetCharacterMovement();
+				Movement->TickComponent(FrameTime, LEVELTICK_All, &Movement->PrimaryComponentTick);
+			}
+			if (Frame >= WarmupFrames) {
+				Cycles += FPlatformTime::Cycles64() - Start;
+			}
+		}
+
+		for (AFPSEnemyDumb* Enemy : Enemies) {
+			if (AController* Controller = Enemy->GetController()) {
+				Controller->Destroy();
+			}
+			Enemy->Destroy();
+		}
+
+		const double Seconds = FPlatformTime::ToSeconds64(Cycles);
+		return Enemies.Num() > 0 ? Seconds * 1000000.0 / ((double)Enemies.Num() * MeasuredFrames) : 0.0;
+	}
+}
+
+bool FEnemyMovementBenchmark::RunTest(const FString& Parameters) {
+	ADD_LATENT_AUTOMATION_COMMAND(FOpenMapLatentCommand(TEXT("/Game/Tests/MinimalTestMap")));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FSetUpWorldLatent([this](UWorld* World) {
+		FString CSV = TEXT("Enemies,CharacterMovementUs,EnemyMovementUs,Speedup\n");
+
+		for (int32 Count : EnemyMovementBenchmark::EnemyCounts) {
+			const double FullUs = EnemyMovementBenchmark::Run(World, AFPSEnemyDumb::StaticClass(), Count);
+			const double LiteUs = EnemyMovementBenchmark::Run(World, AFPSEnemyDumbLite::StaticClass(), Count);
+			const double Speedup = LiteUs > 0.0 ? FullUs / LiteUs : 0.0;
+
+			AddInfo(FString::Printf(TEXT("%d enemies: CharacterMovement %.2f us, EnemyMovement %.2f us per enemy tick (%.2fx)"), Count, FullUs, LiteUs, Speedup));
+			CSV += FString::Printf(TEXT("%d,%.3f,%.3f,%.2f\n"), Count, FullUs, LiteUs, Speedup);
+		}
+
+		const FString CSVPath = FPaths::ProjectSavedDir() / TEXT("Automation/Performance/EnemyMovementBenchmark.csv");
+		FFileHelper::SaveStringToFile(CSV, *CSVPath);
+		}));
+
+	return true;
+}
@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CQTest.h"
+#include "../FPSCharacter.h"
+#include "../FPSWeaponBase.h"
+#include "../FPSHitscanSubsystem.h"
+#include "../FPSProjectileManager.h"
+#include "../FPSProjectile.h"
+#include "Engine/World.h"
+
+TEST_CLASS(AimResolution_CQ, "Game.Unit.Weapon.AimResolution")
+{
+    UWorld* TestWorld;
+    AFPSCharacter* Player;
+    AFPSWeaponBase* Weapon;
+    UFPSHitscanSubsystem* Hitscan;
+    TArray<float> OneShot = { 0.0f };
+
+    BEFORE_EACH()
+    {
+        TestWorld = UWorld::CreateWorld(EWorldType::Game, false, TEXT("AimResolutionWorld"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(TestWorld);
+        TestWorld->InitializeActorsForPlay(FURL());
+
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        Player = TestWorld->SpawnActor<AFPSCharacter>(AFPSCharacter::StaticClass(), FTransform::Identity, SpawnParams);
+        Weapon = TestWorld->SpawnActor<AFPSWeaponBase>(AFPSWeaponBase::StaticClass(), FTransform::Identity, SpawnParams);
+        Hitscan = TestWorld->GetSubsystem<UFPSHitscanSubsystem>();
+        ASSERT_THAT(IsNotNull(Player));
+        ASSERT_THAT(IsNotNull(Weapon));
+        ASSERT_THAT(IsNotNull(Hitscan));
+
+        Weapon->HitMode = EWeaponHitMode::Hitscan;
+    }
+
+    AFTER_EACH()
+    {
+        if (TestWorld)
+        {
+            TestWorld->DestroyWorld(true);
+            TestWorld = nullptr;
+        }
+        Player = nullptr;
+        Weapon = nullptr;
+        Hitscan = nullptr;
+    }
+
+    TEST_METHOD(StillCamera_ReusesTheLastAimHit)
+    {
+        Player->AimReuseFrames = 1;
+        Player->HandleWeaponFired(Weapon, OneShot);
+        Player->HandleWeaponFired(Weapon, OneShot);
+
+        ASSERT_THAT(AreEqual(1, Player->AimTracesSync));
+        ASSERT_THAT(AreEqual(1, Player->AimTracesReused));
+        ASSERT_THAT(AreEqual(2, Hitscan->GetNumQueued()));
+    }
+
+    TEST_METHOD(TurnedCamera_TracesAgain)
+    {
+        Player->AimReuseFrames = 1;
+        Player->HandleWeaponFired(Weapon, OneShot);
+        Player->SetActorRotation(FRotator(0.f, 10.f, 0.f));
+        Player->HandleWeaponFired(Weapon, OneShot);
+
+        ASSERT_THAT(AreEqual(2, Player->AimTracesSync));
+        ASSERT_THAT(AreEqual(0, Player->AimTracesReused));
+    }
+
+    TEST_METHOD(AsyncAim_DefersTheShotsToTheNextFrame)
+    {
+        Player->bAsyncAimTrace = true;
+        Player->HandleWeaponFired(Weapon, OneShot);
+
+        ASSERT_THAT(AreEqual(1, Player->AimTracesAsync));
+        ASSERT_THAT(AreEqual(1, Player->GetNumPendingAims()));
+        ASSERT_THAT(AreEqual(0, Hitscan->GetNumQueued()));
+    }
+
+    TEST_METHOD(ProjectileManagerBatch_KeepsTheSpacingOfAMultiShotFrame)
+    {
+        UFPSProjectileManager* Manager = TestWorld->GetSubsystem<UFPSProjectileManager>();
+        ASSERT_THAT(IsNotNull(Manager));
+        Manager->bRender = false;
+        Player->UseProjectileManager(AFPSProjectile::StaticClass());
+        Weapon->HitMode = EWeaponHitMode::Projectile;
+
+        // The older shot has been flying for the rest of the frame, like a pooled projectile would have
+        const TArray<float> TwoShots = { 0.0f, 0.01f };
+        Player->HandleWeaponFired(Weapon, TwoShots);
+
+        ASSERT_THAT(AreEqual(2, Manager->GetNumProjectiles()));
+        const float Spacing = FVector::Dist(Manager->GetProjectileLocation(0), Manager->GetProjectileLocation(1));
+        ASSERT_THAT(IsNear(Manager->Speed * 0.01f, Spacing, 1.f));
+    }
+};
@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CQTest.h"
+#include "../FPSAssetPreloader.h"
+#include "../FPSProjectile.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+
+TEST_CLASS(AssetPreloader_CQ, "Game.Unit.AssetPreloader")
+{
+    UWorld* TestWorld;
+    UFPSAssetPreloader* SUT;
+
+    BEFORE_EACH()
+    {
+        TestWorld = UWorld::CreateWorld(EWorldType::Game, false, TEXT("AssetPreloaderWorld"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(TestWorld);
+        TestWorld->InitializeActorsForPlay(FURL());
+
+        SUT = TestWorld->GetSubsystem<UFPSAssetPreloader>();
+        ASSERT_THAT(IsNotNull(SUT));
+    }
+
+    AFTER_EACH()
+    {
+        if (TestWorld)
+        {
+            TestWorld->DestroyWorld(true);
+            TestWorld = nullptr;
+        }
+        SUT = nullptr;
+    }
+
+    TEST_METHOD(WaitForPreload_LeavesNothingInFlight)
+    {
+        SUT->WaitForPreload();
+        ASSERT_THAT(IsTrue(SUT->IsPreloadComplete()));
+    }
+
+    TEST_METHOD(Resolve_NullReference_ReturnsNull)
+    {
+        const TSoftObjectPtr<UStaticMesh> Empty;
+        ASSERT_THAT(IsTrue(UFPSAssetPreloader::Resolve(Empty) == nullptr));
+    }
+
+    TEST_METHOD(Resolve_UnloadedReference_LoadsIt)
+    {
+        const TSoftObjectPtr<UStaticMesh> Cube(FSoftObjectPath(TEXT("/Engine/BasicShapes/Cube.Cube")));
+        UStaticMesh* Mesh = UFPSAssetPreloader::Resolve(Cube);
+        ASSERT_THAT(IsNotNull(Mesh));
+        ASSERT_THAT(IsTrue(Cube.Get() == Mesh));
+    }
+
+    TEST_METHOD(SpawnedProjectile_GetsItsMeshFromTheSoftReference)
+    {
+        SUT->WaitForPreload();
+
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        AFPSProjectile* Projectile = TestWorld->SpawnActor<AFPSProjectile>(AFPSProjectile::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+        ASSERT_THAT(IsNotNull(Projectile));
+
+        ASSERT_THAT(IsTrue(Projectile->ProjectileMeshComponent->GetStaticMesh() == Projectile->ProjectileMesh.Get()));
+        ASSERT_THAT(IsNotNull(Projectile->ProjectileMaterialInstance));
+    }
+};
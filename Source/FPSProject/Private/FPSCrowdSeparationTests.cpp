@@ -0,0 +1,186 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CQTest.h"
+#include "../FPSCrowdSeparation.h"
+#include "../FPSEnemyDumb.h"
+#include "../FPSCharacter.h"
+#include "Engine/World.h"
+
+TEST_CLASS(CrowdSeparation_CQ, "Game.Unit.CrowdSeparation")
+{
+    UWorld* TestWorld;
+    UFPSCrowdSeparation* Crowd;
+
+    BEFORE_EACH()
+    {
+        TestWorld = UWorld::CreateWorld(EWorldType::Game, false, TEXT("CrowdSeparationWorld"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(TestWorld);
+        TestWorld->InitializeActorsForPlay(FURL());
+
+        Crowd = TestWorld->GetSubsystem<UFPSCrowdSeparation>();
+        ASSERT_THAT(IsNotNull(Crowd));
+    }
+
+    AFTER_EACH()
+    {
+        if (TestWorld)
+        {
+            TestWorld->DestroyWorld(true);
+            TestWorld = nullptr;
+        }
+        Crowd = nullptr;
+    }
+
+    TEST_METHOD(SpatialHash_FindsOnlyPointsInsideRadius)
+    {
+        TArray<FVector> Positions;
+        Positions.Add(FVector(0.f, 0.f, 0.f));
+        Positions.Add(FVector(90.f, 0.f, 0.f));
+        Positions.Add(FVector(-50.f, -50.f, 0.f));
+        Positions.Add(FVector(300.f, 0.f, 0.f));
+
+        FCrowdSpatialHash Hash;
+        Hash.Build(Positions, 100.f);
+
+        TArray<int32> Found;
+        Hash.ForEachNeighbour(FVector::ZeroVector, 100.f, [&Found](int32 Index) { Found.Add(Index); });
+
+        ASSERT_THAT(AreEqual(3, Found.Num()));
+        ASSERT_THAT(IsFalse(Found.Contains(3)));
+    }
+
+    TEST_METHOD(ComputeSeparation_PushesCloseNeighboursApart)
+    {
+        TArray<FVector> Positions;
+        Positions.Add(FVector(0.f, 0.f, 0.f));
+        Positions.Add(FVector(50.f, 0.f, 0.f));
+        Positions.Add(FVector(1000.f, 0.f, 0.f));
+
+        TArray<FVector> Offsets;
+        FCrowdSpatialHash Hash;
+        UFPSCrowdSeparation::ComputeSeparation(Positions, 120.f, 1.f, Offsets, Hash);
+
+        ASSERT_THAT(AreEqual(3, Offsets.Num()));
+        ASSERT_THAT(IsTrue(Offsets[0].X < 0.f));
+        ASSERT_THAT(IsTrue(Offsets[1].X > 0.f));
+        ASSERT_THAT(IsTrue(Offsets[2].IsNearlyZero()));
+        ASSERT_THAT(IsTrue(Offsets[0].Size() <= 1.f + KINDA_SMALL_NUMBER));
+    }
+
+    TEST_METHOD(ComputeSeparation_StackedAgentsStillSplit)
+    {
+        TArray<FVector> Positions;
+        Positions.Add(FVector(10.f, 10.f, 0.f));
+        Positions.Add(FVector(10.f, 10.f, 0.f));
+
+        TArray<FVector> Offsets;
+        FCrowdSpatialHash Hash;
+        UFPSCrowdSeparation::ComputeSeparation(Positions, 120.f, 1.f, Offsets, Hash);
+
+        ASSERT_THAT(IsFalse(Offsets[0].IsNearlyZero()));
+        ASSERT_THAT(IsTrue(FVector::DotProduct(Offsets[0], Offsets[1]) < 0.f));
+    }
+
+    TEST_METHOD(UpdateSeparation_WritesSteeringToRegisteredEnemies)
+    {
+        AFPSEnemyDumb* A = TestWorld->SpawnActor<AFPSEnemyDumb>(AFPSEnemyDumb::StaticClass(), FVector(0.f, 0.f, 100.f), FRotator::ZeroRotator);
+        AFPSEnemyDumb* B = TestWorld->SpawnActor<AFPSEnemyDumb>(AFPSEnemyDumb::StaticClass(), FVector(0.f, 60.f, 100.f), FRotator::ZeroRotator);
+        ASSERT_THAT(IsNotNull(A));
+        ASSERT_THAT(IsNotNull(B));
+        A->DispatchBeginPlay();
+        B->DispatchBeginPlay();
+        ASSERT_THAT(AreEqual(2, Crowd->GetNumAgents()));
+
+        Crowd->UpdateSeparation();
+
+        ASSERT_THAT(IsTrue(A->SeparationSteering.Y < 0.f));
+        ASSERT_THAT(IsTrue(B->SeparationSteering.Y > 0.f));
+
+        B->Destroy();
+        Crowd->UpdateSeparation();
+        ASSERT_THAT(AreEqual(1, Crowd->GetNumAgents()));
+        ASSERT_THAT(IsTrue(A->SeparationSteering.IsNearlyZero()));
+    }
+
+    TEST_METHOD(ComputeChase_HeadsForTheNearestTarget)
+    {
+        TArray<FVector> Positions;
+        Positions.Add(FVector(0.f, 0.f, 0.f));
+        Positions.Add(FVector(900.f, 0.f, 0.f));
+
+        TArray<FVector> Targets;
+        Targets.Add(FVector(-500.f, 0.f, 0.f));
+        Targets.Add(FVector(1000.f, 0.f, 0.f));
+
+        TArray<FVector> Offsets;
+        Offsets.SetNumZeroed(2);
+
+        TArray<FVector> Directions;
+        UFPSCrowdSeparation::ComputeChase(Positions, Offsets, Targets, nullptr, Directions);
+
+        ASSERT_THAT(AreEqual(2, Directions.Num()));
+        ASSERT_THAT(IsTrue(Directions[0].X < -0.99f));
+        ASSERT_THAT(IsTrue(Directions[1].X > 0.99f));
+    }
+
+    TEST_METHOD(ComputeChase_BlendsSeparationWithinUnitLength)
+    {
+        TArray<FVector> Positions;
+        Positions.Add(FVector::ZeroVector);
+
+        TArray<FVector> Targets;
+        Targets.Add(FVector(1000.f, 0.f, 0.f));
+
+        TArray<FVector> Offsets;
+        Offsets.Add(FVector(0.f, 1.f, 0.f));
+
+        TArray<FVector> Directions;
+        UFPSCrowdSeparation::ComputeChase(Positions, Offsets, Targets, nullptr, Directions);
+
+        ASSERT_THAT(IsTrue(Directions[0].X > 0.f));
+        ASSERT_THAT(IsTrue(Directions[0].Y > 0.f));
+        ASSERT_THAT(IsTrue(Directions[0].Size() <= 1.f + KINDA_SMALL_NUMBER));
+    }
+
+    TEST_METHOD(ThinkChase_WritesDirectionTowardPlayer)
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        AFPSCharacter* Player = TestWorld->SpawnActor<AFPSCharacter>(AFPSCharacter::StaticClass(), FVector(0.f, 2000.f, 100.f), FRotator::ZeroRotator, SpawnParams);
+        AFPSEnemyDumb* Enemy = TestWorld->SpawnActor<AFPSEnemyDumb>(AFPSEnemyDumb::StaticClass(), FVector(0.f, 0.f, 100.f), FRotator::ZeroRotator, SpawnParams);
+        ASSERT_THAT(IsNotNull(Player));
+        ASSERT_THAT(IsNotNull(Enemy));
+        Enemy->DispatchBeginPlay();
+
+        Crowd->UpdateSeparation();
+        Crowd->ThinkChase();
+
+        ASSERT_THAT(IsTrue(Enemy->ChaseDirection.Y > 0.99f));
+    }
+
+    TEST_METHOD(ThinkChase_WaitsForTheTickIntervalOfLowSignificanceEnemies)
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        AFPSCharacter* Player = TestWorld->SpawnActor<AFPSCharacter>(AFPSCharacter::StaticClass(), FVector(0.f, 2000.f, 100.f), FRotator::ZeroRotator, SpawnParams);
+        AFPSEnemyDumb* Enemy = TestWorld->SpawnActor<AFPSEnemyDumb>(AFPSEnemyDumb::StaticClass(), FVector(0.f, 0.f, 100.f), FRotator::ZeroRotator, SpawnParams);
+        ASSERT_THAT(IsNotNull(Player));
+        ASSERT_THAT(IsNotNull(Enemy));
+        Enemy->DispatchBeginPlay();
+
+        FEnemyTickLOD LowLOD;
+        LowLOD.ActorTickInterval = 0.25f;
+        Enemy->ApplyTickLOD(EEnemySignificance::Low, LowLOD);
+
+        Crowd->UpdateSeparation();
+        Crowd->ThinkChase();
+        ASSERT_THAT(IsTrue(Enemy->ChaseDirection.Y > 0.99f));
+
+        // Still inside the interval, so the second pass leaves the direction alone
+        Enemy->ChaseDirection = FVector::ZeroVector;
+        Crowd->UpdateSeparation();
+        Crowd->ThinkChase();
+        ASSERT_THAT(IsTrue(Enemy->ChaseDirection.IsZero()));
+    }
+};
@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CQTest.h"
+#include "../FPSDamageOverTime.h"
+#include "../FPSDamageQueue.h"
+#include "../FPSCharacter.h"
+#include "Engine/World.h"
+
+TEST_CLASS(DamageOverTime_CQ, "Game.Unit.DamageOverTime")
+{
+    UWorld* TestWorld;
+    UFPSDamageOverTime* DamageOverTime;
+    UFPSDamageQueue* DamageQueue;
+    AFPSCharacter* Player;
+
+    BEFORE_EACH()
+    {
+        TestWorld = UWorld::CreateWorld(EWorldType::Game, false, TEXT("DamageOverTimeWorld"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(TestWorld);
+        TestWorld->InitializeActorsForPlay(FURL());
+
+        DamageOverTime = TestWorld->GetSubsystem<UFPSDamageOverTime>();
+        DamageQueue = TestWorld->GetSubsystem<UFPSDamageQueue>();
+        ASSERT_THAT(IsNotNull(DamageOverTime));
+        ASSERT_THAT(IsNotNull(DamageQueue));
+
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        Player = TestWorld->SpawnActor<AFPSCharacter>(AFPSCharacter::StaticClass(), FTransform::Identity, SpawnParams);
+        ASSERT_THAT(IsNotNull(Player));
+        Player->CurrentHealth = 100.f;
+    }
+
+    AFTER_EACH()
+    {
+        if (TestWorld)
+        {
+            TestWorld->DestroyWorld(true);
+            TestWorld = nullptr;
+        }
+        DamageOverTime = nullptr;
+        DamageQueue = nullptr;
+        Player = nullptr;
+    }
+
+    TEST_METHOD(NoEffects_SchedulesNothing)
+    {
+        ASSERT_THAT(AreEqual(0, DamageOverTime->GetNumEffects()));
+        ASSERT_THAT(IsFalse(DamageOverTime->IsUpdating()));
+    }
+
+    TEST_METHOD(Effect_DealsExactlyItsTotalAndExpires)
+    {
+        DamageOverTime->ApplyEffect(Player, nullptr, 4.f, 0.25f);
+        ASSERT_THAT(IsTrue(DamageOverTime->IsUpdating()));
+
+        DamageOverTime->UpdateEffects(0.1f);
+        DamageOverTime->UpdateEffects(0.1f);
+        DamageOverTime->UpdateEffects(0.1f);
+        ASSERT_THAT(AreEqual(0, DamageOverTime->GetNumEffects()));
+
+        DamageQueue->Flush();
+        ASSERT_THAT(IsTrue(FMath::IsNearlyEqual(99.f, Player->CurrentHealth, 0.001f)));
+    }
+
+    TEST_METHOD(SameSource_RestartsInsteadOfStacking)
+    {
+        DamageOverTime->ApplyEffect(Player, Player, 4.f, 1.f);
+        DamageOverTime->UpdateEffects(0.5f);
+        DamageOverTime->ApplyEffect(Player, Player, 4.f, 1.f);
+        ASSERT_THAT(AreEqual(1, DamageOverTime->GetNumEffects()));
+
+        DamageOverTime->ApplyEffect(Player, nullptr, 4.f, 1.f);
+        ASSERT_THAT(AreEqual(2, DamageOverTime->GetNumEffects()));
+    }
+
+    TEST_METHOD(RemovedSource_StopsItsEffects)
+    {
+        DamageOverTime->ApplyEffect(Player, Player, 4.f, 1.f);
+        DamageOverTime->RemoveEffects(Player);
+        DamageOverTime->UpdateEffects(0.1f);
+
+        ASSERT_THAT(AreEqual(0, DamageOverTime->GetNumEffects()));
+        ASSERT_THAT(AreEqual(0, DamageQueue->GetNumPending()));
+    }
+};
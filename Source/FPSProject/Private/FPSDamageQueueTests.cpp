@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CQTest.h"
+#include "../FPSDamageQueue.h"
+#include "../FPSEnemyDumb.h"
+#include "../FPSCharacter.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Engine/World.h"
+
+TEST_CLASS(DamageQueue_CQ, "Game.Unit.DamageQueue")
+{
+    UWorld* TestWorld;
+    UFPSDamageQueue* Queue;
+
+    AFPSEnemyDumb* SpawnEnemy(const FVector& Location)
+    {
+        AFPSEnemyDumb* Enemy = TestWorld->SpawnActor<AFPSEnemyDumb>(AFPSEnemyDumb::StaticClass(), Location, FRotator::ZeroRotator);
+        if (Enemy)
+        {
+            Enemy->bFlashOnHit = false;
+            Enemy->CurrentHealth = Enemy->MaxHealth;
+        }
+        return Enemy;
+    }
+
+    BEFORE_EACH()
+    {
+        TestWorld = UWorld::CreateWorld(EWorldType::Game, false, TEXT("DamageQueueWorld"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(TestWorld);
+        TestWorld->InitializeActorsForPlay(FURL());
+
+        Queue = TestWorld->GetSubsystem<UFPSDamageQueue>();
+        ASSERT_THAT(IsNotNull(Queue));
+    }
+
+    AFTER_EACH()
+    {
+        if (TestWorld)
+        {
+            TestWorld->DestroyWorld(true);
+            TestWorld = nullptr;
+        }
+        Queue = nullptr;
+    }
+
+    TEST_METHOD(QueuedDamage_IsAppliedOnlyOnFlush)
+    {
+        AFPSEnemyDumb* Enemy = SpawnEnemy(FVector(0.f, 0.f, 100.f));
+        ASSERT_THAT(IsNotNull(Enemy));
+        const float StartHealth = Enemy->CurrentHealth;
+
+        Queue->QueueDamage(Enemy, 5.f);
+        ASSERT_THAT(AreEqual(StartHealth, Enemy->CurrentHealth));
+        ASSERT_THAT(AreEqual(1, Queue->GetNumPending()));
+
+        Queue->Flush();
+        ASSERT_THAT(AreEqual(StartHealth - 5.f, Enemy->CurrentHealth));
+        ASSERT_THAT(AreEqual(0, Queue->GetNumPending()));
+    }
+
+    TEST_METHOD(HitsOnSameTarget_AreSummed)
+    {
+        AFPSEnemyDumb* Enemy = SpawnEnemy(FVector(0.f, 0.f, 100.f));
+        ASSERT_THAT(IsNotNull(Enemy));
+        Enemy->MaxHealth = 100.f;
+        Enemy->CurrentHealth = 100.f;
+
+        Queue->QueueDamage(Enemy, 10.f, FVector(800.f, 0.f, 0.f));
+        Queue->QueueDamage(Enemy, 15.f, FVector(0.f, 800.f, 0.f));
+        Queue->QueueDamage(Enemy, 5.f);
+        Queue->Flush();
+
+        ASSERT_THAT(AreEqual(70.f, Enemy->CurrentHealth));
+    }
+
+    TEST_METHOD(LethalBatch_KillsEveryTargetOnce)
+    {
+        AFPSEnemyDumb* First = SpawnEnemy(FVector(0.f, 0.f, 100.f));
+        AFPSEnemyDumb* Second = SpawnEnemy(FVector(500.f, 0.f, 100.f));
+        ASSERT_THAT(IsNotNull(First));
+        ASSERT_THAT(IsNotNull(Second));
+
+        Queue->QueueDamage(First, First->MaxHealth);
+        Queue->QueueDamage(First, First->MaxHealth);
+        Queue->QueueDamage(Second, Second->MaxHealth * 0.5f);
+        Queue->Flush();
+
+        ASSERT_THAT(IsFalse(IsValid(First)));
+        ASSERT_THAT(IsTrue(IsValid(Second)));
+        ASSERT_THAT(AreEqual(Second->MaxHealth * 0.5f, Second->CurrentHealth));
+    }
+
+    TEST_METHOD(PlayerContactDamage_GoesThroughTheQueue)
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        AFPSCharacter* Player = TestWorld->SpawnActor<AFPSCharacter>(AFPSCharacter::StaticClass(), FTransform::Identity, SpawnParams);
+        ASSERT_THAT(IsNotNull(Player));
+        Player->bIsTestMode = true;
+        Player->MaxHealth = 100.f;
+        Player->CurrentHealth = 100.f;
+
+        Queue->QueueDamage(Player, 20.f, FVector(800.f, 0.f, 300.f));
+        Queue->QueueDamage(Player, 20.f, FVector(-800.f, 0.f, 300.f));
+        Queue->Flush();
+
+        ASSERT_THAT(AreEqual(60.f, Player->CurrentHealth));
+        ASSERT_THAT(IsFalse(Player->bIsDead));
+    }
+
+    TEST_METHOD(SingleHit_LaunchesLikeTheInlineKnockback)
+    {
+        AFPSEnemyDumb* Queued = SpawnEnemy(FVector(0.f, 0.f, 100.f));
+        AFPSEnemyDumb* Inline = SpawnEnemy(FVector(500.f, 0.f, 100.f));
+        ASSERT_THAT(IsNotNull(Queued));
+        ASSERT_THAT(IsNotNull(Inline));
+
+        // Pointing down, which the old per-axis aggregation lost
+        const FVector Direction = FVector(1.f, 0.5f, -0.3f).GetSafeNormal();
+        Queue->QueueDamage(Queued, 5.f, Direction * 800.f);
+        Queue->Flush();
+        Inline->ApplyKnockback(Direction, 800.f);
+
+        const FVector QueuedLaunch = Queued->GetCharacterMovement()->PendingLaunchVelocity;
+        const FVector InlineLaunch = Inline->GetCharacterMovement()->PendingLaunchVelocity;
+        ASSERT_THAT(IsTrue(QueuedLaunch.Equals(InlineLaunch, 0.01f)));
+        ASSERT_THAT(IsTrue(QueuedLaunch.Z < 0.f));
+    }
+};
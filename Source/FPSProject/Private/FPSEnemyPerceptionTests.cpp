@@ -0,0 +1,124 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CQTest.h"
+#include "../FPSEnemyPerception.h"
+#include "../FPSEnemyPatrol.h"
+#include "../FPSCharacter.h"
+#include "Engine/World.h"
+
+TEST_CLASS(EnemyPerception_CQ, "Game.Unit.EnemyPerception")
+{
+    UWorld* TestWorld;
+    UFPSEnemyPerception* SUT;
+    AFPSCharacter* Player;
+
+    BEFORE_EACH()
+    {
+        TestWorld = UWorld::CreateWorld(EWorldType::Game, false, TEXT("EnemyPerceptionWorld"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(TestWorld);
+        TestWorld->InitializeActorsForPlay(FURL());
+
+        SUT = TestWorld->GetSubsystem<UFPSEnemyPerception>();
+        ASSERT_THAT(IsNotNull(SUT));
+        SUT->bAsyncTraces = false;
+
+        Player = SpawnAt<AFPSCharacter>(FVector(1000.0f, 0.0f, 100.0f), FRotator::ZeroRotator);
+        ASSERT_THAT(IsNotNull(Player));
+    }
+
+    AFTER_EACH()
+    {
+        if (TestWorld)
+        {
+            TestWorld->DestroyWorld(true);
+            TestWorld = nullptr;
+        }
+        SUT = nullptr;
+        Player = nullptr;
+    }
+
+    template<typename T>
+    T* SpawnAt(const FVector& Location, const FRotator& Rotation)
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        return TestWorld->SpawnActor<T>(T::StaticClass(), Location, Rotation, SpawnParams);
+    }
+
+    AFPSEnemyPatrol* SpawnEnemy(const FVector& Location, const FRotator& Rotation)
+    {
+        AFPSEnemyPatrol* Enemy = SpawnAt<AFPSEnemyPatrol>(Location, Rotation);
+        SUT->RegisterEnemy(Enemy);
+        return Enemy;
+    }
+
+    TEST_METHOD(FacingPlayerInRange_Sees)
+    {
+        AFPSEnemyPatrol* Enemy = SpawnEnemy(FVector(0.0f, 0.0f, 100.0f), FRotator::ZeroRotator);
+
+        SUT->UpdatePerception(0.016f);
+
+        const FEnemyPerception* Perception = SUT->GetPerception(Enemy);
+        ASSERT_THAT(IsNotNull(Perception));
+        ASSERT_THAT(IsTrue(Perception->bCanSee));
+        ASSERT_THAT(IsTrue(Perception->bHasLineOfSight));
+        ASSERT_THAT(AreEqual(1, SUT->GetNumTracesLastUpdate()));
+    }
+
+    TEST_METHOD(FacingAway_NeitherSeesNorTraces)
+    {
+        AFPSEnemyPatrol* Enemy = SpawnEnemy(FVector(0.0f, 0.0f, 100.0f), FRotator(0.0f, 180.0f, 0.0f));
+
+        SUT->UpdatePerception(0.016f);
+
+        ASSERT_THAT(IsFalse(SUT->GetPerception(Enemy)->bCanSee));
+        ASSERT_THAT(AreEqual(0, SUT->GetNumTracesLastUpdate()));
+    }
+
+    TEST_METHOD(CloseBehind_HearsWithoutSeeing)
+    {
+        AFPSEnemyPatrol* Enemy = SpawnEnemy(FVector(1500.0f, 0.0f, 100.0f), FRotator::ZeroRotator);
+
+        SUT->UpdatePerception(0.016f);
+
+        ASSERT_THAT(IsFalse(SUT->GetPerception(Enemy)->bCanSee));
+        ASSERT_THAT(IsTrue(SUT->GetPerception(Enemy)->bCanHear));
+    }
+
+    TEST_METHOD(LostSight_IsHeldForTheDelay)
+    {
+        AFPSEnemyPatrol* Enemy = SpawnEnemy(FVector(0.0f, 0.0f, 100.0f), FRotator::ZeroRotator);
+        SUT->UpdatePerception(0.016f);
+        ASSERT_THAT(IsTrue(SUT->GetPerception(Enemy)->bHasLineOfSight));
+
+        Enemy->SetActorRotation(FRotator(0.0f, 180.0f, 0.0f));
+        SUT->UpdatePerception(SUT->LoseSightDelay * 0.5f);
+        ASSERT_THAT(IsFalse(SUT->GetPerception(Enemy)->bCanSee));
+        ASSERT_THAT(IsTrue(SUT->GetPerception(Enemy)->bHasLineOfSight));
+
+        SUT->UpdatePerception(SUT->LoseSightDelay);
+        ASSERT_THAT(IsFalse(SUT->GetPerception(Enemy)->bHasLineOfSight));
+    }
+
+    TEST_METHOD(TracesPerUpdate_StayWithinBudget)
+    {
+        SUT->TraceBudget = 3;
+        TArray<AFPSEnemyPatrol*> Enemies;
+        for (int32 i = 0; i < 10; i++)
+        {
+            Enemies.Add(SpawnEnemy(FVector(0.0f, i * 100.0f, 100.0f), FRotator::ZeroRotator));
+        }
+
+        for (int32 Update = 0; Update < 3; Update++)
+        {
+            SUT->UpdatePerception(0.016f);
+            ASSERT_THAT(AreEqual(3, SUT->GetNumTracesLastUpdate()));
+        }
+        ASSERT_THAT(IsFalse(SUT->GetPerception(Enemies.Last())->bCanSee));
+
+        // The next slice picks up where the last one stopped
+        SUT->UpdatePerception(0.016f);
+        ASSERT_THAT(IsTrue(SUT->GetPerception(Enemies.Last())->bCanSee));
+    }
+};
@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CQTest.h"
+#include "../FPSEnemySignificance.h"
+#include "../FPSEnemyDumb.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Engine/World.h"
+
+TEST_CLASS(EnemySignificance_CQ, "Game.Unit.EnemySignificance")
+{
+    UWorld* TestWorld;
+    UFPSEnemySignificance* Significance;
+
+    BEFORE_EACH()
+    {
+        TestWorld = UWorld::CreateWorld(EWorldType::Game, false, TEXT("EnemySignificanceWorld"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(TestWorld);
+        TestWorld->InitializeActorsForPlay(FURL());
+
+        Significance = TestWorld->GetSubsystem<UFPSEnemySignificance>();
+        ASSERT_THAT(IsNotNull(Significance));
+    }
+
+    AFTER_EACH()
+    {
+        if (TestWorld)
+        {
+            TestWorld->DestroyWorld(true);
+            TestWorld = nullptr;
+        }
+        Significance = nullptr;
+    }
+
+    TEST_METHOD(Evaluate_BucketsByDistanceAndView)
+    {
+        const float Near = Significance->NearDistance;
+        const float Mid = Significance->MidDistance;
+
+        ASSERT_THAT(AreEqual(EEnemySignificance::Critical, Significance->EvaluateSignificance(EEnemySignificance::Low, Near * 0.5f, -1.0f)));
+        ASSERT_THAT(AreEqual(EEnemySignificance::High, Significance->EvaluateSignificance(EEnemySignificance::Low, Mid * 0.5f, 1.0f)));
+        ASSERT_THAT(AreEqual(EEnemySignificance::Medium, Significance->EvaluateSignificance(EEnemySignificance::Low, Mid * 0.5f, -1.0f)));
+        ASSERT_THAT(AreEqual(EEnemySignificance::Low, Significance->EvaluateSignificance(EEnemySignificance::Low, Mid * 2.0f, -1.0f)));
+    }
+
+    TEST_METHOD(Evaluate_HysteresisHoldsBucketJustPastThreshold)
+    {
+        const float JustPastNear = Significance->NearDistance * (1.0f + Significance->Hysteresis * 0.5f);
+
+        ASSERT_THAT(AreEqual(EEnemySignificance::Critical, Significance->EvaluateSignificance(EEnemySignificance::Critical, JustPastNear, -1.0f)));
+        ASSERT_THAT(AreEqual(EEnemySignificance::Medium, Significance->EvaluateSignificance(EEnemySignificance::Medium, JustPastNear, -1.0f)));
+
+        const float WellPastNear = Significance->NearDistance * (1.0f + Significance->Hysteresis * 2.0f);
+        ASSERT_THAT(AreEqual(EEnemySignificance::Medium, Significance->EvaluateSignificance(EEnemySignificance::Critical, WellPastNear, -1.0f)));
+    }
+
+    TEST_METHOD(Update_AppliesTickIntervalsAndCountsBuckets)
+    {
+        AFPSEnemyDumb* Close = TestWorld->SpawnActor<AFPSEnemyDumb>(AFPSEnemyDumb::StaticClass(), FVector(100.f, 0.f, 0.f), FRotator::ZeroRotator);
+        AFPSEnemyDumb* Far = TestWorld->SpawnActor<AFPSEnemyDumb>(AFPSEnemyDumb::StaticClass(), FVector(-50000.f, 0.f, 0.f), FRotator::ZeroRotator);
+        ASSERT_THAT(IsNotNull(Close));
+        ASSERT_THAT(IsNotNull(Far));
+        Close->DispatchBeginPlay();
+        Far->DispatchBeginPlay();
+
+        FSignificanceViewer Viewer;
+        Viewer.Location = FVector::ZeroVector;
+        Viewer.Direction = FVector::ForwardVector;
+        Significance->UpdateSignificance({ Viewer });
+
+        ASSERT_THAT(AreEqual(EEnemySignificance::Critical, Close->GetSignificance()));
+        ASSERT_THAT(AreEqual(EEnemySignificance::Low, Far->GetSignificance()));
+        ASSERT_THAT(AreEqual(1, Significance->GetBucketCount(EEnemySignificance::Critical)));
+        ASSERT_THAT(AreEqual(1, Significance->GetBucketCount(EEnemySignificance::Low)));
+
+        const FEnemyTickLOD& LowLOD = Significance->GetTickLOD(EEnemySignificance::Low);
+        ASSERT_THAT(IsNear(LowLOD.ActorTickInterval, Far->GetActorTickInterval(), 0.001f));
+        ASSERT_THAT(IsNear(LowLOD.MovementTickInterval, Far->GetCharacterMovement()->GetComponentTickInterval(), 0.001f));
+        ASSERT_THAT(IsNear(0.0f, Close->GetActorTickInterval(), 0.001f));
+    }
+};
@@ -5,6 +5,7 @@
 #include "../FPSEnemySpawnManager.h"
 #include "../FPSEnemyPatrol.h"
 #include "../FPSEnemyDumb.h"
+#include "../FPSEnemyPool.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
 
@@ -220,4 +221,36 @@ TEST_CLASS(SpawnManager_CQ_Showcase, "Game.Unit.EnemySpawning")
         ASSERT_THAT(AreEqual(0, SUT->DumbEnemies.Num()));
         ASSERT_THAT(IsNotNull(SUT->CurrentSmartEnemy));
     }
-};
\ No newline at end of file
+
+    TEST_METHOD(Pool_PrewarmsOnBeginPlay)
+    {
+        UFPSEnemyPool* Pool = TestWorld->GetSubsystem<UFPSEnemyPool>();
+        ASSERT_THAT(IsNotNull(Pool));
+        ASSERT_THAT(AreEqual(SUT->PrewarmDumbEnemies, Pool->GetNumFree(SUT->DumbEnemy)));
+        ASSERT_THAT(AreEqual(SUT->PrewarmSmartEnemies - 1, Pool->GetNumFree(SUT->SmartEnemy)));
+        ASSERT_THAT(AreEqual(0, Pool->GetStats().Spawned));
+    }
+
+    TEST_METHOD(Pool_KilledEnemyReturnsToPoolAndIsReused)
+    {
+        AFPSEnemyPatrol* First = SUT->CurrentSmartEnemy;
+        ASSERT_THAT(IsNotNull(First));
+
+        First->ReceiveDamage(First->MaxHealth);
+
+        ASSERT_THAT(IsTrue(IsValid(First)));
+        ASSERT_THAT(IsTrue(First->IsInPool()));
+        ASSERT_THAT(IsTrue(First->IsHidden()));
+        ASSERT_THAT(IsNotNull(SUT->CurrentSmartEnemy));
+        ASSERT_THAT(IsTrue(SUT->CurrentSmartEnemy != First));
+        ASSERT_THAT(IsNear(SUT->CurrentSmartEnemy->MaxHealth, SUT->CurrentSmartEnemy->CurrentHealth, 0.01f));
+
+        SUT->CurrentSmartEnemy->ReceiveDamage(SUT->CurrentSmartEnemy->MaxHealth);
+        SUT->CurrentSmartEnemy->ReceiveDamage(SUT->CurrentSmartEnemy->MaxHealth);
+        ASSERT_THAT(AreEqual(ESpawnerPhase::Phase2, SUT->CurrentPhase));
+
+        UFPSEnemyPool* Pool = TestWorld->GetSubsystem<UFPSEnemyPool>();
+        ASSERT_THAT(AreEqual(0, Pool->GetStats().Spawned));
+        ASSERT_THAT(IsNotNull(First->GetController()));
+    }
+};
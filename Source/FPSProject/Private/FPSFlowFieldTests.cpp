@@ -0,0 +1,91 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CQTest.h"
+#include "../FPSFlowField.h"
+#include "Engine/World.h"
+
+TEST_CLASS(FlowField_CQ, "Game.Unit.FlowField")
+{
+    UWorld* TestWorld;
+    UFPSFlowField* FlowField;
+
+    // 10x10 cells of 100 units with a wall along X = 5 that is open only at Y = 9
+    static bool SampleWalledGrid(const FVector& Center, float& OutHeight)
+    {
+        OutHeight = 0.0f;
+        const int32 X = FMath::FloorToInt(Center.X / 100.f);
+        const int32 Y = FMath::FloorToInt(Center.Y / 100.f);
+        return !(X == 5 && Y < 9);
+    }
+
+    static FVector CellCenter(int32 X, int32 Y)
+    {
+        return FVector(X * 100.f + 50.f, Y * 100.f + 50.f, 0.f);
+    }
+
+    BEFORE_EACH()
+    {
+        TestWorld = UWorld::CreateWorld(EWorldType::Game, false, TEXT("FlowFieldWorld"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(TestWorld);
+        TestWorld->InitializeActorsForPlay(FURL());
+
+        FlowField = TestWorld->GetSubsystem<UFPSFlowField>();
+        ASSERT_THAT(IsNotNull(FlowField));
+        FlowField->BuildGrid(FVector::ZeroVector, FIntPoint(10, 10), 100.f, &SampleWalledGrid);
+    }
+
+    AFTER_EACH()
+    {
+        if (TestWorld)
+        {
+            TestWorld->DestroyWorld(true);
+            TestWorld = nullptr;
+        }
+        FlowField = nullptr;
+    }
+
+    TEST_METHOD(OpenGround_PointsStraightAtTarget)
+    {
+        FlowField->SetTarget(CellCenter(2, 0));
+
+        FVector Direction;
+        ASSERT_THAT(IsTrue(FlowField->GetDirection(CellCenter(0, 0), Direction)));
+        ASSERT_THAT(IsNear(1.0f, Direction.X, 0.01f));
+        ASSERT_THAT(IsNear(0.0f, Direction.Y, 0.01f));
+    }
+
+    TEST_METHOD(Wall_IsSteeredAroundThroughTheGap)
+    {
+        FlowField->SetTarget(CellCenter(8, 0));
+
+        FVector Direction;
+        ASSERT_THAT(IsTrue(FlowField->GetDirection(CellCenter(4, 0), Direction)));
+        ASSERT_THAT(IsTrue(Direction.Y > 0.5f));
+    }
+
+    TEST_METHOD(SameCellTarget_RecomputesOnlyOnCellChange)
+    {
+        ASSERT_THAT(IsTrue(FlowField->SetTarget(CellCenter(2, 2))));
+        ASSERT_THAT(IsFalse(FlowField->SetTarget(CellCenter(2, 2) + FVector(20.f, 20.f, 0.f))));
+        ASSERT_THAT(AreEqual(1, FlowField->GetNumRecomputes()));
+
+        FVector Direction;
+        ASSERT_THAT(IsFalse(FlowField->GetDirection(CellCenter(2, 2), Direction)));
+        ASSERT_THAT(IsFalse(FlowField->GetDirection(FVector(-500.f, 0.f, 0.f), Direction)));
+    }
+
+    TEST_METHOD(MovedTarget_LeavesNothingOfThePreviousField)
+    {
+        FlowField->MaxPathLength = 300.f;
+        FlowField->SetTarget(CellCenter(0, 0));
+
+        FVector Direction;
+        ASSERT_THAT(IsTrue(FlowField->GetDirection(CellCenter(1, 1), Direction)));
+
+        // Out of reach from the new target, so the old direction must be gone
+        FlowField->SetTarget(CellCenter(9, 9));
+        ASSERT_THAT(IsFalse(FlowField->GetDirection(CellCenter(1, 1), Direction)));
+        ASSERT_THAT(IsTrue(FlowField->GetDirection(CellCenter(8, 8), Direction)));
+    }
+};
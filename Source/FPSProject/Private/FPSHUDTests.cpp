@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CQTest.h"
+#include "../FPSHUD.h"
+#include "../FPSCharacter.h"
+#include "../FPSWeaponBase.h"
+#include "Engine/World.h"
+
+// Exposes the retained text cache without a canvas
+class AFPSHUDTestable : public AFPSHUD
+{
+public:
+    void Bind(AFPSCharacter* Player) { BindToPlayer(Player); }
+    void Rebuild(AFPSCharacter* Player) { RebuildTexts(Player); }
+};
+
+TEST_CLASS(RetainedHUD_CQ, "Game.Unit.HUD")
+{
+    UWorld* TestWorld;
+    AFPSCharacter* Player;
+    AFPSWeaponBase* Weapon;
+    AFPSHUDTestable* HUD;
+
+    BEFORE_EACH()
+    {
+        TestWorld = UWorld::CreateWorld(EWorldType::Game, false, TEXT("HUDWorld"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(TestWorld);
+        TestWorld->InitializeActorsForPlay(FURL());
+
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        Player = TestWorld->SpawnActor<AFPSCharacter>(AFPSCharacter::StaticClass(), FTransform::Identity, SpawnParams);
+        Weapon = TestWorld->SpawnActor<AFPSWeaponBase>(AFPSWeaponBase::StaticClass(), FTransform::Identity, SpawnParams);
+        HUD = static_cast<AFPSHUDTestable*>(TestWorld->SpawnActor<AFPSHUD>(AFPSHUD::StaticClass(), FTransform::Identity, SpawnParams));
+        ASSERT_THAT(IsNotNull(Player));
+        ASSERT_THAT(IsNotNull(Weapon));
+        ASSERT_THAT(IsNotNull(HUD));
+
+        Player->SetEquippedWeapon(Weapon);
+        HUD->Bind(Player);
+        HUD->Rebuild(Player);
+    }
+
+    AFTER_EACH()
+    {
+        if (TestWorld)
+        {
+            TestWorld->DestroyWorld(true);
+            TestWorld = nullptr;
+        }
+        Player = nullptr;
+        Weapon = nullptr;
+        HUD = nullptr;
+    }
+
+    TEST_METHOD(NothingChanged_FormatsNothing)
+    {
+        const int32 Before = HUD->NumTextRebuilds;
+        HUD->Rebuild(Player);
+        HUD->Rebuild(Player);
+
+        ASSERT_THAT(AreEqual(Before, HUD->NumTextRebuilds));
+    }
+
+    TEST_METHOD(HealthChange_ReformatsOnlyHealth)
+    {
+        const int32 Before = HUD->NumTextRebuilds;
+        Player->Heal(1.f);
+        HUD->Rebuild(Player);
+
+        ASSERT_THAT(AreEqual(Before + 1, HUD->NumTextRebuilds));
+    }
+
+    TEST_METHOD(AmmoChange_UpdatesTheAmmoText)
+    {
+        Weapon->BulletsInMag = 3;
+        Weapon->NotifyAmmoChanged();
+        HUD->Rebuild(Player);
+
+        ASSERT_THAT(AreEqual(FString::Printf(TEXT("3 / %d"), Weapon->GetTotalReserveBullets()), HUD->LastDrawnAmmoString));
+    }
+
+    TEST_METHOD(Achievement_IsHiddenByTimerNotByDraw)
+    {
+        HUD->ShowAchievement(TEXT("Test"));
+        ASSERT_THAT(IsTrue(HUD->IsShowingAchievement()));
+
+        TestWorld->GetTimerManager().Tick(2.5f);
+        ASSERT_THAT(IsFalse(HUD->IsShowingAchievement()));
+    }
+};
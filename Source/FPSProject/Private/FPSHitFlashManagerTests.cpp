@@ -0,0 +1,117 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CQTest.h"
+#include "../FPSHitFlashManager.h"
+#include "Components/StaticMeshComponent.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Engine/World.h"
+
+TEST_CLASS(HitFlashManager_CQ, "Game.Unit.HitFlash")
+{
+    UWorld* TestWorld;
+    UFPSHitFlashManager* HitFlash;
+
+    UStaticMeshComponent* MakeComponent()
+    {
+        AActor* Owner = TestWorld->SpawnActor<AActor>(AActor::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator);
+        UStaticMeshComponent* Component = NewObject<UStaticMeshComponent>(Owner);
+        Component->RegisterComponent();
+        return Component;
+    }
+
+    float FlashValue(UPrimitiveComponent* Component) const
+    {
+        const TArray<float>& Data = Component->GetCustomPrimitiveData().Data;
+        return Data.IsValidIndex(HitFlash->FlashDataIndex) ? Data[HitFlash->FlashDataIndex] : 0.0f;
+    }
+
+    BEFORE_EACH()
+    {
+        TestWorld = UWorld::CreateWorld(EWorldType::Game, false, TEXT("HitFlashWorld"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(TestWorld);
+        TestWorld->InitializeActorsForPlay(FURL());
+
+        HitFlash = TestWorld->GetSubsystem<UFPSHitFlashManager>();
+        ASSERT_THAT(IsNotNull(HitFlash));
+        HitFlash->FlashDuration = 0.2f;
+    }
+
+    AFTER_EACH()
+    {
+        if (TestWorld)
+        {
+            TestWorld->DestroyWorld(true);
+            TestWorld = nullptr;
+        }
+        HitFlash = nullptr;
+    }
+
+    TEST_METHOD(StartFlash_FadesOutAndIsRemoved)
+    {
+        UStaticMeshComponent* Component = MakeComponent();
+
+        HitFlash->StartFlash(Component);
+        ASSERT_THAT(AreEqual(1, HitFlash->GetNumActiveFlashes()));
+        ASSERT_THAT(IsNear(1.0f, FlashValue(Component), 0.001f));
+
+        HitFlash->Tick(0.1f);
+        ASSERT_THAT(IsNear(0.5f, FlashValue(Component), 0.001f));
+
+        HitFlash->Tick(0.2f);
+        ASSERT_THAT(AreEqual(0, HitFlash->GetNumActiveFlashes()));
+        ASSERT_THAT(IsNear(0.0f, FlashValue(Component), 0.001f));
+    }
+
+    TEST_METHOD(RepeatedHits_RefreshInsteadOfStacking)
+    {
+        UStaticMeshComponent* Component = MakeComponent();
+
+        HitFlash->StartFlash(Component);
+        HitFlash->Tick(0.15f);
+        HitFlash->StartFlash(Component);
+
+        ASSERT_THAT(AreEqual(1, HitFlash->GetNumActiveFlashes()));
+        ASSERT_THAT(IsNear(1.0f, FlashValue(Component), 0.001f));
+    }
+
+    TEST_METHOD(StopFlash_KeepsOtherFlashesRunning)
+    {
+        UStaticMeshComponent* First = MakeComponent();
+        UStaticMeshComponent* Second = MakeComponent();
+        UStaticMeshComponent* Third = MakeComponent();
+
+        HitFlash->StartFlash(First);
+        HitFlash->StartFlash(Second);
+        HitFlash->StartFlash(Third);
+        HitFlash->StopFlash(First);
+
+        ASSERT_THAT(AreEqual(2, HitFlash->GetNumActiveFlashes()));
+        ASSERT_THAT(IsNear(0.0f, FlashValue(First), 0.001f));
+
+        // The moved entry must still be found after the swap-remove
+        HitFlash->StopFlash(Third);
+        ASSERT_THAT(AreEqual(1, HitFlash->GetNumActiveFlashes()));
+        ASSERT_THAT(IsNear(1.0f, FlashValue(Second), 0.001f));
+    }
+
+    TEST_METHOD(WithMaterial_TintsUntilTheEndWithoutCustomData)
+    {
+        UStaticMeshComponent* Component = MakeComponent();
+        UMaterialInstanceDynamic* Material = UMaterialInstanceDynamic::Create(UMaterial::GetDefaultMaterial(MD_Surface), Component);
+
+        HitFlash->StartFlash(Component, Material);
+        HitFlash->Tick(0.1f);
+
+        FLinearColor Color;
+        Material->GetVectorParameterValue(FHashedMaterialParameterInfo(HitFlash->ColorParameter), Color);
+        ASSERT_THAT(IsTrue(Color == HitFlash->FlashColor));
+        ASSERT_THAT(IsNear(0.0f, FlashValue(Component), 0.001f));
+
+        HitFlash->Tick(0.2f);
+        Material->GetVectorParameterValue(FHashedMaterialParameterInfo(HitFlash->ColorParameter), Color);
+        ASSERT_THAT(IsTrue(Color == HitFlash->RestColor));
+        ASSERT_THAT(AreEqual(0, HitFlash->GetNumActiveFlashes()));
+    }
+};
@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CQTest.h"
+#include "../FPSHitscanSubsystem.h"
+#include "../FPSDamageQueue.h"
+#include "../FPSEnemyDumb.h"
+#include "Engine/World.h"
+
+TEST_CLASS(HitscanSubsystem_CQ, "Game.Unit.Hitscan")
+{
+    UWorld* TestWorld;
+    UFPSHitscanSubsystem* Hitscan;
+    UFPSDamageQueue* DamageQueue;
+    AFPSEnemyDumb* Enemy;
+
+    BEFORE_EACH()
+    {
+        TestWorld = UWorld::CreateWorld(EWorldType::Game, false, TEXT("HitscanWorld"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(TestWorld);
+        TestWorld->InitializeActorsForPlay(FURL());
+
+        Hitscan = TestWorld->GetSubsystem<UFPSHitscanSubsystem>();
+        DamageQueue = TestWorld->GetSubsystem<UFPSDamageQueue>();
+        ASSERT_THAT(IsNotNull(Hitscan));
+        ASSERT_THAT(IsNotNull(DamageQueue));
+
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        Enemy = TestWorld->SpawnActor<AFPSEnemyDumb>(AFPSEnemyDumb::StaticClass(), FVector(500.f, 0.f, 1000.f), FRotator::ZeroRotator, SpawnParams);
+        ASSERT_THAT(IsNotNull(Enemy));
+        Enemy->bFlashOnHit = false;
+        Enemy->MaxHealth = 100.f;
+        Enemy->CurrentHealth = 100.f;
+    }
+
+    AFTER_EACH()
+    {
+        if (TestWorld)
+        {
+            TestWorld->DestroyWorld(true);
+            TestWorld = nullptr;
+        }
+        Hitscan = nullptr;
+        DamageQueue = nullptr;
+        Enemy = nullptr;
+    }
+
+    TEST_METHOD(QueuedTraces_AreResolvedInOneBatch)
+    {
+        Hitscan->QueueTrace(FVector(0.f, 0.f, 1000.f), FVector(2000.f, 0.f, 1000.f), 10.f, nullptr);
+        Hitscan->QueueTrace(FVector(0.f, 0.f, 1000.f), FVector(0.f, 2000.f, 1000.f), 10.f, nullptr);
+        ASSERT_THAT(AreEqual(2, Hitscan->GetNumQueued()));
+
+        Hitscan->ResolveTraces();
+        ASSERT_THAT(AreEqual(0, Hitscan->GetNumQueued()));
+        ASSERT_THAT(AreEqual(1, DamageQueue->GetNumPending()));
+
+        DamageQueue->Flush();
+        ASSERT_THAT(AreEqual(90.f, Enemy->CurrentHealth));
+    }
+
+    TEST_METHOD(Pellets_EachDealFullDamage)
+    {
+        Hitscan->QueueShot(FVector(0.f, 0.f, 1000.f), FVector(1.f, 0.f, 0.f), 2000.f, 4, 0.f, 5.f, nullptr);
+        ASSERT_THAT(AreEqual(4, Hitscan->GetNumQueued()));
+
+        Hitscan->ResolveTraces();
+        DamageQueue->Flush();
+        ASSERT_THAT(AreEqual(80.f, Enemy->CurrentHealth));
+    }
+
+    TEST_METHOD(Instigator_IsNotHitByItsOwnShot)
+    {
+        Hitscan->QueueTrace(FVector(0.f, 0.f, 1000.f), FVector(2000.f, 0.f, 1000.f), 10.f, Enemy);
+        Hitscan->ResolveTraces();
+
+        ASSERT_THAT(AreEqual(0, DamageQueue->GetNumPending()));
+    }
+
+    TEST_METHOD(AsyncTraces_AreKeptInFlightUntilTheNextBatch)
+    {
+        Hitscan->bAsyncTraces = true;
+        Hitscan->QueueTrace(FVector(0.f, 0.f, 1000.f), FVector(2000.f, 0.f, 1000.f), 10.f, nullptr);
+        Hitscan->ResolveTraces();
+
+        ASSERT_THAT(AreEqual(0, Hitscan->GetNumQueued()));
+        ASSERT_THAT(AreEqual(1, Hitscan->GetNumInFlight()));
+    }
+};
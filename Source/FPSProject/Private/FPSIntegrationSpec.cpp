@@ -14,6 +14,7 @@
 #include "../FPSHUD.h"
 #include "../FPSEnemyBase.h"
 #include "../FPSEnemyDumb.h"
+#include "../FPSDamageQueue.h"
 
 DEFINE_SPEC(FPSIntegrationSpec, "Game.FPS.Integration", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
 
@@ -100,6 +101,7 @@ void FPSIntegrationSpec::Define() {
             Enemy->ContactDamage = 25.0f;
 
             Enemy->OnOverlapBegin(nullptr, Player, nullptr, 0, false, FHitResult());
+            World->GetSubsystem<UFPSDamageQueue>()->Flush();
 
             TestEqual("Player health reduced by contact damage", Player->CurrentHealth, 75.0f);
 
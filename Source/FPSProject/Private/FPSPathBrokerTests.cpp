@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CQTest.h"
+#include "../FPSPathBroker.h"
+#include "Engine/World.h"
+
+TEST_CLASS(PathBroker_CQ, "Game.Unit.PathBroker")
+{
+    UWorld* TestWorld;
+    UFPSPathBroker* SUT;
+    int32 NumFailed;
+
+    BEFORE_EACH()
+    {
+        TestWorld = UWorld::CreateWorld(EWorldType::Game, false, TEXT("PathBrokerWorld"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(TestWorld);
+        TestWorld->InitializeActorsForPlay(FURL());
+
+        SUT = TestWorld->GetSubsystem<UFPSPathBroker>();
+        ASSERT_THAT(IsNotNull(SUT));
+        NumFailed = 0;
+    }
+
+    AFTER_EACH()
+    {
+        if (TestWorld)
+        {
+            TestWorld->DestroyWorld(true);
+            TestWorld = nullptr;
+        }
+        SUT = nullptr;
+    }
+
+    AActor* SpawnAgent(const FVector& Location)
+    {
+        return TestWorld->SpawnActor<AActor>(AActor::StaticClass(), Location, FRotator::ZeroRotator);
+    }
+
+    FOnBrokeredPath CountFailures()
+    {
+        return FOnBrokeredPath::CreateLambda([this](const TArray<FVector>& Points, bool bSuccess)
+        {
+            if (!bSuccess)
+            {
+                NumFailed++;
+            }
+        });
+    }
+
+    TEST_METHOD(SameTargetTwice_MergesIntoOneRequest)
+    {
+        AActor* Agent = SpawnAgent(FVector::ZeroVector);
+
+        SUT->RequestPath(Agent, FVector(1000.0f, 0.0f, 0.0f), CountFailures());
+        SUT->RequestPath(Agent, FVector(1010.0f, 0.0f, 0.0f), CountFailures());
+
+        ASSERT_THAT(AreEqual(1, SUT->GetNumQueued()));
+        ASSERT_THAT(AreEqual(1, SUT->GetNumMerged()));
+    }
+
+    TEST_METHOD(NewTarget_ReplacesThePendingRequest)
+    {
+        AActor* Agent = SpawnAgent(FVector::ZeroVector);
+
+        SUT->RequestPath(Agent, FVector(1000.0f, 0.0f, 0.0f), CountFailures());
+        SUT->RequestPath(Agent, FVector(-1000.0f, 0.0f, 0.0f), CountFailures());
+
+        ASSERT_THAT(AreEqual(1, SUT->GetNumQueued()));
+        ASSERT_THAT(AreEqual(0, SUT->GetNumMerged()));
+    }
+
+    TEST_METHOD(ProcessQueue_StaysWithinBudget)
+    {
+        SUT->QueriesPerFrame = 2;
+        for (int32 i = 0; i < 5; i++)
+        {
+            SUT->RequestPath(SpawnAgent(FVector(i * 100.0f, 0.0f, 0.0f)), FVector(0.0f, 1000.0f, 0.0f), CountFailures());
+        }
+
+        // Without a navmesh every issued request comes back as a failure at once
+        SUT->ProcessQueue();
+        ASSERT_THAT(AreEqual(3, SUT->GetNumQueued()));
+        ASSERT_THAT(AreEqual(2, NumFailed));
+
+        SUT->ProcessQueue();
+        SUT->ProcessQueue();
+        ASSERT_THAT(AreEqual(0, SUT->GetNumQueued()));
+        ASSERT_THAT(AreEqual(5, NumFailed));
+    }
+
+    TEST_METHOD(CancelRequest_DropsIt)
+    {
+        AActor* Agent = SpawnAgent(FVector::ZeroVector);
+        SUT->RequestPath(Agent, FVector(1000.0f, 0.0f, 0.0f), CountFailures());
+
+        SUT->CancelRequest(Agent);
+        SUT->ProcessQueue();
+
+        ASSERT_THAT(IsFalse(SUT->HasRequest(Agent)));
+        ASSERT_THAT(AreEqual(0, NumFailed));
+    }
+};
@@ -0,0 +1,104 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CQTest.h"
+#include "../FPSPickupField.h"
+#include "../FPSPopulationDirector.h"
+#include "../FPSCharacter.h"
+#include "../HealthPackPickup.h"
+#include "../CollectiblePickup.h"
+#include "Engine/World.h"
+
+TEST_CLASS(PickupField_CQ, "Game.Unit.PickupField")
+{
+    UWorld* TestWorld;
+    UFPSPickupField* Field;
+    AFPSCharacter* Player;
+    TArray<AFPSCharacter*> Players;
+
+    BEFORE_EACH()
+    {
+        TestWorld = UWorld::CreateWorld(EWorldType::Game, false, TEXT("PickupFieldWorld"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(TestWorld);
+        TestWorld->InitializeActorsForPlay(FURL());
+
+        Field = TestWorld->GetSubsystem<UFPSPickupField>();
+        ASSERT_THAT(IsNotNull(Field));
+
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        Player = TestWorld->SpawnActor<AFPSCharacter>(AFPSCharacter::StaticClass(), FTransform::Identity, SpawnParams);
+        ASSERT_THAT(IsNotNull(Player));
+        Players = { Player };
+    }
+
+    AFTER_EACH()
+    {
+        if (TestWorld)
+        {
+            TestWorld->DestroyWorld(true);
+            TestWorld = nullptr;
+        }
+        Field = nullptr;
+        Player = nullptr;
+        Players.Reset();
+    }
+
+    TEST_METHOD(TouchedPickup_IsCollectedThroughOnCollected)
+    {
+        Player->CurrentHealth = 50.f;
+        ASSERT_THAT(IsTrue(Field->AddPickup(AHealthPackPickup::StaticClass(), FVector(50.f, 0.f, 0.f))));
+
+        ASSERT_THAT(AreEqual(1, Field->CollectPickups(Players)));
+        ASSERT_THAT(AreEqual(75.f, Player->CurrentHealth));
+        ASSERT_THAT(AreEqual(0, Field->GetNumPickups()));
+    }
+
+    TEST_METHOD(DistantPickups_StayInTheField)
+    {
+        Field->AddPickup(ACollectiblePickup::StaticClass(), FVector(1000.f, 0.f, 0.f));
+        Field->AddPickup(ACollectiblePickup::StaticClass(), FVector(0.f, 0.f, 500.f));
+
+        ASSERT_THAT(AreEqual(0, Field->CollectPickups(Players)));
+        ASSERT_THAT(AreEqual(2, Field->GetNumPickups(ACollectiblePickup::StaticClass())));
+        ASSERT_THAT(AreEqual(0, Player->RedRubyCount));
+    }
+
+    TEST_METHOD(PickupAcrossCellBorder_IsStillCollected)
+    {
+        Field->CellSize = 100.f;
+        Player->SetActorLocation(FVector(95.f, 95.f, 0.f));
+        Field->AddPickup(ACollectiblePickup::StaticClass(), FVector(130.f, 130.f, 0.f));
+
+        ASSERT_THAT(AreEqual(1, Field->CollectPickups(Players)));
+        ASSERT_THAT(AreEqual(1, Player->RedRubyCount));
+    }
+
+    TEST_METHOD(CollectedSlots_AreReused)
+    {
+        Field->AddPickup(ACollectiblePickup::StaticClass(), FVector::ZeroVector);
+        Field->CollectPickups(Players);
+        Field->AddPickup(ACollectiblePickup::StaticClass(), FVector(2000.f, 0.f, 0.f));
+
+        ASSERT_THAT(AreEqual(1, Field->GetNumPickups()));
+        ASSERT_THAT(AreEqual(0, Field->CollectPickups(Players)));
+    }
+
+    TEST_METHOD(FieldPickups_CountAgainstTheirBudget)
+    {
+        UFPSPopulationDirector* Director = TestWorld->GetSubsystem<UFPSPopulationDirector>();
+        ASSERT_THAT(IsNotNull(Director));
+        Director->SetBudget(ACollectiblePickup::StaticClass(), 2);
+
+        Field->AddPickup(ACollectiblePickup::StaticClass(), FVector::ZeroVector);
+        Field->AddPickup(ACollectiblePickup::StaticClass(), FVector(2000.f, 0.f, 0.f));
+        ASSERT_THAT(AreEqual(2, Director->GetNumAlive(ACollectiblePickup::StaticClass())));
+        ASSERT_THAT(IsFalse(Director->RequestSpawn(ACollectiblePickup::StaticClass())));
+
+        Field->CollectPickups(Players);
+        ASSERT_THAT(IsTrue(Director->RequestSpawn(ACollectiblePickup::StaticClass())));
+
+        Field->RemoveAll();
+        ASSERT_THAT(AreEqual(0, Director->GetNumAlive(ACollectiblePickup::StaticClass())));
+    }
+};
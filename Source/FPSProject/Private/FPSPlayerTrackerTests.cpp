@@ -0,0 +1,75 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CQTest.h"
+#include "../FPSPlayerTracker.h"
+#include "../FPSCharacter.h"
+#include "Engine/World.h"
+
+TEST_CLASS(PlayerTracker_CQ, "Game.Unit.PlayerTracker")
+{
+    UWorld* TestWorld;
+    UFPSPlayerTracker* SUT;
+
+    BEFORE_EACH()
+    {
+        TestWorld = UWorld::CreateWorld(EWorldType::Game, false, TEXT("PlayerTrackerWorld"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(TestWorld);
+        TestWorld->InitializeActorsForPlay(FURL());
+
+        SUT = TestWorld->GetSubsystem<UFPSPlayerTracker>();
+        ASSERT_THAT(IsNotNull(SUT));
+    }
+
+    AFTER_EACH()
+    {
+        if (TestWorld)
+        {
+            TestWorld->DestroyWorld(true);
+            TestWorld = nullptr;
+        }
+        SUT = nullptr;
+    }
+
+    AFPSCharacter* SpawnPlayer(const FVector& Location)
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        return TestWorld->SpawnActor<AFPSCharacter>(AFPSCharacter::StaticClass(), Location, FRotator::ZeroRotator, SpawnParams);
+    }
+
+    TEST_METHOD(NoPlayers_FindsNothing)
+    {
+        ASSERT_THAT(IsTrue(SUT->FindNearestPlayer(FVector::ZeroVector) == nullptr));
+    }
+
+    TEST_METHOD(ManyQueriesInOneFrame_GatherOnce)
+    {
+        SpawnPlayer(FVector(100.0f, 0.0f, 100.0f));
+
+        for (int32 i = 0; i < 50; i++)
+        {
+            SUT->FindNearestPlayer(FVector(i * 10.0f, 0.0f, 0.0f));
+        }
+        ASSERT_THAT(AreEqual(1, SUT->GetNumRefreshes()));
+    }
+
+    TEST_METHOD(FindNearestPlayer_PicksTheCloserOne)
+    {
+        AFPSCharacter* Near = SpawnPlayer(FVector(200.0f, 0.0f, 100.0f));
+        SpawnPlayer(FVector(3000.0f, 0.0f, 100.0f));
+
+        const FTrackedPlayer* Found = SUT->FindNearestPlayer(FVector::ZeroVector);
+        ASSERT_THAT(IsNotNull(Found));
+        ASSERT_THAT(IsTrue(Found->Actor.Get() == Near));
+    }
+
+    TEST_METHOD(DeadPlayer_IsNotTracked)
+    {
+        AFPSCharacter* Player = SpawnPlayer(FVector(200.0f, 0.0f, 100.0f));
+        Player->bIsDead = true;
+
+        SUT->Refresh();
+        ASSERT_THAT(AreEqual(0, SUT->GetPlayers().Num()));
+    }
+};
@@ -0,0 +1,121 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CQTest.h"
+#include "../FPSPopulationDirector.h"
+#include "../FPSEnemySpawnManager.h"
+#include "../FPSEnemyBase.h"
+#include "../FPSEnemyPatrol.h"
+#include "../FPSEnemyDumb.h"
+#include "Engine/World.h"
+
+TEST_CLASS(PopulationDirector_CQ, "Game.Unit.EnemySpawning.PopulationDirector")
+{
+    UWorld* TestWorld;
+    UFPSPopulationDirector* Director;
+    AFPSEnemySpawnManager* SUT;
+
+    BEFORE_EACH()
+    {
+        FMath::RandInit(1337);
+
+        TestWorld = UWorld::CreateWorld(EWorldType::Game, false, TEXT("PopulationDirectorWorld"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(TestWorld);
+        TestWorld->InitializeActorsForPlay(FURL());
+
+        Director = TestWorld->GetSubsystem<UFPSPopulationDirector>();
+        ASSERT_THAT(IsNotNull(Director));
+
+        SUT = TestWorld->SpawnActor<AFPSEnemySpawnManager>(AFPSEnemySpawnManager::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator);
+        ASSERT_THAT(IsNotNull(SUT));
+        SUT->SmartEnemy = AFPSEnemyPatrol::StaticClass();
+        SUT->DumbEnemy = AFPSEnemyDumb::StaticClass();
+        SUT->SpawnRadius = 1000.f;
+    }
+
+    AFTER_EACH()
+    {
+        if (TestWorld)
+        {
+            TestWorld->DestroyWorld(true);
+            TestWorld = nullptr;
+        }
+        Director = nullptr;
+        SUT = nullptr;
+    }
+
+    TEST_METHOD(BaseClassBudget_CoversSubclassesAndRefusesOverCap)
+    {
+        Director->SetBudget(AFPSEnemyBase::StaticClass(), 2);
+
+        ASSERT_THAT(AreEqual(2, Director->GetBudget(AFPSEnemyDumb::StaticClass())));
+        ASSERT_THAT(IsTrue(Director->RequestSpawn(AFPSEnemyDumb::StaticClass())));
+        Director->Register(TestWorld->SpawnActor<AFPSEnemyDumb>(AFPSEnemyDumb::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator));
+        ASSERT_THAT(IsTrue(Director->RequestSpawn(AFPSEnemyPatrol::StaticClass())));
+        Director->Register(TestWorld->SpawnActor<AFPSEnemyPatrol>(AFPSEnemyPatrol::StaticClass(), FVector(500.f, 0.f, 0.f), FRotator::ZeroRotator));
+
+        ASSERT_THAT(IsFalse(Director->RequestSpawn(AFPSEnemyDumb::StaticClass())));
+        ASSERT_THAT(AreEqual(1, Director->GetStats().Refused));
+    }
+
+    TEST_METHOD(SetDefaultBudget_DoesNotOverrideConfiguredBudget)
+    {
+        Director->SetBudget(AFPSEnemyDumb::StaticClass(), 3);
+        SUT->MaxAliveDumbEnemies = 50;
+        SUT->DispatchBeginPlay();
+
+        ASSERT_THAT(AreEqual(3, Director->GetBudget(AFPSEnemyDumb::StaticClass())));
+        ASSERT_THAT(AreEqual(SUT->MaxAliveSmartEnemies, Director->GetBudget(AFPSEnemyPatrol::StaticClass())));
+    }
+
+    TEST_METHOD(Phase2Burst_OverBudget_IsDeferredUntilSlotsFree)
+    {
+        SUT->MaxAliveDumbEnemies = 3;
+        SUT->DispatchBeginPlay();
+        for (int i = 0; i < 3; ++i)
+        {
+            SUT->NotifySmartEnemyDeath(SUT->CurrentSmartEnemy);
+        }
+
+        ASSERT_THAT(AreEqual(ESpawnerPhase::Phase2, SUT->CurrentPhase));
+        ASSERT_THAT(AreEqual(3, SUT->DumbEnemies.Num()));
+        ASSERT_THAT(AreEqual(2, SUT->DeferredDumbSpawns));
+
+        SUT->DumbEnemies[0]->ReceiveDamage(SUT->DumbEnemies[0]->MaxHealth);
+        SUT->Tick(0.016f);
+        ASSERT_THAT(AreEqual(3, SUT->DumbEnemies.Num()));
+        ASSERT_THAT(AreEqual(1, SUT->DeferredDumbSpawns));
+        ASSERT_THAT(AreEqual(ESpawnerPhase::Phase2, SUT->CurrentPhase));
+    }
+
+    TEST_METHOD(FarEnemy_IsRecycledWithoutCountingAKill)
+    {
+        SUT->DispatchBeginPlay();
+        AFPSEnemyPatrol* First = SUT->CurrentSmartEnemy;
+        ASSERT_THAT(IsNotNull(First));
+
+        TArray<FVector> Viewers = { FVector(100000.f, 0.f, 0.f) };
+        ASSERT_THAT(AreEqual(0, Director->RecycleIrrelevantEnemies(Viewers, Director->RecycleAfterSeconds * 0.5f)));
+        ASSERT_THAT(AreEqual(1, Director->RecycleIrrelevantEnemies(Viewers, Director->RecycleAfterSeconds * 0.5f)));
+
+        ASSERT_THAT(IsTrue(First->IsInPool()));
+        ASSERT_THAT(AreEqual(0, SUT->SmartKillCount));
+        ASSERT_THAT(IsNotNull(SUT->CurrentSmartEnemy));
+        ASSERT_THAT(IsTrue(SUT->CurrentSmartEnemy != First));
+        ASSERT_THAT(AreEqual(1, Director->GetStats().Recycled));
+    }
+
+    TEST_METHOD(NearbyEnemy_IsNeverRecycled)
+    {
+        SUT->DispatchBeginPlay();
+        AFPSEnemyPatrol* First = SUT->CurrentSmartEnemy;
+        ASSERT_THAT(IsNotNull(First));
+
+        TArray<FVector> Viewers = { First->GetActorLocation() + FVector(100.f, 0.f, 0.f) };
+        for (int i = 0; i < 5; ++i)
+        {
+            ASSERT_THAT(AreEqual(0, Director->RecycleIrrelevantEnemies(Viewers, Director->RecycleAfterSeconds)));
+        }
+        ASSERT_THAT(IsFalse(First->IsInPool()));
+    }
+};
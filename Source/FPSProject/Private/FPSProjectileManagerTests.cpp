@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CQTest.h"
+#include "../FPSProjectileManager.h"
+#include "../FPSDamageQueue.h"
+#include "../FPSEnemyDumb.h"
+#include "Engine/World.h"
+
+TEST_CLASS(ProjectileManager_CQ, "Game.Unit.ProjectileManager")
+{
+    UWorld* TestWorld;
+    UFPSProjectileManager* Manager;
+
+    BEFORE_EACH()
+    {
+        TestWorld = UWorld::CreateWorld(EWorldType::Game, false, TEXT("ProjectileManagerWorld"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(TestWorld);
+        TestWorld->InitializeActorsForPlay(FURL());
+
+        Manager = TestWorld->GetSubsystem<UFPSProjectileManager>();
+        ASSERT_THAT(IsNotNull(Manager));
+        Manager->bRender = false;
+        Manager->bAsyncSweeps = false;
+        Manager->Speed = 1000.f;
+        Manager->Lifetime = 1.f;
+    }
+
+    AFTER_EACH()
+    {
+        if (TestWorld)
+        {
+            TestWorld->DestroyWorld(true);
+            TestWorld = nullptr;
+        }
+        Manager = nullptr;
+    }
+
+    TEST_METHOD(OpenSpace_BulletsAdvanceBySpeed)
+    {
+        ASSERT_THAT(IsTrue(Manager->Fire(FVector(0.f, 0.f, 1000.f), FVector(1.f, 0.f, 0.f), 5.f, nullptr)));
+
+        Manager->StepProjectiles(0.1f);
+
+        ASSERT_THAT(AreEqual(1, Manager->GetNumProjectiles()));
+        ASSERT_THAT(IsNear(100.f, Manager->GetProjectileLocation(0).X, 0.01f));
+    }
+
+    TEST_METHOD(Lifetime_ExpiresBulletsAndKeepsOrder)
+    {
+        Manager->Fire(FVector(0.f, 0.f, 1000.f), FVector(1.f, 0.f, 0.f), 5.f, nullptr);
+        Manager->StepProjectiles(0.6f);
+        Manager->Fire(FVector(0.f, 500.f, 1000.f), FVector(0.f, 1.f, 0.f), 5.f, nullptr);
+        Manager->StepProjectiles(0.6f);
+
+        ASSERT_THAT(AreEqual(1, Manager->GetNumProjectiles()));
+        ASSERT_THAT(IsNear(1100.f, Manager->GetProjectileLocation(0).Y, 0.01f));
+    }
+
+    TEST_METHOD(MaxProjectiles_RefusesExtraBullets)
+    {
+        Manager->MaxProjectiles = 2;
+
+        ASSERT_THAT(IsTrue(Manager->Fire(FVector::ZeroVector, FVector::ForwardVector, 1.f, nullptr)));
+        ASSERT_THAT(IsTrue(Manager->Fire(FVector::ZeroVector, FVector::ForwardVector, 1.f, nullptr)));
+        ASSERT_THAT(IsFalse(Manager->Fire(FVector::ZeroVector, FVector::ForwardVector, 1.f, nullptr)));
+    }
+
+    TEST_METHOD(EnemyHit_QueuesDamageAndRemovesBullet)
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        AFPSEnemyDumb* Enemy = TestWorld->SpawnActor<AFPSEnemyDumb>(AFPSEnemyDumb::StaticClass(), FVector(300.f, 0.f, 1000.f), FRotator::ZeroRotator, SpawnParams);
+        ASSERT_THAT(IsNotNull(Enemy));
+
+        UFPSDamageQueue* DamageQueue = TestWorld->GetSubsystem<UFPSDamageQueue>();
+        ASSERT_THAT(IsNotNull(DamageQueue));
+
+        Manager->Fire(FVector(0.f, 0.f, 1000.f), FVector(1.f, 0.f, 0.f), 7.f, nullptr);
+        Manager->StepProjectiles(0.5f);
+
+        ASSERT_THAT(AreEqual(0, Manager->GetNumProjectiles()));
+        ASSERT_THAT(AreEqual(1, DamageQueue->GetNumPending()));
+    }
+};
@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CQTest.h"
+#include "../FPSProjectile.h"
+#include "../FPSProjectilePool.h"
+#include "Engine/World.h"
+
+TEST_CLASS(ProjectilePool_CQ, "Game.Unit.ProjectilePool")
+{
+    UWorld* TestWorld;
+    UFPSProjectilePool* Pool;
+
+    BEFORE_EACH()
+    {
+        TestWorld = UWorld::CreateWorld(EWorldType::Game, false, TEXT("ProjectilePoolWorld"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(TestWorld);
+        TestWorld->InitializeActorsForPlay(FURL());
+
+        Pool = TestWorld->GetSubsystem<UFPSProjectilePool>();
+        ASSERT_THAT(IsNotNull(Pool));
+    }
+
+    AFTER_EACH()
+    {
+        if (TestWorld)
+        {
+            TestWorld->DestroyWorld(true);
+            TestWorld = nullptr;
+        }
+        Pool = nullptr;
+    }
+
+    TEST_METHOD(Prewarm_FillsPoolWithHiddenProjectiles)
+    {
+        Pool->Prewarm(AFPSProjectile::StaticClass(), 8);
+        ASSERT_THAT(AreEqual(8, Pool->GetNumFree(AFPSProjectile::StaticClass())));
+        ASSERT_THAT(AreEqual(0, Pool->GetStats().InUse));
+    }
+
+    TEST_METHOD(Acquire_ReusesPrewarmedProjectile)
+    {
+        Pool->Prewarm(AFPSProjectile::StaticClass(), 1);
+
+        AFPSProjectile* Projectile = Pool->Acquire(AFPSProjectile::StaticClass(), FVector(100.f, 0.f, 0.f), FRotator::ZeroRotator);
+        ASSERT_THAT(IsNotNull(Projectile));
+        ASSERT_THAT(IsFalse(Projectile->IsInPool()));
+        ASSERT_THAT(IsFalse(Projectile->IsHidden()));
+        ASSERT_THAT(AreEqual(1, Pool->GetStats().Reused));
+        ASSERT_THAT(AreEqual(0, Pool->GetStats().Spawned));
+        ASSERT_THAT(AreEqual(0, Pool->GetNumFree(AFPSProjectile::StaticClass())));
+    }
+
+    TEST_METHOD(Expire_ReturnsProjectileAndResetsMovement)
+    {
+        AFPSProjectile* Projectile = Pool->Acquire(AFPSProjectile::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator);
+        ASSERT_THAT(IsNotNull(Projectile));
+        Projectile->FireInDirection(FVector::ForwardVector);
+
+        Projectile->Expire();
+
+        ASSERT_THAT(IsTrue(IsValid(Projectile)));
+        ASSERT_THAT(IsTrue(Projectile->IsInPool()));
+        ASSERT_THAT(IsTrue(Projectile->ProjectileMovementComponent->Velocity.IsZero()));
+        ASSERT_THAT(IsFalse(Projectile->GetActorEnableCollision()));
+        ASSERT_THAT(AreEqual(1, Pool->GetNumFree(AFPSProjectile::StaticClass())));
+    }
+
+    TEST_METHOD(Release_Twice_DoesNotDuplicate)
+    {
+        AFPSProjectile* Projectile = Pool->Acquire(AFPSProjectile::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator);
+        Pool->Release(Projectile);
+        Pool->Release(Projectile);
+        ASSERT_THAT(AreEqual(1, Pool->GetNumFree(AFPSProjectile::StaticClass())));
+        ASSERT_THAT(AreEqual(0, Pool->GetStats().InUse));
+    }
+
+    TEST_METHOD(Stats_TrackHighWaterMarkAndHitRate)
+    {
+        Pool->Prewarm(AFPSProjectile::StaticClass(), 2);
+
+        TArray<AFPSProjectile*> Active;
+        for (int32 i = 0; i < 3; ++i)
+        {
+            Active.Add(Pool->Acquire(AFPSProjectile::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator));
+        }
+        for (AFPSProjectile* Projectile : Active)
+        {
+            Pool->Release(Projectile);
+        }
+
+        const FProjectilePoolStats Stats = Pool->GetStats();
+        ASSERT_THAT(AreEqual(3, Stats.HighWaterMark));
+        ASSERT_THAT(AreEqual(1, Stats.Spawned));
+        ASSERT_THAT(IsNear(2.0f / 3.0f, Stats.GetHitRate(), 0.001f));
+        ASSERT_THAT(AreEqual(3, Pool->GetNumFree(AFPSProjectile::StaticClass())));
+    }
+};
@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CQTest.h"
+#include "../FPSSpawnPointService.h"
+#include "../FPSEnemySpawnManager.h"
+#include "../FPSEnemyDumb.h"
+#include "../FPSEnemyPatrol.h"
+#include "Engine/World.h"
+
+TEST_CLASS(SpawnPointService_CQ, "Game.Unit.EnemySpawning.SpawnPointService")
+{
+    UWorld* TestWorld;
+    UFPSSpawnPointService* Service;
+
+    BEFORE_EACH()
+    {
+        TestWorld = UWorld::CreateWorld(EWorldType::Game, false, TEXT("SpawnPointServiceWorld"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(TestWorld);
+        TestWorld->InitializeActorsForPlay(FURL());
+
+        Service = TestWorld->GetSubsystem<UFPSSpawnPointService>();
+        ASSERT_THAT(IsNotNull(Service));
+    }
+
+    AFTER_EACH()
+    {
+        if (TestWorld)
+        {
+            TestWorld->DestroyWorld(true);
+            TestWorld = nullptr;
+        }
+        Service = nullptr;
+    }
+
+    TEST_METHOD(WithoutNavmesh_TryTakePointMissesAndCountsIt)
+    {
+        Service->RegisterReservoir(FVector::ZeroVector, 1000.f);
+        Service->FlushRefill();
+
+        FVector Point;
+        ASSERT_THAT(IsFalse(Service->TryTakePoint(FVector::ZeroVector, 1000.f, Point)));
+        ASSERT_THAT(AreEqual(0, Service->GetNumCachedPoints(FVector::ZeroVector, 1000.f)));
+        ASSERT_THAT(AreEqual(1, Service->ReservoirMisses));
+        ASSERT_THAT(AreEqual(0, Service->ReservoirHits));
+    }
+
+    TEST_METHOD(WithoutNavmesh_SpawnManagerFallsBackToDirectQuery)
+    {
+        AFPSEnemySpawnManager* Spawner = TestWorld->SpawnActor<AFPSEnemySpawnManager>(AFPSEnemySpawnManager::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator);
+        ASSERT_THAT(IsNotNull(Spawner));
+        Spawner->SmartEnemy = AFPSEnemyPatrol::StaticClass();
+        Spawner->DumbEnemy = AFPSEnemyDumb::StaticClass();
+        Spawner->SpawnRadius = 1000.f;
+
+        Spawner->DispatchBeginPlay();
+        ASSERT_THAT(IsNotNull(Spawner->CurrentSmartEnemy));
+        ASSERT_THAT(IsTrue(Service->ReservoirMisses > 0));
+    }
+};
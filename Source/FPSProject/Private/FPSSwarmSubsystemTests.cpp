@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CQTest.h"
+#include "../FPSSwarmSubsystem.h"
+#include "../FPSEnemySpawnManager.h"
+#include "../FPSEnemyDumb.h"
+#include "../FPSEnemyPatrol.h"
+#include "Engine/World.h"
+
+TEST_CLASS(Swarm_CQ, "Game.Unit.EnemySpawning.Swarm")
+{
+    UWorld* TestWorld;
+    UFPSSwarmSubsystem* Swarm;
+
+    BEFORE_EACH()
+    {
+        TestWorld = UWorld::CreateWorld(EWorldType::Game, false, TEXT("SwarmWorld"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(TestWorld);
+        TestWorld->InitializeActorsForPlay(FURL());
+
+        Swarm = TestWorld->GetSubsystem<UFPSSwarmSubsystem>();
+        ASSERT_THAT(IsNotNull(Swarm));
+        Swarm->Configure(AFPSEnemyDumb::StaticClass(), nullptr);
+    }
+
+    AFTER_EACH()
+    {
+        if (TestWorld)
+        {
+            TestWorld->DestroyWorld(true);
+            TestWorld = nullptr;
+        }
+        Swarm = nullptr;
+    }
+
+    TEST_METHOD(Chase_MovesFarAgentsTowardTargetWithoutActors)
+    {
+        const FVector Start(20000.f, 0.f, 0.f);
+        for (int i = 0; i < 1000; ++i)
+        {
+            Swarm->SpawnAgent(Start + FVector(0.f, i * 10.f, 0.f), nullptr);
+        }
+
+        Swarm->StepSwarm(FVector::ZeroVector, nullptr, 0.5f);
+
+        ASSERT_THAT(AreEqual(1000, Swarm->GetNumAgents()));
+        ASSERT_THAT(AreEqual(0, Swarm->GetNumMaterialized()));
+        ASSERT_THAT(IsTrue(Swarm->GetAgentLocation(0).X < Start.X));
+    }
+
+    TEST_METHOD(NearAgents_AreMaterializedUpToCap)
+    {
+        Swarm->MaxMaterializedActors = 3;
+        for (int i = 0; i < 5; ++i)
+        {
+            Swarm->SpawnAgent(FVector(300.f + i * 100.f, 0.f, 100.f), nullptr);
+        }
+
+        Swarm->StepSwarm(FVector::ZeroVector, nullptr, 0.0f);
+
+        ASSERT_THAT(AreEqual(3, Swarm->GetNumMaterialized()));
+        ASSERT_THAT(IsNotNull(Swarm->GetAgentActor(0)));
+        ASSERT_THAT(AreEqual(0, Swarm->GetAgentActor(0)->SwarmAgentIndex));
+    }
+
+    TEST_METHOD(MaterializedKill_RemovesAgentAndReachesSpawner)
+    {
+        AFPSEnemySpawnManager* Spawner = TestWorld->SpawnActor<AFPSEnemySpawnManager>(AFPSEnemySpawnManager::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator);
+        ASSERT_THAT(IsNotNull(Spawner));
+        Spawner->SmartEnemy = AFPSEnemyPatrol::StaticClass();
+        Spawner->DumbEnemy = AFPSEnemyDumb::StaticClass();
+        Spawner->bUseSwarmForDumbEnemies = true;
+        Spawner->DispatchBeginPlay();
+
+        Swarm->SpawnAgent(FVector(300.f, 0.f, 100.f), Spawner);
+        Swarm->SpawnAgent(FVector(30000.f, 0.f, 100.f), Spawner);
+        ASSERT_THAT(AreEqual(2, Spawner->GetNumDumbEnemies()));
+
+        Swarm->StepSwarm(FVector::ZeroVector, nullptr, 0.0f);
+        AFPSEnemyDumb* Actor = Swarm->GetAgentActor(0);
+        ASSERT_THAT(IsNotNull(Actor));
+
+        Actor->ReceiveDamage(Actor->MaxHealth);
+
+        ASSERT_THAT(AreEqual(1, Swarm->GetNumAgents()));
+        ASSERT_THAT(AreEqual(0, Swarm->GetNumMaterialized()));
+        ASSERT_THAT(AreEqual(1, Spawner->GetNumDumbEnemies()));
+        ASSERT_THAT(IsTrue(Actor->IsInPool()));
+        ASSERT_THAT(AreEqual(INDEX_NONE, Actor->SwarmAgentIndex));
+    }
+};
@@ -0,0 +1,152 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CQTest.h"
+#include "../FPSEnemySpawnManager.h"
+#include "../FPSWaveTimeline.h"
+#include "../FPSEnemyPatrol.h"
+#include "../FPSEnemyDumb.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+static FWaveSpawnEvent MakeWaveEvent(EWaveTriggerType Trigger, EWaveEnemyType Type, int32 Count, float Time = 0.0f, int32 KillCount = 0)
+{
+    FWaveSpawnEvent Event;
+    Event.Trigger = Trigger;
+    Event.EnemyType = Type;
+    Event.Count = Count;
+    Event.Time = Time;
+    Event.KillCount = KillCount;
+    return Event;
+}
+
+TEST_CLASS(WaveTimeline_CQ, "Game.Unit.EnemySpawning.WaveTimeline")
+{
+    UWorld* TestWorld;
+    AFPSEnemySpawnManager* SUT;
+    UFPSWaveTimeline* Timeline;
+
+    BEFORE_EACH()
+    {
+        FMath::RandInit(1337);
+
+        TestWorld = UWorld::CreateWorld(EWorldType::Game, false, TEXT("WaveTimelineWorld"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(TestWorld);
+        TestWorld->InitializeActorsForPlay(FURL());
+
+        SUT = TestWorld->SpawnActor<AFPSEnemySpawnManager>(AFPSEnemySpawnManager::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator);
+        ASSERT_THAT(IsNotNull(SUT));
+
+        SUT->SmartEnemy = AFPSEnemyPatrol::StaticClass();
+        SUT->DumbEnemy = AFPSEnemyDumb::StaticClass();
+        SUT->SpawnRadius = 1000.f;
+
+        Timeline = NewObject<UFPSWaveTimeline>(SUT);
+        SUT->WaveTimeline = Timeline;
+    }
+
+    AFTER_EACH()
+    {
+        if (TestWorld)
+        {
+            TestWorld->DestroyWorld(true);
+            TestWorld = nullptr;
+        }
+        SUT = nullptr;
+        Timeline = nullptr;
+    }
+
+    TEST_METHOD(TimeZeroEvents_FireOnBeginPlay_AndSpawnerStopsTicking)
+    {
+        Timeline->Events.Add(MakeWaveEvent(EWaveTriggerType::AtTime, EWaveEnemyType::Smart, 1));
+        Timeline->Events.Add(MakeWaveEvent(EWaveTriggerType::AtTime, EWaveEnemyType::Dumb, 3, 10.0f));
+
+        SUT->DispatchBeginPlay();
+
+        ASSERT_THAT(IsTrue(SUT->IsWaveTimelineRunning()));
+        ASSERT_THAT(IsFalse(SUT->IsActorTickEnabled()));
+        ASSERT_THAT(AreEqual(1, SUT->SmartEnemies.Num()));
+        ASSERT_THAT(AreEqual(0, SUT->DumbEnemies.Num()));
+        ASSERT_THAT(IsNotNull(SUT->CurrentSmartEnemy));
+    }
+
+    TEST_METHOD(KillCountTrigger_FiresWhenThresholdReached)
+    {
+        Timeline->Events.Add(MakeWaveEvent(EWaveTriggerType::AtTime, EWaveEnemyType::Smart, 2));
+        FWaveSpawnEvent Burst = MakeWaveEvent(EWaveTriggerType::OnKillCount, EWaveEnemyType::Dumb, 5, 0.0f, 2);
+        Burst.KillFilter = EWaveKillFilter::Smart;
+        Timeline->Events.Add(Burst);
+
+        SUT->DispatchBeginPlay();
+        ASSERT_THAT(AreEqual(2, SUT->SmartEnemies.Num()));
+
+        SUT->NotifySmartEnemyDeath(SUT->SmartEnemies[0]);
+        ASSERT_THAT(AreEqual(0, SUT->DumbEnemies.Num()));
+
+        SUT->NotifySmartEnemyDeath(SUT->SmartEnemies[0]);
+        ASSERT_THAT(AreEqual(5, SUT->DumbEnemies.Num()));
+        ASSERT_THAT(AreEqual(2, SUT->SmartKillCount));
+        ASSERT_THAT(IsNull(SUT->CurrentSmartEnemy));
+    }
+
+    TEST_METHOD(MaxAlive_CapsSpawnsPerEvent)
+    {
+        FWaveSpawnEvent Capped = MakeWaveEvent(EWaveTriggerType::AtTime, EWaveEnemyType::Dumb, 5);
+        Capped.MaxAlive = 2;
+        Timeline->Events.Add(Capped);
+
+        SUT->DispatchBeginPlay();
+        ASSERT_THAT(AreEqual(2, SUT->DumbEnemies.Num()));
+    }
+
+    TEST_METHOD(MaxAliveTotal_CapsWholeTimeline)
+    {
+        Timeline->MaxAliveTotal = 3;
+        Timeline->Events.Add(MakeWaveEvent(EWaveTriggerType::AtTime, EWaveEnemyType::Smart, 2));
+        Timeline->Events.Add(MakeWaveEvent(EWaveTriggerType::AtTime, EWaveEnemyType::Dumb, 5));
+
+        SUT->DispatchBeginPlay();
+        ASSERT_THAT(AreEqual(3, SUT->SmartEnemies.Num() + SUT->DumbEnemies.Num()));
+    }
+
+    TEST_METHOD(AllEnemiesDead_FiresOnlyAfterLastKill)
+    {
+        Timeline->Events.Add(MakeWaveEvent(EWaveTriggerType::AtTime, EWaveEnemyType::Dumb, 2));
+        Timeline->Events.Add(MakeWaveEvent(EWaveTriggerType::OnAllEnemiesDead, EWaveEnemyType::Smart, 1, 0.0f, 2));
+
+        SUT->DispatchBeginPlay();
+        ASSERT_THAT(AreEqual(2, SUT->DumbEnemies.Num()));
+
+        SUT->NotifyDumbEnemyDeath(SUT->DumbEnemies[0]);
+        ASSERT_THAT(AreEqual(0, SUT->SmartEnemies.Num()));
+
+        SUT->NotifyDumbEnemyDeath(SUT->DumbEnemies[0]);
+        ASSERT_THAT(AreEqual(1, SUT->SmartEnemies.Num()));
+        ASSERT_THAT(AreEqual(2, SUT->TotalKillCount));
+    }
+
+    TEST_METHOD(DelayedEvent_IsScheduledOnTimerNotTick)
+    {
+        Timeline->Events.Add(MakeWaveEvent(EWaveTriggerType::AtTime, EWaveEnemyType::Dumb, 3, 10.0f));
+
+        SUT->DispatchBeginPlay();
+        ASSERT_THAT(AreEqual(0, SUT->DumbEnemies.Num()));
+        ASSERT_THAT(IsTrue(SUT->GetWorldTimerManager().GetTimerRemaining(SUT->WaveEventTimers[0]) > 9.0f));
+    }
+
+    TEST_METHOD(RefusedSpawn_IsDeferredUntilASlotFrees)
+    {
+        SUT->MaxAliveDumbEnemies = 2;
+        Timeline->Events.Add(MakeWaveEvent(EWaveTriggerType::AtTime, EWaveEnemyType::Dumb, 3));
+
+        SUT->DispatchBeginPlay();
+        ASSERT_THAT(AreEqual(2, SUT->DumbEnemies.Num()));
+        ASSERT_THAT(AreEqual(1, SUT->DeferredDumbSpawns));
+        ASSERT_THAT(IsTrue(SUT->GetWorldTimerManager().IsTimerActive(SUT->DeferredSpawnHandle)));
+
+        SUT->NotifyDumbEnemyDeath(SUT->DumbEnemies[0]);
+        ASSERT_THAT(AreEqual(2, SUT->DumbEnemies.Num()));
+        ASSERT_THAT(AreEqual(0, SUT->DeferredDumbSpawns));
+        ASSERT_THAT(IsFalse(SUT->GetWorldTimerManager().IsTimerActive(SUT->DeferredSpawnHandle)));
+    }
+};
@@ -0,0 +1,139 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CQTest.h"
+#include "../FPSWeaponBase.h"
+#include "Engine/World.h"
+
+TEST_CLASS(WeaponFireScheduler_CQ, "Game.Unit.Weapon.FireScheduler")
+{
+    UWorld* TestWorld;
+
+    BEFORE_EACH()
+    {
+        TestWorld = UWorld::CreateWorld(EWorldType::Game, false, TEXT("FireSchedulerWorld"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(TestWorld);
+        TestWorld->InitializeActorsForPlay(FURL());
+    }
+
+    AFTER_EACH()
+    {
+        if (TestWorld)
+        {
+            TestWorld->DestroyWorld(true);
+            TestWorld = nullptr;
+        }
+    }
+
+    AFPSWeaponBase* SpawnAutoWeapon(float FireRate, int32 Bullets)
+    {
+        AFPSWeaponBase* Weapon = TestWorld->SpawnActor<AFPSWeaponBase>(AFPSWeaponBase::StaticClass(), FTransform::Identity);
+        Weapon->FireMode = EWeaponFireMode::FullAuto;
+        Weapon->FireRate = FireRate;
+        Weapon->MagazineSize = Bullets;
+        Weapon->BulletsInMag = Bullets;
+        Weapon->Magazines = 0;
+        return Weapon;
+    }
+
+    // UpdateFiring ignores the time of the frame the trigger was pulled in
+    void NextFrame()
+    {
+        GFrameCounter++;
+    }
+
+    TEST_METHOD(LongFrame_EmitsEveryShotDueWithItsOwnTime)
+    {
+        AFPSWeaponBase* Weapon = SpawnAutoWeapon(8.f, 100);
+        ASSERT_THAT(IsNotNull(Weapon));
+
+        Weapon->StartFiring();
+        ASSERT_THAT(AreEqual(99, Weapon->BulletsInMag));
+        NextFrame();
+
+        // Shots fall due at 0.125, 0.25 and 0.375 after the first
+        ASSERT_THAT(AreEqual(3, Weapon->UpdateFiring(0.4375f)));
+        ASSERT_THAT(AreEqual(96, Weapon->BulletsInMag));
+
+        const TArray<float>& Times = Weapon->GetLastShotTimes();
+        ASSERT_THAT(IsTrue(FMath::IsNearlyEqual(0.125f, Times[0], 0.001f)));
+        ASSERT_THAT(IsTrue(FMath::IsNearlyEqual(0.25f, Times[1], 0.001f)));
+        ASSERT_THAT(IsTrue(FMath::IsNearlyEqual(0.375f, Times[2], 0.001f)));
+    }
+
+    TEST_METHOD(Cadence_IsIndependentOfFrameRate)
+    {
+        AFPSWeaponBase* Fast = SpawnAutoWeapon(8.f, 100);
+        AFPSWeaponBase* Slow = SpawnAutoWeapon(8.f, 100);
+        ASSERT_THAT(IsNotNull(Fast));
+        ASSERT_THAT(IsNotNull(Slow));
+
+        Fast->StartFiring();
+        Slow->StartFiring();
+        NextFrame();
+        for (int32 i = 0; i < 64; i++)
+        {
+            Fast->UpdateFiring(1.f / 64.f);
+        }
+        for (int32 i = 0; i < 4; i++)
+        {
+            Slow->UpdateFiring(0.25f);
+        }
+
+        ASSERT_THAT(AreEqual(100 - 9, Fast->BulletsInMag));
+        ASSERT_THAT(AreEqual(Fast->BulletsInMag, Slow->BulletsInMag));
+    }
+
+    TEST_METHOD(ReleasedTrigger_StopsFiringAndBanksNoTime)
+    {
+        AFPSWeaponBase* Weapon = SpawnAutoWeapon(8.f, 100);
+        ASSERT_THAT(IsNotNull(Weapon));
+
+        Weapon->StartFiring();
+        Weapon->StopFiring();
+        NextFrame();
+        ASSERT_THAT(AreEqual(0, Weapon->UpdateFiring(1.f)));
+        ASSERT_THAT(IsFalse(Weapon->IsActorTickEnabled()));
+
+        Weapon->StartFiring();
+        NextFrame();
+        ASSERT_THAT(AreEqual(0, Weapon->UpdateFiring(0.0625f)));
+        ASSERT_THAT(AreEqual(98, Weapon->BulletsInMag));
+    }
+
+    TEST_METHOD(SemiAuto_FiresOncePerPull)
+    {
+        AFPSWeaponBase* Weapon = SpawnAutoWeapon(8.f, 100);
+        ASSERT_THAT(IsNotNull(Weapon));
+        Weapon->FireMode = EWeaponFireMode::SemiAuto;
+
+        Weapon->StartFiring();
+        ASSERT_THAT(AreEqual(0, Weapon->UpdateFiring(1.f)));
+        ASSERT_THAT(AreEqual(99, Weapon->BulletsInMag));
+    }
+
+    TEST_METHOD(EmptyMagazine_StopsTheBatch)
+    {
+        AFPSWeaponBase* Weapon = SpawnAutoWeapon(8.f, 3);
+        ASSERT_THAT(IsNotNull(Weapon));
+
+        Weapon->StartFiring();
+        NextFrame();
+        ASSERT_THAT(AreEqual(2, Weapon->UpdateFiring(1.f)));
+        ASSERT_THAT(AreEqual(0, Weapon->BulletsInMag));
+    }
+
+    TEST_METHOD(SameFrameTick_DoesNotCountTimeBeforeThePull)
+    {
+        AFPSWeaponBase* Weapon = SpawnAutoWeapon(8.f, 100);
+        ASSERT_THAT(IsNotNull(Weapon));
+
+        // The weapon ticks after the input that pulled the trigger, with a delta from before the pull
+        Weapon->StartFiring();
+        ASSERT_THAT(AreEqual(0, Weapon->UpdateFiring(0.1f)));
+
+        NextFrame();
+        ASSERT_THAT(AreEqual(0, Weapon->UpdateFiring(0.1f)));
+        ASSERT_THAT(AreEqual(1, Weapon->UpdateFiring(0.03f)));
+    }
+};
@@ -0,0 +1,177 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CQTest.h"
+#include "../FPSWorldReset.h"
+#include "../FPSCharacter.h"
+#include "../FPSEnemyDumb.h"
+#include "../FPSEnemyPatrol.h"
+#include "../FPSEnemySpawnManager.h"
+#include "../FPSWaveTimeline.h"
+#include "../FPSDamageQueue.h"
+#include "../FPSHitscanSubsystem.h"
+#include "../FPSProjectilePool.h"
+#include "../FPSProjectile.h"
+#include "../CollectiblePickup.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+TEST_CLASS(WorldReset_CQ, "Game.Unit.WorldReset")
+{
+    UWorld* TestWorld;
+    UFPSWorldReset* SUT;
+    AFPSCharacter* Player;
+
+    BEFORE_EACH()
+    {
+        TestWorld = UWorld::CreateWorld(EWorldType::Game, false, TEXT("WorldResetWorld"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(TestWorld);
+        TestWorld->InitializeActorsForPlay(FURL());
+
+        SUT = TestWorld->GetSubsystem<UFPSWorldReset>();
+        ASSERT_THAT(IsNotNull(SUT));
+
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        Player = TestWorld->SpawnActor<AFPSCharacter>(AFPSCharacter::StaticClass(), FVector(0.0f, 0.0f, 100.0f), FRotator::ZeroRotator, SpawnParams);
+        ASSERT_THAT(IsNotNull(Player));
+    }
+
+    AFTER_EACH()
+    {
+        if (TestWorld)
+        {
+            TestWorld->DestroyWorld(true);
+            TestWorld = nullptr;
+        }
+        SUT = nullptr;
+        Player = nullptr;
+    }
+
+    TEST_METHOD(BeforeBeginPlay_ResetFails)
+    {
+        ASSERT_THAT(IsFalse(SUT->ResetWorld()));
+        ASSERT_THAT(AreEqual(0, SUT->GetNumResets()));
+    }
+
+    TEST_METHOD(CollectedPlacedPickup_IsHiddenThenRestored)
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        ACollectiblePickup* Ruby = TestWorld->SpawnActor<ACollectiblePickup>(ACollectiblePickup::StaticClass(), FVector(500.0f, 0.0f, 50.0f), FRotator::ZeroRotator, SpawnParams);
+        ASSERT_THAT(IsNotNull(Ruby));
+        Ruby->CollectibleType = ECollectibleType::RedRuby;
+
+        TestWorld->BeginPlay();
+
+        Ruby->HandleOverlap(nullptr, Player, nullptr, 0, false, FHitResult());
+        ASSERT_THAT(IsTrue(IsValid(Ruby)));
+        ASSERT_THAT(IsTrue(Ruby->IsCollected()));
+        ASSERT_THAT(AreEqual(1, Player->RedRubyCount));
+
+        ASSERT_THAT(IsTrue(SUT->ResetWorld()));
+        ASSERT_THAT(IsFalse(Ruby->IsCollected()));
+        ASSERT_THAT(IsFalse(Ruby->IsHidden()));
+        ASSERT_THAT(AreEqual(0, Player->RedRubyCount));
+    }
+
+    TEST_METHOD(Death_RequestsResetInsteadOfOpeningLevel)
+    {
+        TestWorld->BeginPlay();
+
+        Player->SetActorLocation(FVector(2000.0f, 0.0f, 100.0f));
+        Player->ApplyDamage(Player->MaxHealth + 1.0f);
+        ASSERT_THAT(IsTrue(Player->bIsDead));
+        ASSERT_THAT(IsTrue(SUT->IsResetPending()));
+
+        TestWorld->GetTimerManager().Tick(0.01f);
+
+        ASSERT_THAT(IsFalse(SUT->IsResetPending()));
+        ASSERT_THAT(AreEqual(1, SUT->GetNumResets()));
+        ASSERT_THAT(IsFalse(Player->bIsDead));
+        ASSERT_THAT(IsTrue(FMath::IsNearlyEqual(Player->MaxHealth, Player->GetCurrentHealth())));
+        ASSERT_THAT(IsTrue(FVector::Dist2D(FVector::ZeroVector, Player->GetActorLocation()) < 1.0f));
+    }
+
+    TEST_METHOD(KilledPlacedEnemy_IsParkedThenRestored)
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        const FVector PlacedAt(800.0f, 300.0f, 100.0f);
+        AFPSEnemyDumb* Enemy = TestWorld->SpawnActor<AFPSEnemyDumb>(AFPSEnemyDumb::StaticClass(), PlacedAt, FRotator::ZeroRotator, SpawnParams);
+        ASSERT_THAT(IsNotNull(Enemy));
+
+        TestWorld->BeginPlay();
+
+        Enemy->CurrentHealth = Enemy->MaxHealth;
+        Enemy->ReceiveDamage(Enemy->MaxHealth + 1.0f);
+        ASSERT_THAT(IsTrue(IsValid(Enemy)));
+        ASSERT_THAT(IsTrue(Enemy->IsInPool()));
+
+        ASSERT_THAT(IsTrue(SUT->ResetWorld()));
+        ASSERT_THAT(IsFalse(Enemy->IsInPool()));
+        ASSERT_THAT(IsTrue(FMath::IsNearlyEqual(Enemy->MaxHealth, Enemy->CurrentHealth)));
+        ASSERT_THAT(IsTrue(FVector::Dist2D(PlacedAt, Enemy->GetActorLocation()) < 1.0f));
+    }
+
+    TEST_METHOD(DamageAndShotsQueuedBeforeReset_NeverLand)
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        AFPSEnemyDumb* Enemy = TestWorld->SpawnActor<AFPSEnemyDumb>(AFPSEnemyDumb::StaticClass(), FVector(800.0f, 0.0f, 100.0f), FRotator::ZeroRotator, SpawnParams);
+        ASSERT_THAT(IsNotNull(Enemy));
+
+        TestWorld->BeginPlay();
+        Enemy->CurrentHealth = Enemy->MaxHealth;
+
+        UFPSDamageQueue* DamageQueue = TestWorld->GetSubsystem<UFPSDamageQueue>();
+        UFPSHitscanSubsystem* Hitscan = TestWorld->GetSubsystem<UFPSHitscanSubsystem>();
+        UFPSProjectilePool* Pool = TestWorld->GetSubsystem<UFPSProjectilePool>();
+        ASSERT_THAT(IsNotNull(DamageQueue));
+        ASSERT_THAT(IsNotNull(Hitscan));
+        ASSERT_THAT(IsNotNull(Pool));
+
+        AFPSProjectile* Projectile = Pool->Acquire(AFPSProjectile::StaticClass(), FVector(0.0f, 0.0f, 100.0f), FRotator::ZeroRotator, Player);
+        ASSERT_THAT(IsNotNull(Projectile));
+        DamageQueue->QueueDamage(Enemy, Enemy->MaxHealth * 0.5f);
+        Hitscan->QueueTrace(FVector(0.0f, 0.0f, 100.0f), Enemy->GetActorLocation(), Enemy->MaxHealth * 0.5f, Player);
+
+        ASSERT_THAT(IsTrue(SUT->ResetWorld()));
+        ASSERT_THAT(AreEqual(0, DamageQueue->GetNumPending()));
+        ASSERT_THAT(AreEqual(0, Hitscan->GetNumQueued()));
+        ASSERT_THAT(IsTrue(Projectile->IsInPool()));
+        ASSERT_THAT(AreEqual(0, Pool->GetStats().InUse));
+
+        Hitscan->ResolveTraces();
+        DamageQueue->Flush();
+        ASSERT_THAT(IsTrue(FMath::IsNearlyEqual(Enemy->MaxHealth, Enemy->CurrentHealth)));
+        ASSERT_THAT(IsFalse(Enemy->IsInPool()));
+    }
+
+    TEST_METHOD(Spawner_ReleasesItsEnemiesAndStartsOver)
+    {
+        AFPSEnemySpawnManager* Spawner = TestWorld->SpawnActor<AFPSEnemySpawnManager>(AFPSEnemySpawnManager::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator);
+        ASSERT_THAT(IsNotNull(Spawner));
+        Spawner->SmartEnemy = AFPSEnemyPatrol::StaticClass();
+        Spawner->DumbEnemy = AFPSEnemyDumb::StaticClass();
+
+        UFPSWaveTimeline* Timeline = NewObject<UFPSWaveTimeline>(Spawner);
+        FWaveSpawnEvent Event;
+        Event.EnemyType = EWaveEnemyType::Dumb;
+        Event.Count = 2;
+        Timeline->Events.Add(Event);
+        Spawner->WaveTimeline = Timeline;
+
+        TestWorld->BeginPlay();
+        Spawner->DispatchBeginPlay();
+        ASSERT_THAT(AreEqual(2, Spawner->DumbEnemies.Num()));
+
+        Spawner->DumbEnemies[0]->OnDeath();
+        ASSERT_THAT(AreEqual(1, Spawner->TotalKillCount));
+
+        ASSERT_THAT(IsTrue(SUT->ResetWorld()));
+        ASSERT_THAT(AreEqual(0, Spawner->TotalKillCount));
+        ASSERT_THAT(AreEqual(2, Spawner->DumbEnemies.Num()));
+        ASSERT_THAT(IsTrue(Spawner->IsWaveTimelineRunning()));
+    }
+};
@@ -9,6 +9,16 @@
 #include "Misc/CommandLine.h"
 #include "Misc/Parse.h" 
 #include "Misc/Paths.h"
+#include "../FPSProjectile.h"
+#include "../FPSProjectilePool.h"
+#include "../FPSEnemySignificance.h"
+#include "../FPSEnemyDumb.h"
+#include "../FPSSwarmSubsystem.h"
+#include "../FPSProjectileManager.h"
+#include "../FPSPickupField.h"
+#include "../PickupBase.h"
+#include "../FPSHUD.h"
+#include "GameFramework/PlayerController.h"
 
 // Sets default values
 APerformanceTestManager::APerformanceTestManager()
@@ -80,6 +90,12 @@ void APerformanceTestManager::StartTest(const FPerformanceTestConfig& Config) {
 	CleanupActors();
 
 	FPSSamples.Empty();
+	bUsePickupField = Config.bPickupField;
+
+	if (AFPSHUD* HUD = GetPlayerHUD()) {
+		HUD->bRetainedHUD = !Config.bLegacyHUD;
+		HUD->ResetDrawStats();
+	}
 
 	switch (Config.TestType) {
 	case EPerformanceTestType::Load:
@@ -96,6 +112,9 @@ void APerformanceTestManager::StartTest(const FPerformanceTestConfig& Config) {
 		break;
 	}
 
+	SpawnSwarmEnemies(Config.NumSwarmEnemies);
+	StartProjectileStorm(Config);
+
 	GetWorld()->GetTimerManager().SetTimer(LoggingTimerHandle, this, &APerformanceTestManager::LogPerformance, LoggingInterval, true);
 }
 
@@ -195,6 +214,7 @@ void APerformanceTestManager::RepeatedSpikeTick() {
 	}
 	else {
 		GetWorld()->GetTimerManager().ClearTimer(SpawnTimerHandle);
+		GetWorld()->GetTimerManager().ClearTimer(StormTimerHandle);
 	}
 }
 
@@ -206,6 +226,7 @@ void APerformanceTestManager::StressRampTick() {
 	}
 	else {
 		GetWorld()->GetTimerManager().ClearTimer(SpawnTimerHandle);
+		GetWorld()->GetTimerManager().ClearTimer(StormTimerHandle);
 	}
 }
 
@@ -213,6 +234,7 @@ void APerformanceTestManager::EndTest() {
 	bTestRunning = false;
 	GetWorld()->GetTimerManager().ClearTimer(LoggingTimerHandle);
 	GetWorld()->GetTimerManager().ClearTimer(SpawnTimerHandle);
+	GetWorld()->GetTimerManager().ClearTimer(StormTimerHandle);
 
 	LogPerformance();
 	ExportResults();
@@ -249,6 +271,8 @@ void APerformanceTestManager::SpawnPickups(int32 Num) {
 
 	for (int32 i = 0; i < Num; ++i) {
 		FVector SpawnLoc = GetRandomSpawnLocation();
+		if (AddFieldPickup(PickupClass, SpawnLoc)) continue;
+
 		AActor* NewPickup = GetWorld()->SpawnActor<AActor>(PickupClass, SpawnLoc, FRotator::ZeroRotator);
 		if (NewPickup) {
 			SpawnedPickups.Add(NewPickup);
@@ -261,6 +285,8 @@ void APerformanceTestManager::SpawnCollectibles(int32 Num) {
 
 	for (int32 i = 0; i < Num; ++i) {
 		FVector SpawnLoc = GetRandomSpawnLocation();
+		if (AddFieldPickup(CollectibleClass, SpawnLoc)) continue;
+
 		AActor* NewCollectible = GetWorld()->SpawnActor<AActor>(CollectibleClass, SpawnLoc, FRotator::ZeroRotator);
 		if (NewCollectible) {
 			SpawnedCollectibles.Add(NewCollectible);
@@ -268,11 +294,35 @@ void APerformanceTestManager::SpawnCollectibles(int32 Num) {
 	}
 }
 
+AFPSHUD* APerformanceTestManager::GetPlayerHUD() const {
+	const APlayerController* PC = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr;
+	return PC ? Cast<AFPSHUD>(PC->GetHUD()) : nullptr;
+}
+
+bool APerformanceTestManager::AddFieldPickup(TSubclassOf<AActor> ActorClass, const FVector& Location) {
+	if (!bUsePickupField || !ActorClass->IsChildOf(APickupBase::StaticClass())) return false;
+
+	UFPSPickupField* Field = GetWorld()->GetSubsystem<UFPSPickupField>();
+	return Field && Field->AddPickup(TSubclassOf<APickupBase>(ActorClass.Get()), Location);
+}
+
 void APerformanceTestManager::SpawnProjectiles(int32 Num) {
 	if (!ProjectileClass) return;
 
+	UFPSProjectilePool* Pool = GetWorld()->GetSubsystem<UFPSProjectilePool>();
+	const bool bUsePool = Pool && ProjectileClass->IsChildOf(AFPSProjectile::StaticClass());
+
 	for (int32 i = 0; i < Num; ++i) {
 		FVector SpawnLoc = GetRandomSpawnLocation();
+		if (bUsePool) {
+			TSubclassOf<AFPSProjectile> PooledClass(ProjectileClass.Get());
+			if (AFPSProjectile* Projectile = Pool->Acquire(PooledClass, SpawnLoc, FRotator::ZeroRotator, this)) {
+				Projectile->FireInDirection(FVector::ForwardVector);
+				SpawnedProjectiles.Add(Projectile);
+			}
+			continue;
+		}
+
 		AActor* NewProjectile = GetWorld()->SpawnActor<AActor>(ProjectileClass, SpawnLoc, FRotator::ZeroRotator);
 		if (NewProjectile) {
 			SpawnedProjectiles.Add(NewProjectile);
@@ -280,6 +330,41 @@ void APerformanceTestManager::SpawnProjectiles(int32 Num) {
 	}
 }
 
+void APerformanceTestManager::SpawnSwarmEnemies(int32 Num) {
+	UFPSSwarmSubsystem* Swarm = GetWorld()->GetSubsystem<UFPSSwarmSubsystem>();
+	if (Num <= 0 || !Swarm || !EnemyClass || !EnemyClass->IsChildOf(AFPSEnemyDumb::StaticClass())) return;
+
+	Swarm->Configure(TSubclassOf<AFPSEnemyDumb>(EnemyClass.Get()), SwarmProxyMesh);
+	for (int32 i = 0; i < Num; i++) {
+		Swarm->SpawnAgent(GetRandomSpawnLocation(), nullptr);
+	}
+}
+
+void APerformanceTestManager::StartProjectileStorm(const FPerformanceTestConfig& Config) {
+	UFPSProjectileManager* ProjectileManager = GetWorld()->GetSubsystem<UFPSProjectileManager>();
+	if (Config.StormProjectilesPerSecond <= 0 || !ProjectileManager) return;
+
+	if (ProjectileClass && ProjectileClass->IsChildOf(AFPSProjectile::StaticClass())) {
+		ProjectileManager->ConfigureFromClass(TSubclassOf<AFPSProjectile>(ProjectileClass.Get()));
+	}
+	ProjectileManager->bAsyncSweeps = Config.bStormAsyncSweeps;
+
+	StormProjectilesPerSecond = Config.StormProjectilesPerSecond;
+	GetWorld()->GetTimerManager().SetTimer(StormTimerHandle, this, &APerformanceTestManager::ProjectileStormTick, StormInterval, true);
+}
+
+void APerformanceTestManager::ProjectileStormTick() {
+	UFPSProjectileManager* ProjectileManager = GetWorld()->GetSubsystem<UFPSProjectileManager>();
+	if (!ProjectileManager) return;
+
+	// Fired outward and slightly up so most bullets live out their lifetime, which keeps the in-flight count high
+	const int32 Num = FMath::Max(1, FMath::RoundToInt(StormProjectilesPerSecond * StormInterval));
+	for (int32 i = 0; i < Num; i++) {
+		const FVector Direction = FVector(FMath::VRand().GetSafeNormal2D(), FMath::FRandRange(0.0f, 0.3f)).GetSafeNormal();
+		ProjectileManager->Fire(GetRandomSpawnLocation(), Direction, 1.0f, this);
+	}
+}
+
 FVector APerformanceTestManager::GetRandomSpawnLocation() const {
 	FVector Origin = GetActorLocation();
 
@@ -298,6 +383,34 @@ void APerformanceTestManager::LogPerformance() {
 	FString LogMsg = FString::Printf(TEXT("Time: %.1f | FPS: %.1f | Enemies: %d | Pickups: %d | Projectiles: %d | Collectibles: %d"),
 		TimeElapsed, FPS, SpawnedEnemies.Num(), SpawnedPickups.Num(), SpawnedProjectiles.Num(), SpawnedCollectibles.Num());
 
+	if (const UFPSSwarmSubsystem* Swarm = GetWorld()->GetSubsystem<UFPSSwarmSubsystem>()) {
+		if (Swarm->GetNumAgents() > 0) {
+			LogMsg += FString::Printf(TEXT(" | Swarm: %d (%d actors)"), Swarm->GetNumAgents(), Swarm->GetNumMaterialized());
+		}
+	}
+
+	if (const UFPSProjectileManager* ProjectileManager = GetWorld()->GetSubsystem<UFPSProjectileManager>()) {
+		if (ProjectileManager->GetNumProjectiles() > 0) {
+			LogMsg += FString::Printf(TEXT(" | Batched projectiles: %d"), ProjectileManager->GetNumProjectiles());
+		}
+	}
+
+	if (const UFPSPickupField* Field = GetWorld()->GetSubsystem<UFPSPickupField>()) {
+		if (Field->GetNumPickups() > 0) {
+			LogMsg += FString::Printf(TEXT(" | Field pickups: %d"), Field->GetNumPickups());
+		}
+	}
+
+	if (const AFPSHUD* HUD = GetPlayerHUD()) {
+		LogMsg += FString::Printf(TEXT(" | HUD: %.3f ms (%s)"), HUD->GetAverageDrawMs(), HUD->bRetainedHUD ? TEXT("retained") : TEXT("legacy"));
+	}
+
+	if (const UFPSEnemySignificance* Significance = GetWorld()->GetSubsystem<UFPSEnemySignificance>()) {
+		LogMsg += FString::Printf(TEXT(" | Tick LOD C/H/M/L: %d/%d/%d/%d"),
+			Significance->GetBucketCount(EEnemySignificance::Critical), Significance->GetBucketCount(EEnemySignificance::High),
+			Significance->GetBucketCount(EEnemySignificance::Medium), Significance->GetBucketCount(EEnemySignificance::Low));
+	}
+
 	UE_LOG(LogTemp, Log, TEXT("%s"), *LogMsg);
 }
 
@@ -315,10 +428,28 @@ void APerformanceTestManager::CleanupActors() {
 			Collectible->Destroy();
 	}
 	for (AActor* Projectile : SpawnedProjectiles) {
-		if (Projectile && IsValid(Projectile))
+		if (!Projectile || !IsValid(Projectile))
+			continue;
+
+		// Pooled projectiles go back to the pool if still in flight instead of being destroyed
+		if (AFPSProjectile* Pooled = Cast<AFPSProjectile>(Projectile))
+			Pooled->Expire();
+		else
 			Projectile->Destroy();
 	}
 
+	if (UFPSSwarmSubsystem* Swarm = GetWorld() ? GetWorld()->GetSubsystem<UFPSSwarmSubsystem>() : nullptr) {
+		Swarm->RemoveAllAgents();
+	}
+
+	if (UFPSProjectileManager* ProjectileManager = GetWorld() ? GetWorld()->GetSubsystem<UFPSProjectileManager>() : nullptr) {
+		ProjectileManager->RemoveAll();
+	}
+
+	if (UFPSPickupField* Field = GetWorld() ? GetWorld()->GetSubsystem<UFPSPickupField>() : nullptr) {
+		Field->RemoveAll();
+	}
+
 	SpawnedEnemies.Empty();
 	SpawnedPickups.Empty();
 	SpawnedCollectibles.Empty();
@@ -327,6 +458,7 @@ void APerformanceTestManager::CleanupActors() {
 	if (GetWorld()) {
 		GetWorld()->GetTimerManager().ClearTimer(LoggingTimerHandle);
 		GetWorld()->GetTimerManager().ClearTimer(SpawnTimerHandle);
+		GetWorld()->GetTimerManager().ClearTimer(StormTimerHandle);
 	}
 }
 
@@ -345,11 +477,12 @@ void APerformanceTestManager::ExportResults() {
 	FString CSVPath = CurrentCSVPath;
 	if (!FPaths::FileExists(CSVPath)) {
 		FString ConfigLine = FString::Printf(TEXT("#Tests: %d\n"), TestSuite.Num());
-		FString CSVHeader = TEXT("Test,MinFPS,MaxFPS,AvgFPS,SampleCount\n");
+		FString CSVHeader = TEXT("Test,MinFPS,MaxFPS,AvgFPS,SampleCount,AvgHUDMs\n");
 		FFileHelper::SaveStringToFile(ConfigLine + CSVHeader, *CSVPath);
 	}
-	FString Row = FString::Printf(TEXT("%s,%.2f,%.2f,%.2f,%d\n"),
-		*TestSuite[CurrentTestIndex].Name, MinFPS, MaxFPS, AvgFPS, FPSSamples.Num());
+	const AFPSHUD* HUD = GetPlayerHUD();
+	FString Row = FString::Printf(TEXT("%s,%.2f,%.2f,%.2f,%d,%.4f\n"),
+		*TestSuite[CurrentTestIndex].Name, MinFPS, MaxFPS, AvgFPS, FPSSamples.Num(), HUD ? HUD->GetAverageDrawMs() : 0.0);
 
 	FFileHelper::SaveStringToFile(Row, *CSVPath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
 }
\ No newline at end of file
@@ -49,15 +49,34 @@ struct FPerformanceTestConfig {
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	int32 NumEnemies = 10;
 
+	// Dumb enemies run as swarm agents on top of the test's regular enemies. Needs EnemyClass to be a dumb enemy.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 NumSwarmEnemies = 0;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	int32 NumPickups = 10;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	int32 NumCollectibles = 10;
 
+	// Pickups and collectibles become UFPSPickupField records instead of actors
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bPickupField = false;
+
+	// Re-formats every HUD text each frame like the old HUD. Run a test with and without it to compare HUD cost.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bLegacyHUD = false;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	int32 NumProjectiles = 10;
 
+	// Projectile storm: bullets per second fired through UFPSProjectileManager for the whole test
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 StormProjectilesPerSecond = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bStormAsyncSweeps = false;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (EditCondition = "TestType == EPerformanceTestType::Spike"))
 	int32 SpikeSize = 10;
 
@@ -105,6 +124,9 @@ public:
 	UPROPERTY(EditAnywhere, Category = "PerformanceTest")
 	TSubclassOf<AActor> CollectibleClass;
 
+	UPROPERTY(EditAnywhere, Category = "PerformanceTest")
+	class UStaticMesh* SwarmProxyMesh = nullptr;
+
 	UPROPERTY(EditAnywhere, Category = "PerformanceTest")
 	float SpawnRadius = 500.0f;
 
@@ -138,12 +160,17 @@ public:
 	void LeakSpawnTick();
 	void RepeatedSpikeTick();
 	void StressRampTick();
+	void ProjectileStormTick();
 
 	void SpawnEnemies(int32 Num);
 	void RemoveEnemies(int32 Num);
 	void SpawnPickups(int32 Num);
 	void SpawnCollectibles(int32 Num);
+	bool AddFieldPickup(TSubclassOf<AActor> ActorClass, const FVector& Location);
+	class AFPSHUD* GetPlayerHUD() const;
 	void SpawnProjectiles(int32 Num);
+	void SpawnSwarmEnemies(int32 Num);
+	void StartProjectileStorm(const FPerformanceTestConfig& Config);
 
 	FVector GetRandomSpawnLocation() const;
 	void LogPerformance();
@@ -161,6 +188,10 @@ private:
 	bool bIncrementalPeakHold = false;
 	int32 StressEnemiesSpawned;
 	FTimerHandle PeakHoldTimerHandle;
+	FTimerHandle StormTimerHandle;
+	int32 StormProjectilesPerSecond = 0;
+	float StormInterval = 0.05f;
+	bool bUsePickupField = false;
 	float HoldDuration;
 	int32 StressSpawnBatchSize = 10;
 
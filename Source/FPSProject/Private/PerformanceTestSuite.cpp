@@ -61,6 +61,11 @@ struct FWaitForPerformanceTestSuiteCompletion : public IAutomationLatentCommand
 						else {
 							Test->AddInfo(FString::Printf(TEXT("Test: %s passed: AvgFPS %.2f >= Minimum %.2f"), *TestName, AvgFPS, MIN_EXPECTED_FPS));
 						}
+
+						// Compare tests run with and without bLegacyHUD to see what the retained HUD saves
+						if (Columns.Num() > 5) {
+							Test->AddInfo(FString::Printf(TEXT("Test: %s HUD draw %.4f ms"), *TestName, FCString::Atof(*Columns[5])));
+						}
 					}
 					if (bAllPassed) {
 						Test->AddInfo(TEXT("All performance tests passed"));
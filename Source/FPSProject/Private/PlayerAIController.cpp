@@ -9,6 +9,7 @@
 #include "Components/CapsuleComponent.h"
 #include "CollisionQueryParams.h"
 #include "../FPSCharacter.h"
+#include "../FPSPathBroker.h"
 #include "DrawDebugHelpers.h"
 #include <FPSProject/FPSEnemyBase.h>
 
@@ -25,6 +26,7 @@ void APlayerAIController::OnPossess(APawn* InPawn)
     if (ControlledCharacter)
     {
         ControlledCharacter->CurrentHealth = ControlledCharacter->MaxHealth;
+        ControlledCharacter->OnHealthChanged.Broadcast(ControlledCharacter);
         ControlledCharacter->bIsDead = false;
 
         LastKnownNavMeshPosition = ControlledCharacter->GetActorLocation();
@@ -76,6 +78,10 @@ void APlayerAIController::ClearTarget()
     CurrentIntent = ENavigationIntent::Idle;
     CurrentManeuver.Reset();
     PathPoints.Empty();
+    if (UFPSPathBroker* Broker = GetWorld()->GetSubsystem<UFPSPathBroker>())
+    {
+        Broker->CancelRequest(ControlledCharacter);
+    }
     LogState(TEXT("Target cleared"), FColor::Yellow);
 }
 
@@ -149,25 +155,27 @@ void APlayerAIController::UpdatePath()
 {
     if (!ControlledCharacter || !bHasTarget) return;
 
-    UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld());
-    if (!NavSys) return;
+    UFPSPathBroker* Broker = GetWorld()->GetSubsystem<UFPSPathBroker>();
+    if (!Broker) return;
 
-    CurrentNavPath = NavSys->FindPathToLocationSynchronously(
-        GetWorld(),
-        ControlledCharacter->GetActorLocation(),
-        CurrentTarget
-    );
+    // Asking again for the same target while a request is pending merges into it
+    Broker->RequestPath(ControlledCharacter, CurrentTarget, FOnBrokeredPath::CreateUObject(this, &APlayerAIController::HandlePathReady));
+}
 
-    PathPoints.Empty();
-    if (HasValidPath())
+void APlayerAIController::HandlePathReady(const TArray<FVector>& Points, bool bSuccess)
+{
+    if (!ControlledCharacter || !bHasTarget) return;
+
+    if (bSuccess)
     {
-        PathPoints = CurrentNavPath->PathPoints;
+        PathPoints = Points;
         CurrentPathIndex = 1; // Skip first point (current location)
         //LogState(FString::Printf(TEXT("Path updated: %d points"), PathPoints.Num()), FColor::Blue);
     }
     else
     {
         //LogState(TEXT("No valid path found - starting emergency recovery"), FColor::Red);
+        PathPoints.Empty();
         StartEmergencyRecovery();
     }
 }
@@ -931,7 +939,7 @@ FVector APlayerAIController::GetNextPathPoint() const
 
 bool APlayerAIController::HasValidPath() const
 {
-    return CurrentNavPath && CurrentNavPath->PathPoints.Num() > 1;
+    return PathPoints.Num() > 1;
 }
 
 bool APlayerAIController::IsCloseToTarget(const FVector& Target, float Tolerance) const
@@ -104,7 +104,9 @@ protected:
     virtual void Tick(float DeltaTime) override;
 
     // === CORE NAVIGATION ===
+    // Asks the path broker for a path to CurrentTarget, the current path is followed until it arrives
     void UpdatePath();
+    void HandlePathReady(const TArray<FVector>& Points, bool bSuccess);
     void ProcessNavigation(float DeltaTime);
     bool IsCloseToTarget(const FVector& Target, float Tolerance = 75.f) const;
 
@@ -158,9 +160,6 @@ private:
     AFPSCharacter* ControlledCharacter = nullptr;
 
     // === NAVIGATION STATE ===
-    UPROPERTY()
-    UNavigationPath* CurrentNavPath = nullptr;
-
     UPROPERTY()
     TArray<FVector> PathPoints;
 
@@ -0,0 +1,142 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "FMinimalWorldLatentHelpers.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/App.h"
+#include "HAL/PlatformTime.h"
+#include "Kismet/GameplayStatics.h"
+#include "../FPSWorldReset.h"
+
+// Times an in-place UFPSWorldReset against reopening the same map, which is what death and the finish token used to cost
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldResetBenchmark, "Game.Performance.WorldResetBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace WorldResetBenchmark
+{
+	static const TCHAR* MapPath = TEXT("/Game/Maps/FPSMap");
+	static const FName MapName("FPSMap");
+	static const int32 SoftResets = 10;
+	static const float Timeout = 120.0f;
+
+	struct FTimings {
+		double SoftResetMs = 0.0;
+		double SoftResetMaxMs = 0.0;
+		double OpenLevelMs = 0.0;
+	};
+
+	static UWorld* FindPlayWorld() {
+		for (const FWorldContext& Context : GEngine->GetWorldContexts()) {
+			if (Context.WorldType == EWorldType::PIE && Context.World()) {
+				return Context.World();
+			}
+		}
+		return nullptr;
+	}
+
+	// Playable means begun play with a pawn to control, the point a player could move again
+	static bool IsPlayable(UWorld* World) {
+		return World && World->HasBegunPlay() && UGameplayStatics::GetPlayerPawn(World, 0) != nullptr;
+	}
+}
+
+struct FWaitForPlayableWorldLatent : public IAutomationLatentCommand {
+	FWorldResetBenchmark* Test;
+	float Elapsed = 0.0f;
+	FWaitForPlayableWorldLatent(FWorldResetBenchmark* InTest) : Test(InTest) {}
+
+	virtual bool Update() override {
+		if (WorldResetBenchmark::IsPlayable(WorldResetBenchmark::FindPlayWorld())) return true;
+
+		Elapsed += FApp::GetDeltaTime();
+		if (Elapsed > WorldResetBenchmark::Timeout) {
+			Test->AddError(TEXT("Timed out waiting for the map to become playable"));
+			return true;
+		}
+		return false;
+	}
+};
+
+struct FMeasureSoftResetLatent : public IAutomationLatentCommand {
+	FWorldResetBenchmark* Test;
+	TSharedRef<WorldResetBenchmark::FTimings> Timings;
+	FMeasureSoftResetLatent(FWorldResetBenchmark* InTest, TSharedRef<WorldResetBenchmark::FTimings> InTimings) : Test(InTest), Timings(InTimings) {}
+
+	virtual bool Update() override {
+		UWorld* World = WorldResetBenchmark::FindPlayWorld();
+		UFPSWorldReset* WorldReset = World ? World->GetSubsystem<UFPSWorldReset>() : nullptr;
+		if (!WorldReset) {
+			Test->AddError(TEXT("No UFPSWorldReset in the play world"));
+			return true;
+		}
+
+		double TotalSeconds = 0.0;
+		for (int32 i = 0; i < WorldResetBenchmark::SoftResets; i++) {
+			if (!WorldReset->ResetWorld()) {
+				Test->AddError(TEXT("Soft reset failed"));
+				return true;
+			}
+			TotalSeconds += WorldReset->GetLastResetSeconds();
+			Timings->SoftResetMaxMs = FMath::Max(Timings->SoftResetMaxMs, WorldReset->GetLastResetSeconds() * 1000.0);
+		}
+		Timings->SoftResetMs = TotalSeconds * 1000.0 / WorldResetBenchmark::SoftResets;
+		return true;
+	}
+};
+
+struct FMeasureOpenLevelLatent : public IAutomationLatentCommand {
+	FWorldResetBenchmark* Test;
+	TSharedRef<WorldResetBenchmark::FTimings> Timings;
+	TWeakObjectPtr<UWorld> OldWorld;
+	double StartSeconds = 0.0;
+	FMeasureOpenLevelLatent(FWorldResetBenchmark* InTest, TSharedRef<WorldResetBenchmark::FTimings> InTimings) : Test(InTest), Timings(InTimings) {}
+
+	virtual bool Update() override {
+		UWorld* World = WorldResetBenchmark::FindPlayWorld();
+
+		if (StartSeconds == 0.0) {
+			if (!World) {
+				Test->AddError(TEXT("No play world to reload"));
+				return true;
+			}
+			OldWorld = World;
+			StartSeconds = FPlatformTime::Seconds();
+			UGameplayStatics::OpenLevel(World, WorldResetBenchmark::MapName);
+			return false;
+		}
+
+		// The travel spans several frames, the clock runs until the new world is playable
+		if (World && World != OldWorld.Get() && WorldResetBenchmark::IsPlayable(World)) {
+			Timings->OpenLevelMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+			return true;
+		}
+
+		if (FPlatformTime::Seconds() - StartSeconds > WorldResetBenchmark::Timeout) {
+			Test->AddError(TEXT("Timed out waiting for OpenLevel"));
+			return true;
+		}
+		return false;
+	}
+};
+
+bool FWorldResetBenchmark::RunTest(const FString& Parameters) {
+	TSharedRef<WorldResetBenchmark::FTimings> Timings = MakeShared<WorldResetBenchmark::FTimings>();
+
+	ADD_LATENT_AUTOMATION_COMMAND(FOpenMapLatentCommand(WorldResetBenchmark::MapPath));
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitForPlayableWorldLatent(this));
+	ADD_LATENT_AUTOMATION_COMMAND(FMeasureSoftResetLatent(this, Timings));
+	ADD_LATENT_AUTOMATION_COMMAND(FMeasureOpenLevelLatent(this, Timings));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FDelayedFunctionLatentCommand([this, Timings]() {
+		if (Timings->OpenLevelMs <= 0.0) return;
+
+		const double Speedup = Timings->SoftResetMs > 0.0 ? Timings->OpenLevelMs / Timings->SoftResetMs : 0.0;
+		AddInfo(FString::Printf(TEXT("Soft reset %.2f ms (max %.2f ms), OpenLevel %.2f ms (%.1fx)"), Timings->SoftResetMs, Timings->SoftResetMaxMs, Timings->OpenLevelMs, Speedup));
+		TestTrue(TEXT("Soft reset is faster than reopening the map"), Timings->SoftResetMs < Timings->OpenLevelMs);
+
+		const FString CSV = FString::Printf(TEXT("SoftResetMs,SoftResetMaxMs,OpenLevelMs,Speedup\n%.3f,%.3f,%.3f,%.2f\n"), Timings->SoftResetMs, Timings->SoftResetMaxMs, Timings->OpenLevelMs, Speedup);
+		const FString CSVPath = FPaths::ProjectSavedDir() / TEXT("Automation/Performance/WorldResetBenchmark.csv");
+		FFileHelper::SaveStringToFile(CSV, *CSVPath);
+		}, 0.0f));
+
+	return true;
+}
@@ -18,7 +18,7 @@ void AWeaponPickup::OnCollected(AFPSCharacter* Character) {
 		FActorSpawnParameters SpawnParams;
 		SpawnParams.Owner = Character;
 		SpawnParams.Instigator = Character;
-		AFPSWeaponBase* NewWeapon = GetWorld()->SpawnActor<AFPSWeaponBase>(WeaponClass, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+		AFPSWeaponBase* NewWeapon = Character->GetWorld()->SpawnActor<AFPSWeaponBase>(WeaponClass, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
 
 		if (NewWeapon) {
 			UE_LOG(LogTemp, Warning, TEXT("NEW WEAPON fired for %s"), *GetName());
@@ -33,7 +33,7 @@ void AWeaponPickup::OnCollected(AFPSCharacter* Character) {
 		FActorSpawnParameters SpawnParams;
 		SpawnParams.Owner = Character;
 		SpawnParams.Instigator = Character;
-		AFPSWeaponBase* NewWeapon = GetWorld()->SpawnActor<AFPSWeaponBase>(WeaponClass, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+		AFPSWeaponBase* NewWeapon = Character->GetWorld()->SpawnActor<AFPSWeaponBase>(WeaponClass, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
 
 		if (NewWeapon) {
 			Character->SetSecondaryWeapon(NewWeapon);